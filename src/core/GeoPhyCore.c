@@ -0,0 +1,968 @@
+/*=========================================================
+ * Environnement Canada
+ * Centre Meteorologique Canadien
+ * 2100 Trans-Canadienne
+ * Dorval, Quebec
+ *
+ * Projet       : Lecture et traitements de divers fichiers de donnees
+ * Fichier      : GeoPhyCore.c
+ * Creation     : Octobre 2026 - CMC/CMDS
+ *
+ * Description  : Noyaux de calculs geophysiques independants de Tcl.
+ *
+ * Remarques    :
+ *   - Extraits de GeoPhy.c, qui ne fait plus que convertir les champs et
+ *     les settings Tcl
+ *
+ * License      :
+ *    This library is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation,
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with this library; if not, write to the
+ *    Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ *    Boston, MA 02111-1307, USA.
+ *
+ *=========================================================
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "GeoPhyCore.h"
+
+#ifndef f77name
+#define f77name(x) x##_
+#endif
+
+#define VK       0.4f         // ???
+#define CT       0.5f         // ???
+#define HMIN     2.7182818f   // ???
+
+extern void f77name(smp_digt_flt)();
+extern void f77name(smp_2del_flt)();
+extern void f77name(lpass_filter)(void*,void*,int*,int*,float*,int*,int*,float*,char*);
+
+static const float GeoPhyCore_RugV[SUB_NVEGE]={ 0.001,0.001,0.001,1.5,3.5,1.0,2.0,3.0,0.8,0.05,0.15,0.15,0.02,0.08,0.08,0.08,0.35,0.25,0.1,0.08,1.35,0.01,0.05,0.05,1.5,0.05 };
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhyCore_SetDefault>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Initialiser les settings avec les valeurs par defaut des noyaux
+ *
+ * Parametres :
+ *  <Set>     : Settings a initialiser.
+ *
+ * Retour:
+ *
+ * Remarques :
+ *    - Filters are disabled by default, as when the settings are missing
+ *----------------------------------------------------------------------------
+*/
+void GeoPhyCore_SetDefault(TGeoPhySet *Set) {
+
+   Set->GrdTyp[0]='G';
+   Set->GrdTyp[1]='U';
+   Set->DgfmS=0;
+   Set->DgfmX=0;
+   Set->FilMX=0;
+   Set->ClipOro=0;
+
+   Set->LPassRC=3.0f;
+   Set->LPassP=20;
+   Set->LPassMaskOp=1;
+   Set->LPassMaskThres=0.01f;
+   Set->LPassMinMax=1;
+
+   memcpy(Set->RugV,GeoPhyCore_RugV,SUB_NVEGE*sizeof(float));
+   Set->ZRatioC=0;
+   Set->UseZVG2=0;
+   Set->ZVMin=0.0003f;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhyCore_SubPack>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Store the sub-grid samples in a compact quantized form
+ *
+ * Parametres :
+ *  <Sub>       : Sub-grid samples (NI*NJ*SubSample*SubSample).
+ *  <NI>        : Grid dimension in I.
+ *  <NJ>        : Grid dimension in J.
+ *  <SubSample> : Samples per cell side.
+ *  <NoData>    : Nodata value of the samples.
+ *  <Tolerance> : Maximum quantization error accepted (same unit as samples).
+ *  <Error>     : Maximum quantization error of the compact form.
+ *
+ * Retour:
+ *  <Sub>     : Compact sub-grid samples (NULL if the tolerance can't be met)
+ *
+ * Remarques :
+ *    - Each cell keeps its minimum and a step of (max-min)/SUB_QMAX so the
+ *      decoding error of any sample is at most half a step
+ *----------------------------------------------------------------------------
+*/
+TGeoPhySub* GeoPhyCore_SubPack(float *Sub,int NI,int NJ,int SubSample,double NoData,float Tolerance,float *Error) {
+
+   TGeoPhySub *sub;
+   int         n,nc,s,idx,ind;
+   float       min,max,err,*val;
+
+   *Error=0.0f;
+
+   if (!Sub)
+      return(NULL);
+
+   s=SubSample*SubSample;
+   nc=NI*NJ;
+
+   // Check the quantization error first so we do not allocate for nothing
+   for(idx=0;idx<nc;idx++) {
+      min=1e32;max=-1e32;
+      val=&Sub[idx*s];
+      for(ind=0;ind<s;ind++) {
+         if (val[ind]!=NoData) {
+            min=fminf(min,val[ind]);
+            max=fmaxf(max,val[ind]);
+         }
+      }
+      if (max>min) {
+         err=0.5f*(max-min)/SUB_QMAX;
+         *Error=fmaxf(*Error,err);
+      }
+   }
+
+   if (*Error>Tolerance)
+      return(NULL);
+
+   if (!(sub=(TGeoPhySub*)malloc(sizeof(TGeoPhySub))))
+      return(NULL);
+
+   sub->NI=NI;
+   sub->NJ=NJ;
+   sub->SubSample=SubSample;
+   sub->Error=*Error;
+   sub->Offset=(float*)malloc(nc*sizeof(float));
+   sub->Scale=(float*)malloc(nc*sizeof(float));
+   sub->Value=(unsigned short*)malloc((size_t)nc*s*sizeof(unsigned short));
+   sub->Valid=(unsigned char*)calloc(((size_t)nc*s+7)>>3,sizeof(unsigned char));
+
+   if (!sub->Offset || !sub->Scale || !sub->Value || !sub->Valid) {
+      GeoPhyCore_SubFree(sub);
+      return(NULL);
+   }
+
+   for(idx=0,n=0;idx<nc;idx++) {
+      min=1e32;max=-1e32;
+      val=&Sub[idx*s];
+      for(ind=0;ind<s;ind++) {
+         if (val[ind]!=NoData) {
+            min=fminf(min,val[ind]);
+            max=fmaxf(max,val[ind]);
+         }
+      }
+      if (max<min) {
+         min=max=0.0f;
+      }
+      sub->Offset[idx]=min;
+      sub->Scale[idx]=(max-min)/SUB_QMAX;
+
+      for(ind=0;ind<s;ind++,n++) {
+         if (val[ind]!=NoData) {
+            sub->Valid[n>>3]|=(1<<(n&0x7));
+            sub->Value[n]=sub->Scale[idx]>0.0f?(unsigned short)lrintf((val[ind]-min)/sub->Scale[idx]):0;
+         } else {
+            sub->Value[n]=0;
+         }
+      }
+   }
+
+   return(sub);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhyCore_SubFree>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Free the compact sub-grid samples
+ *
+ * Parametres :
+ *  <Sub>     : Compact sub-grid samples.
+ *
+ * Retour:
+ *
+ * Remarques :
+ *----------------------------------------------------------------------------
+*/
+void GeoPhyCore_SubFree(TGeoPhySub *Sub) {
+
+   if (Sub) {
+      if (Sub->Offset) free(Sub->Offset);
+      if (Sub->Scale)  free(Sub->Scale);
+      if (Sub->Value)  free(Sub->Value);
+      if (Sub->Valid)  free(Sub->Valid);
+      free(Sub);
+   }
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhyCore_SubUnpack>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Decode the sub-grid samples of a cell into a tile
+ *
+ * Parametres :
+ *  <Sub>     : Compact sub-grid samples.
+ *  <Idx>     : Cell index.
+ *  <Tile>    : Subgrid array (SubSample*SubSample).
+ *  <NoData>  : Value to use for invalid samples.
+ *
+ * Retour:
+ *  <...>     : 0:Fail 1:Ok  
+ *
+ * Remarques :
+ *----------------------------------------------------------------------------
+*/
+int GeoPhyCore_SubUnpack(TGeoPhySub *Sub,int Idx,float *Tile,float NoData) {
+
+   int    ind,s,n;
+   float  off,scl;
+
+   s=Sub->SubSample*Sub->SubSample;
+   n=Idx*s;
+   off=Sub->Offset[Idx];
+   scl=Sub->Scale[Idx];
+
+   for(ind=0;ind<s;ind++,n++) {
+      Tile[ind]=GeoPhy_SubIsValid(Sub,n)?off+scl*Sub->Value[n]:NoData;
+   }
+   return(1);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhyCore_SubTranspose>
+ * Creation : Aout 2013 - J.P. Gauthier - CMC/CMOE
+ *
+ * But      : Interpolate the topography into the subgrid tile
+ *
+ * Parametres :
+ *  <Grid>    : Sub-grid fields.
+ *  <NI>      : Grid dimension in I.
+ *  <NJ>      : Grid dimension in J.
+ *  <I>       : Gridpoint i.
+ *  <J>       : Gridpoint j.
+ *  <Sub>     : Subgrid array (SubSample*SubSample).
+ *
+ * Retour:
+ *  <...>     : 0:Fail 1:Ok  
+ *
+ * Remarques :
+ *    - Without an interpolation function, the topography is interpolated
+ *      bilinearly and clamped at the grid borders
+ *----------------------------------------------------------------------------
+*/
+static int GeoPhyCore_SubTranspose(TGeoPhySubGrid *Grid,int NI,int NJ,int I,int J,float *Sub) {
+   
+   int    i,j,idx,i0,j0,i1,j1;
+   double di,dj,d,fi,fj;
+   
+   idx=0;
+   d=1.0/(Grid->SubSample-1);
+
+   for(j=0;j<Grid->SubSample;j++) {
+      dj=(double)J-0.5+d*j;
+      if (dj<=-0.5) dj=-0.499;
+      if (dj>=(double)NJ-0.501) dj=NJ-0.501;
+      
+      for(i=0;i<Grid->SubSample;i++,idx++) {
+         di=(double)I-0.5+d*i;
+         if (di<=-0.5) di=-0.499;
+         if (di>=(double)NI-0.501) di=NI-0.501;
+         
+         if (Grid->Value) {
+            Sub[idx]=Grid->Value(Grid->Data,di,dj);
+         } else {
+            fi=fmax(di,0.0); i0=(int)fi; i1=i0<NI-1?i0+1:i0; fi-=i0;
+            fj=fmax(dj,0.0); j0=(int)fj; j1=j0<NJ-1?j0+1:j0; fj-=j0;
+            Sub[idx]=(1.0-fj)*((1.0-fi)*Grid->Topo[j0*NI+i0]+fi*Grid->Topo[j0*NI+i1])
+                    +fj*((1.0-fi)*Grid->Topo[j1*NI+i0]+fi*Grid->Topo[j1*NI+i1]);
+         }
+     }
+   }
+   
+   return(1);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhyCore_SubFlat>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Verifier si les deviations sous-maille d'un point de grille sont
+ *            toutes nulles
+ *
+ * Parametres :
+ *  <Grid>    : Champs sous-maille.
+ *  <NI>      : Dimension en I de la grille.
+ *  <NJ>      : Dimension en J de la grille.
+ *  <I>       : Gridpoint i.
+ *  <J>       : Gridpoint j.
+ *
+ * Retour:
+ *  <...>     : 0:Actif 1:Plat
+ *
+ * Remarques :
+ *    - Une tuile sans echantillon valide est plate
+ *    - Sinon, tous les echantillons valides doivent egaler la topographie du
+ *      point et de ses 8 voisins dont GeoPhyCore_SubTranspose interpole la tuile
+ *    - Les points de bordure sont toujours actifs a cause du repliement des
+ *      grilles globales
+ *----------------------------------------------------------------------------
+*/
+static int GeoPhyCore_SubFlat(TGeoPhySubGrid *Grid,int NI,int NJ,int I,int J) {
+
+   int   i,j,ind,s,valid=0;
+   float c,*sh;
+   unsigned long idx,n;
+
+   s=Grid->SubSample*Grid->SubSample;
+   idx=(unsigned long)J*NI+I;
+   c=Grid->Topo[idx];
+
+   // Look for a sample that deviates, or at least one valid one
+   if (!Grid->Sub) {
+      for(ind=0,n=idx*s;ind<s;ind++,n++) {
+         if (GeoPhy_SubIsValid(Grid->Packed,n)) {
+            valid=1;
+            break;
+         }
+      }
+      if (valid && (Grid->Packed->Scale[idx]!=0.0f || Grid->Packed->Offset[idx]!=c))
+         return(0);
+   } else {
+      sh=&Grid->Sub[idx*s];
+      for(ind=0;ind<s;ind++) {
+         if (sh[ind]!=Grid->NoData) {
+            if (sh[ind]!=c)
+               return(0);
+            valid=1;
+         }
+      }
+   }
+
+   if (!valid)
+      return(1);
+
+   if (I==0 || J==0 || I==NI-1 || J==NJ-1)
+      return(0);
+
+   // The interpolated topography is constant only if the neighbours are
+   for(j=J-1;j<=J+1;j++) {
+      for(i=I-1;i<=I+1;i++) {
+         if (Grid->Topo[(unsigned long)j*NI+i]!=c)
+            return(0);
+      }
+   }
+   return(1);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhyCore_LegacyAsh>
+ * Creation : Aout 2013 - J.P. Gauthier - CMC/CMOE
+ *
+ * But      : Calcul de la longueur de rugosite et pentes sous-maille.
+ *
+ * Parametres :
+ *  <SubSample>: NOMBRE D'ECHANTILLONS SOUS-MAILLE PAR COTE.
+ *  <H>       : HAUTEUR DES ECHELLES NON RESOLUES.
+ *  <HTOT>    : VALEUR DE H.
+ *  <ASTOT>   : VALEUR DE A/S. 
+ *  <NI>      : NOMBRE DE POINTS EN I DE LA GRILLE CIBLE.
+ *  <NJ>      : NOMBRE DE POINTS EN J DE LA GRILLE CIBLE.
+ *  <DX>      : RESOLUTION EN X DE LA GRILLE CIBLE.
+ *  <DY>      : RESOLUTION EN Y DE LA GRILLE CIBLE.
+ *  <VAR>     : VALEUR DE LA VARIANCE DES ECHELLES NON-RESOLUES.
+ *  <HX2>     : PENTE EN X AU CARRE DES ECHELLES NON-RESOLUES.
+ *  <HY2>     : PENTE EN Y AU CARRE DES ECHELLES NON-RESOLUES.
+ *  <HXY>     : PRODUIT DES PENTES EN X ET EN Y DES ECHELLES  NON-RESOLUES.
+ *
+ * Retour:
+ *  <...> : 
+ *
+ * Remarques :
+ *    - Fonction extraite de genesis et creee par Judy St-James en 1998 
+ *      et revisee en 2001
+ *----------------------------------------------------------------------------
+*/
+static int GeoPhyCore_LegacyAsh(int SubSample,float *H,float DX,float DY,float *HTOT,float *ASTOT,float *VAR,float *HX2,float *HY2, float *HXY) {
+
+   float dhdx,dhdx2,dhdy,dhdy2,dhdxdy,hy,hx,sasx,sasy,avgh,varh,sumh,hh,ll;
+   float sdx,sdy,dx,dy,dm;
+   int   s,i,j,l,tm,icheq,ssquare,ni,idx,idxe;
+   int   tmp[SUB_SIZE],idm[SUB_SIZE];
+   
+   s       = SubSample-1;
+   ssquare = SubSample*SubSample;
+   sdx      = DX/s;
+   sdy      = DY/s;
+
+   varh=avgh=sasx=sasy=hy=hx=dhdx=dhdx2=dhdy=dhdy2=dhdxdy=0.0f;
+
+   // Parcours de la grille fine en x de j=1 a f1
+   idx=0;
+   ni=SubSample;
+   
+   for(j=0;j<SubSample;j++) {
+
+      icheq = 0;
+      tm = 0;
+      idx=j*ni;
+      
+      for(i=0;i<SubSample-1;i++,idx++) {
+
+         // Calcul du terme A/S en direction des x.
+         sasx += fabsf(H[idx+1]-H[idx]);
+
+         // Calcul de la moyenne des echelles non-resolues
+         avgh += H[idx];
+
+         // Calcul des pentes en x et en y des echelles non-resolues.
+         // Methode de differenciation de second ordre (Leapfrog).
+         if (j==0) {
+            dhdy  = (H[idx+ni]-H[idx])/sdy;
+         } else if (j==s) {
+            dhdy = (H[idx]-H[idx-ni])/sdy;
+         } else {
+            dhdy = (H[idx+ni]-H[idx-ni])/(2.0*sdy);
+         }
+
+         if (i==0) {
+            dhdx = (H[idx+1]-H[idx])/sdx;
+         } else {
+            dhdx = (H[idx+1]-H[idx-1])/(2.0*sdx);
+         }
+         
+         dhdy2  += (dhdy*dhdy);
+         dhdx2  += (dhdx*dhdx);
+         dhdxdy += (dhdx*dhdy);               
+
+         // Recherche des MAX et des MIN en direction des x.     
+         if (H[idx+1]==H[idx]) {
+            tmp[i+1] = 3;
+
+            if (icheq==0) {
+               tmp[i] = 3;
+               icheq = 1;
+               continue;
+            }
+
+         } else if (H[idx+1] > H[idx]) {
+            tmp[i+1] = 2;
+
+            if (icheq==0) {
+               idm[++tm] = i;
+               tmp[i] = 1;
+               icheq = 1;
+               continue;
+            }
+
+         } else {
+            tmp[i+1] = 1;
+
+            if (icheq==0) {
+               idm[++tm] = i;
+               tmp[i] = 2;
+               icheq = 1;
+               continue;
+            }
+         }
+
+         if (tmp[i]>2) {
+            if (tmp[i+1]==1) {
+               idm[++tm] = i;
+            } else if (tmp[i+1]==2) {
+               idm[++tm] = i;
+            }
+         } else if (tmp[i+1]>tmp[i]) {        
+            if (tmp[i+1]==3) {
+               idm[++tm] = i;
+            } else {
+               idm[++tm] = i;
+            }
+         } else if (tmp[i+1]<tmp[i]) {
+            idm[++tm] = i;                     
+         }
+      }
+
+      // Calcul des pentes en x et en y des echelles non-resolues a la frontiere i=SubSample-1
+      idxe=j*ni+ni-1;
+      dhdx   = (H[idxe]-H[idxe-1])/sdx;
+
+      if (j==0) {
+         dhdy = (H[idxe+ni]-H[idxe])/sdy;
+      } else if (j==s) {
+         dhdy = (H[idxe]-H[idxe-ni])/sdy;
+      } else {
+         dhdy = (H[idxe+ni]-H[idxe-ni])/(2.0*sdy);
+      }
+
+      dhdy2  += (dhdy*dhdy);
+      dhdx2  += (dhdx*dhdx);
+      dhdxdy += (dhdx*dhdy);
+
+      // Calcul de la moyenne des echelles non-resolues
+      avgh = avgh + H[idxe];
+
+      if (tmp[s]==1) {
+         idm[++tm] = s;
+      } else if (tmp[s]==2) {
+         idm[++tm] = s;
+      }
+
+      // Calcul du term h
+      hh=ll=0.0f;
+
+      if (tm) {
+
+         for (l=1;l<tm;l++) {
+            
+            dx = (float)(idm[l+1] - idm[l]);
+            sumh = fabsf((H[j*ni+idm[l+1]] - H[j*ni+idm[l]])*dx*sdx);
+            hh += sumh;
+            ll += dx;
+         }
+
+         hh /= (ll*sdx);
+         hy += hh;
+
+      } else {
+         hy = 0.0;
+      }
+   }
+
+   // Moyenne des pentes des echelles non-resolues
+   *HX2 = dhdx2/ssquare;
+   *HY2 = dhdy2/ssquare;
+   *HXY = dhdxdy/ssquare;
+   hy  = hy/SubSample;
+
+   sasx = sasx/(DX*SubSample);
+
+   // Calcul de la moyenne des echelles non-resolues
+   avgh = avgh/(ssquare);
+   
+   // Calcul du terme A/S en direction des y
+   for(i=0;i<ni;i++) {
+
+      icheq = 0;
+      tm    = 0;
+
+      for(j=0;j<ni-1;j++) {
+         idx=j*ni+i;
+
+         sasy+=fabsf(H[idx+ni] - H[idx]);
+
+         // Calcul de la variance des echelles non-resolues
+         dm=H[idx]-avgh;
+         varh += (dm*dm)/ssquare;
+         
+         // Recherche des MAX et des MIN en direction des y.
+         if (H[idx+ni] == H[idx]) {
+
+            tmp[j+1] = 3;
+
+            if (icheq==0) {
+               tmp[j] = 3;
+               icheq = 1;
+               continue;
+            }
+
+         } else if (H[idx+ni]>H[idx]) {
+
+            tmp[j+1] = 2;
+
+            if (icheq==0) {
+               idm[++tm]=j;
+               tmp[j]= 1;
+               icheq = 1;
+               continue;
+            }
+         } else {
+
+            tmp[j+1] = 1;
+
+            if (icheq==0) {
+               idm[++tm] = j;
+               tmp[j]= 2;
+               icheq = 1;
+               continue;
+            }
+         }
+
+
+         if (tmp[j]>2) {
+            if (tmp[j+1]==1) {
+               idm[++tm]= j;
+            } else if  (tmp[j+1]==2) {
+               idm[++tm]= j;
+            }
+         } else if (tmp[j+1]>tmp[j]) {           
+            if (tmp[j+1]==3) {
+               idm[++tm]= j;
+            } else {
+               idm[++tm]= j;
+            }
+         } else if (tmp[j+1]<tmp[j]) {
+               idm[++tm]= j;
+         }
+      }
+
+      // Calcul de la variance des echelles non-resolues
+      idxe=(ni-1)*ni+i;
+      dm=H[idxe]-avgh;
+      varh += (dm*dm)/ssquare;
+
+      if (tmp[s]==1) {
+         idm[++tm]= s;
+      } else if (tmp[s]==2) {
+         idm[++tm]= s;
+      }
+
+      // Calcul du term h
+      hh=ll=0.0f;
+
+      if (tm) {
+
+         for (l=1;l<tm;l++) {
+
+            dy = (float)(idm[l+1] - idm[l]);
+            sumh = fabsf(H[idm[l+1]*ni+i] - H[idm[l]*ni+i])*dy*sdy;
+            hh += sumh;
+            ll += dy;
+         }
+
+         hh /= (ll*sdy);
+         hx += hh;
+      } else {
+         hx = 0.0f;
+      }
+   }
+
+   hx    /= SubSample;         
+   sasy  /= (DY*SubSample);
+   *HTOT  = (hx + hy)/2.0f;
+   *ASTOT = (sasx + sasy)/2.0f;
+
+   // Calcul de la variance des echelles non-resolues
+   *VAR = sqrtf(varh); 
+
+   return(1);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhyCore_SubRoughness>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Calcul de la longueur de rugosite d'un point de grille a partir
+ *            des termes sous-maille.
+ *
+ * Parametres :
+ *  <Set>     : Settings (RugV, UseZVG2, ZVMin, ZRatioC).
+ *  <Vege>    : Vegetation cible ou ZVG2 si Set->UseZVG2
+ *  <Idx>     : Index du point de grille.
+ *  <HTOT>    : Valeur de H (modifiee au minimum HMIN).
+ *  <ASTOT>   : Valeur de A/S.
+ *  <ZZ>      : Longueur de rugosite.
+ *
+ * Retour:
+ *
+ * Remarques :
+ *    - Utilise pour les points actifs et plats
+ *----------------------------------------------------------------------------
+*/
+static void GeoPhyCore_SubRoughness(const TGeoPhySet *Set,float *Vege,unsigned long Idx,float *HTOT,float *ASTOT,float *ZZ) {
+
+   float zv,silh,a,b;
+   int   vg;
+
+   if (Set->UseZVG2) {
+      zv = Vege[Idx];
+   } else {
+      vg = Vege[Idx];
+      zv = Set->RugV[vg-1];
+   }
+
+   // avoid problem with htot/(2*zv)
+   zv = (zv > Set->ZVMin) ? zv : Set->ZVMin;
+
+   *HTOT = fmaxf(*HTOT,HMIN);
+   silh =  0.5f*CT*(*ASTOT)/2.0f;
+   if (Set->ZRatioC)
+      b    = logf(1.0 + *HTOT/(2.0f*zv));
+   else
+      b    = logf(*HTOT/(2.0f*zv));
+   b    = (VK*VK)/(b*b);         
+   a    = (VK*VK)/(silh + b);
+   
+   if (Set->ZRatioC)
+      *ZZ = *HTOT/(2.0f*(expf(sqrtf(a))-1.0));
+   else
+      *ZZ = *HTOT/(2.0f*expf(sqrtf(a)));
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhyCore_SubGrid>
+ * Creation : Aout 2013 - J.P. Gauthier - CMC/CMOE
+ *
+ * But      : Calcul de la longueur de rugosite scalaire donnee par Grant et Mason.
+ *
+ * Parametres :
+ *  <Set>     : Settings.
+ *  <Grid>    : Ensembles de champs sous-maille a calculer.
+ *  <NGrid>   : Nombre d'ensembles.
+ *  <NI>      : Dimension en I de la grille.
+ *  <NJ>      : Dimension en J de la grille.
+ *  <DX>      : Resolution en X de chaque point de grille (metres).
+ *  <DY>      : Resolution en Y de chaque point de grille (metres).
+ *
+ * Retour:
+ *  <...>     : 0:Fail 1:Ok  
+ *
+ * Remarques :
+ *    - Fonction extraite de genesis et creee par Judy St-James en 1998 
+ *      et revisee en 2001
+ *    - Tous les ensembles partagent la grille, les buffers de travail sont
+ *      alloues une seule fois
+ *----------------------------------------------------------------------------
+*/
+int GeoPhyCore_SubGrid(const TGeoPhySet *Set,TGeoPhySubGrid *Grid,int NGrid,int NI,int NJ,const float *DX,const float *DY) {
+ 
+   TGeoPhySubGrid *grid;
+   int   g,i,j,ind,s,smax=0;
+   unsigned long idx,n,na,nij,*act;
+   float as,htot,sum;
+   float topo[SUB_SIZE*SUB_SIZE];
+   float *tsub=NULL,*sh;
+
+   for(g=0;g<NGrid;g++) {
+      grid=&Grid[g];
+      if (!grid->Topo || !grid->Vege || !grid->ZZ || !grid->LH || !grid->DH || !grid->HX2 || !grid->HY2 || !grid->HXY || grid->SubSample<2 || grid->SubSample>SUB_SIZE)
+         return(0);
+      if (!grid->Sub && (!grid->Packed || grid->Packed->NI!=NI || grid->Packed->NJ!=NJ || grid->Packed->SubSample!=grid->SubSample))
+         return(0);
+      smax=grid->SubSample>smax?grid->SubSample:smax;
+   }
+
+   nij=(unsigned long)NI*NJ;
+
+   // Scratch tile to decode compact samples into and active cell list, shared by all sets
+   if (!(tsub=(float*)malloc(smax*smax*sizeof(float)))) {
+      return(0);
+   }
+   if (!(act=(unsigned long*)malloc(nij*sizeof(unsigned long)))) {
+      free(tsub);
+      return(0);
+   }
+
+   for(g=0;g<NGrid;g++) {
+      grid=&Grid[g];
+      s=grid->SubSample*grid->SubSample;
+
+      // Build the active cell list, cells without sub-grid deviations (ocean, flat
+      // or without samples) get the analytic values of a null deviation tile
+      for(idx=0,na=0;idx<nij;idx++) {
+         if (GeoPhyCore_SubFlat(grid,NI,NJ,idx%NI,idx/NI)) {
+            grid->DH[idx]=grid->LH[idx]=grid->HX2[idx]=grid->HY2[idx]=grid->HXY[idx]=0.0f;
+            htot=as=0.0f;
+            GeoPhyCore_SubRoughness(Set,grid->Vege,idx,&htot,&as,&grid->ZZ[idx]);
+         } else {
+            act[na++]=idx;
+         }
+      }
+      
+      // Loop on active topo gridpoint
+      for(n=0;n<na;n++) {
+         idx=act[n];
+         i=idx%NI;
+         j=idx/NI;
+
+         // Interpolate topo on subgrid
+         GeoPhyCore_SubTranspose(grid,NI,NJ,i,j,topo);
+         
+         // Get the cell samples, decoding them if compact
+         if (!grid->Sub) {
+            GeoPhyCore_SubUnpack(grid->Packed,idx,tsub,grid->NoData);
+            sh=tsub;
+         } else {
+            sh=&grid->Sub[idx*s];
+         }
+
+         // Calculate height difference 
+         sum = 0.0f;
+         for(ind=0;ind<s;ind++) {
+
+            // If the value is valid
+            if (sh[ind]!=grid->NoData) {
+               sum += topo[ind] = sh[ind]-topo[ind];
+            } else {
+               topo[ind] = 0.0;
+            }
+         }
+         grid->DH[idx] = sum/s;
+
+         GeoPhyCore_LegacyAsh(grid->SubSample,topo,DX[idx],DY[idx],&htot,&as,&grid->LH[idx],&grid->HX2[idx],&grid->HY2[idx],&grid->HXY[idx]);
+         grid->LH[idx] *=2.0f;
+
+         GeoPhyCore_SubRoughness(Set,grid->Vege,idx,&htot,&as,&grid->ZZ[idx]);
+      }
+   }
+
+   free(act);
+   free(tsub);
+   
+   return(1);
+}    
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhyCore_ZFilter>
+ * Creation : Septembre 2007 - J.P. Gauthier - CMC/CMOE
+ *
+ * But      : Appliquer le filtre GEM
+ *
+ * Parametres :
+ *  <Set>     : Settings (GrdTyp, DgfmS, DgfmX, FilMX, ClipOro).
+ *  <Fld>     : Champs a filtrer.
+ *  <NFld>    : Nombre de champs.
+ *  <NI>      : Dimension en I des champs.
+ *  <NJ>      : Dimension en J des champs.
+ *  <AX>      : Axe des X de la grille (NI).
+ *  <AY>      : Axe des Y de la grille (NJ).
+ *
+ * Retour:
+ *  <...>     : 0:Fail 1:Ok  
+ *
+ * Remarques :
+ *   - Extrait du filtre de GEM
+ *   - Sauf pour les grilles LU, la derniere colonne repete la premiere
+ *----------------------------------------------------------------------------
+*/
+int GeoPhyCore_ZFilter(const TGeoPhySet *Set,float **Fld,int NFld,int NI,int NJ,float *AX,float *AY) {
+
+   float *fld,lcfac,mlr,frco;
+   int    f,idx,i,j,nio,njo,dgfm,cliporo,norm;
+   int    digfil,tdxfil,mapfac;
+   char   grtyp[2],lagrd;
+
+   if (!Set->DgfmX && !Set->FilMX) {
+      return(1);
+   }
+
+   dgfm=5;
+   lcfac=2.0;
+   mlr=3.0;
+   norm=1;
+   frco=0.5;
+   mapfac=Set->DgfmS;
+   digfil=Set->DgfmX;
+   tdxfil=Set->FilMX;
+   cliporo=Set->ClipOro;
+
+   lagrd=(Set->GrdTyp[0]=='L' && Set->GrdTyp[1]=='U');
+   grtyp[0]='G';
+   grtyp[1]=Set->GrdTyp[1];
+
+   nio=lagrd?NI:NI-1;
+   njo=NJ;
+
+   if (!(fld=(float*)malloc(nio*njo*sizeof(float)))) {
+      return(0);
+   }
+
+   for(f=0;f<NFld;f++) {
+      for(j=0;j<njo;j++) {
+         for(i=0;i<nio;i++) {
+            fld[j*nio+i]=Fld[f][j*NI+i];
+         }
+      }
+
+      /*Apply digital filter*/
+      if (digfil) {
+         if (cliporo) {
+            for(i=0;i<nio*njo;i++) {
+               if (fld[i]<0.0) fld[i]=0.0;
+            }
+         }
+         f77name(smp_digt_flt)(fld,AX,AY,&nio,&njo,&lagrd,grtyp,&dgfm,&lcfac,&mlr,&mapfac,&norm);
+      }
+
+      /*Apply 2-delta-xy filter*/
+      if (tdxfil) {
+         if (cliporo) {
+            for(i=0;i<nio*njo;i++) {
+               if (fld[i]<0.0) fld[i]=0.0;
+            }
+         }
+         f77name(smp_2del_flt)(fld,AX,AY,&nio,&njo,&lagrd,grtyp,&frco);
+      }
+
+      for(j=0;j<NJ;j++) {
+         for(i=0;i<nio;i++) {
+            Fld[f][j*NI+i]=fld[j*nio+i];
+         }
+         if (!lagrd) {
+            idx=j*nio;
+            Fld[f][j*NI+NI-1]=fld[idx];
+         }
+      }
+   }
+
+   free(fld);
+   return(1);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhyCore_LPassFilter>
+ * Creation : Fevrier 2017 - V. Souvanlasy - CMC/CMDS
+ *
+ * But      : Appliquer le filtre Low Pass
+ *
+ * Parametres :
+ *  <Set>     : Settings (LPass*).
+ *  <Fld>     : Champs a filtrer.
+ *  <NFld>    : Nombre de champs.
+ *  <Mask>    : Champ pour masquer (NULL si aucun).
+ *  <NI>      : Dimension en I des champs.
+ *  <NJ>      : Dimension en J des champs.
+ *
+ * Retour:
+ *  <...>     : 0:Fail 1:Ok  
+ *
+ * Remarques :
+ *   - Le masque est desactive s'il n'est pas fourni
+ *----------------------------------------------------------------------------
+*/
+int GeoPhyCore_LPassFilter(const TGeoPhySet *Set,float **Fld,int NFld,float *Mask,int NI,int NJ) {
+
+   float rc,mask_thres;
+   int   f,p,mask_op;
+   char  apply_minmax;
+
+   rc=Set->LPassRC;
+   p=Set->LPassP;
+   mask_thres=Set->LPassMaskThres;
+   apply_minmax=(char)Set->LPassMinMax;
+   mask_op=Mask?Set->LPassMaskOp:0;
+
+   for(f=0;f<NFld;f++) {
+      f77name(lpass_filter)(Fld[f],Mask,&NI,&NJ,&rc,&p,&mask_op,&mask_thres,&apply_minmax);
+   }
+   return(1);
+}
@@ -0,0 +1,111 @@
+/*=========================================================
+ * Environnement Canada
+ * Centre Meteorologique Canadien
+ * 2100 Trans-Canadienne
+ * Dorval, Quebec
+ *
+ * Projet       : Lecture et traitements de divers fichiers de donnees
+ * Fichier      : GeoPhyCore.h
+ * Creation     : Octobre 2026 - CMC/CMDS
+ *
+ * Description  : Noyaux de calculs geophysiques independants de Tcl.
+ *
+ * Remarques    :
+ *   - Plain float arrays (NI*NJ, i fastest) and a pre-parsed settings
+ *     structure, usable from C or C++ without an interpreter
+ *   - Every kernel takes a list of fields so the setup is done once per call
+ *
+ * License      :
+ *    This library is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation,
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with this library; if not, write to the
+ *    Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ *    Boston, MA 02111-1307, USA.
+ *
+ *=========================================================
+ */
+
+#ifndef _GeoPhyCore_h
+#define _GeoPhyCore_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SUB_SIZE  256         // Sub-grid maximum resolution
+#define SUB_QMAX  65535       // Sub-grid quantized sample maximum value
+#define SUB_NVEGE 26          // Number of vegetation types of the roughness table
+
+// Settings of the kernels (gem_settings.nml names)
+typedef struct TGeoPhySet {
+   char  GrdTyp[2];           // GRD_TYP_S
+   int   DgfmS;               // TOPO_DGFMS_L: Map factor in the digital filter
+   int   DgfmX;               // TOPO_DGFMX_L: Apply the digital filter
+   int   FilMX;               // TOPO_FILMX_L: Apply the 2-delta-xy filter
+   int   ClipOro;             // TOPO_CLIP_ORO_L: Clip negative topography before filtering
+
+   float LPassRC;             // LPASSFLT_RC_DELTAX
+   int   LPassP;              // LPASSFLT_P
+   int   LPassMaskOp;         // LPASSFLT_MASK_OPERATOR
+   float LPassMaskThres;      // LPASSFLT_MASK_THRESHOLD
+   int   LPassMinMax;         // LPASSFLT_APPLY_MINMAX
+
+   float RugV[SUB_NVEGE];     // TOPO_VEGE_RUGV: Roughness per vegetation type
+   int   ZRatioC;             // TOPO_ZREF_ZV_RATIO_C
+   int   UseZVG2;             // TOPO_RUGV_ZVG2: Vegetation fields hold the ZVG2 roughness
+   float ZVMin;               // TOPO_ZV_MIN_THRESHOLD
+} TGeoPhySet;
+
+// Compact sub-grid samples (per cell offset and scale with 16 bit samples)
+typedef struct TGeoPhySub {
+   int             NI,NJ,SubSample;  // Grid dimensions and sub-sampling
+   float           Error;            // Maximum quantization error
+   float          *Offset;           // Per cell minimum value
+   float          *Scale;            // Per cell quantization step
+   unsigned short *Value;            // Quantized samples
+   unsigned char  *Valid;            // Sample validity bitmap
+} TGeoPhySub;
+
+#define GeoPhy_SubIsValid(S,N)  ((S)->Valid[(N)>>3]&(1<<((N)&0x7)))
+
+// Topography value at fractional grid coordinates (0 based)
+typedef double (TGeoPhyValue)(void *Data,double I,double J);
+
+// One set of fields of the legacy sub-grid computation
+typedef struct TGeoPhySubGrid {
+   float        *Topo;              // Target topography
+   float        *Sub;               // Sub-grid samples (NI*NJ*SubSample*SubSample) or NULL to use Packed
+   TGeoPhySub   *Packed;            // Compact sub-grid samples
+   int           SubSample;         // Sub-grid samples per cell side
+   double        NoData;            // Nodata value of the sub-grid samples
+   float        *Vege;              // Vegetation type or ZVG2 roughness (UseZVG2)
+   float        *ZZ,*LH,*DH;        // Roughness length, variance and bias of the unresolved scales
+   float        *HX2,*HY2,*HXY;     // Slopes of the unresolved scales
+   TGeoPhyValue *Value;             // Topography interpolation (NULL for bilinear on Topo)
+   void         *Data;              // Data passed to Value
+} TGeoPhySubGrid;
+
+void        GeoPhyCore_SetDefault(TGeoPhySet *Set);
+
+TGeoPhySub* GeoPhyCore_SubPack(float *Sub,int NI,int NJ,int SubSample,double NoData,float Tolerance,float *Error);
+void        GeoPhyCore_SubFree(TGeoPhySub *Sub);
+int         GeoPhyCore_SubUnpack(TGeoPhySub *Sub,int Idx,float *Tile,float NoData);
+
+int GeoPhyCore_ZFilter(const TGeoPhySet *Set,float **Fld,int NFld,int NI,int NJ,float *AX,float *AY);
+int GeoPhyCore_LPassFilter(const TGeoPhySet *Set,float **Fld,int NFld,float *Mask,int NI,int NJ);
+int GeoPhyCore_SubGrid(const TGeoPhySet *Set,TGeoPhySubGrid *Grid,int NGrid,int NI,int NJ,const float *DX,const float *DY);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -42,12 +42,18 @@
 * maskoper     | operator to use for mask threshold
 *              |    <0 for LT, >0 for GT, ==0 NA (Not Apply)
 *______________|______________________________________________________
+*
+*notes
+*       Only the points kept by the mask operator are filtered, the
+*       x pass is only done on the rows within p-1 points of them.
 *
       INTEGER i,j,k
 *     
-      INTEGER n,im,ip,jm,jp
+      INTEGER n,im,ip,jm,jp,cnt
       REAL    c1,c2,aux,pi
+      REAL    cn(p)
       REAL    h1(ni,nj),h2(ni,nj),lmin(ni,nj),lmax(ni,nj)
+      LOGICAL act(ni,nj),need(ni,nj)
 *
 C     (defaults should be rc = 3, p = 20, threshold = 100.)
 C
@@ -60,8 +66,49 @@ C
       c1 = 2.0/rc
       pi = 3.14159265359
 *
+      do n=1,(p-1)
+        cn(n) = (2./rc)*((sin(2*pi*n/rc))/(2*pi*n/rc))*
+     X               ((sin(2*pi*n/p ))/(2*pi*n/p ))
+      enddo
+*
+C     Points kept by the mask operator
+C
       do j=1,nj
         do i=1,ni
+          if (maskoper .gt. 0) then
+            act(i,j) = mask(i,j) .gt. threshold
+          else if (maskoper .lt. 0) then
+            act(i,j) = mask(i,j) .lt. threshold
+          else
+            act(i,j) = .true.
+          endif
+        enddo
+      enddo
+*
+C     Points needed by the y pass of an active point of the column
+C
+      do i=1,ni
+        cnt = 0
+        do j=1,min(p-1,nj)
+          if (act(i,j)) cnt = cnt+1
+        enddo
+        do j=1,nj
+          jp = j+p-1
+          if (jp.le.nj) then
+            if (act(i,jp)) cnt = cnt+1
+          endif
+          need(i,j) = cnt.gt.0
+          jm = j-p+1
+          if (jm.ge.1) then
+            if (act(i,jm)) cnt = cnt-1
+          endif
+        enddo
+      enddo
+*
+      if (applyminmax) then
+      do j=1,nj
+        do i=1,ni
+          if (.not.act(i,j)) cycle
           im = max(i-1,1)
           ip = min(i+1,ni)
           jm = max(j-1,1)
@@ -76,14 +123,15 @@ C
           lmax(i,j) = max(max(lmax(i,j),me(ip,jm)),me(ip,jp))
         enddo
       enddo
+      endif
 *      
       do j=1,nj
         do i=1,ni
+          if (.not.need(i,j)) cycle
           h1(i,j) = c1*me(i,j)
           aux     = c1
           do n=1,(p-1)
-            c2 = (2./rc)*((sin(2*pi*n/rc))/(2*pi*n/rc))*
-     X                 ((sin(2*pi*n/p ))/(2*pi*n/p ))
+            c2 = cn(n)
             im = i-n
             ip = i+n
             if ( im.ge.1 .and. ip.le.ni  ) then
@@ -97,11 +145,11 @@ C
 *      
       do i=1,ni
         do j=1,nj
+          if (.not.act(i,j)) cycle
           h2(i,j) = c1*h1(i,j)
           aux     = c1
           do n=1,(p-1)
-            c2 = (2./rc)*((sin(2*pi*n/rc))/(2*pi*n/rc))*
-     X                 ((sin(2*pi*n/p ))/(2*pi*n/p ))
+            c2 = cn(n)
             jm = j-n
             jp = j+n
             if ( jm.ge.1 .and. jp.le.nj  ) then
@@ -115,17 +163,7 @@ C
             h2(i,j) = min(max(h2(i,j),lmin(i,j)),lmax(i,j))
           endif
 *
-          if (maskoper .gt. 0) then
-            if ( mask(i,j) .gt. threshold ) then
-              me(i,j) = h2(i,j)
-            endif
-          else if (maskoper .lt. 0) then
-            if ( mask(i,j) .lt. threshold ) then
-              me(i,j) = h2(i,j)
-            endif
-          else
-            me(i,j) = h2(i,j)
-          endif
+          me(i,j) = h2(i,j)
 *
         enddo
       enddo       
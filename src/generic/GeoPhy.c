@@ -31,51 +31,144 @@
  *=========================================================
  */
 #include "GeoPhy.h"
-#include <rmn/rpnmacros.h>
 
 /*----------------------------------------------------------------------------
- * Nom      : <GeoPhy_SubTranspose>
- * Creation : Aout 2013 - J.P. Gauthier - CMC/CMOE
+ * Nom      : <GeoPhy_SettingsGet>
+ * Creation : Octobre 2026 - CMC/CMDS
  *
- * But      : Interpolate Def data into the subgrid tile
+ * But      : Decoder les settings Tcl des noyaux une seule fois par commande
  *
  * Parametres :
- *  <Def>     : Field data definition.
- *  <I>       : Gridpoint i.
- *  <J>       : Gridpoint j.
- *  <Sub>     : Subgrid array (SubSample*SubSample).
+ *  <Interp>   : Interpreteur TCL.
+ *  <Set>      : Array Tcl du contenue de namelist (gem_settings.nml) (NULL pour les defauts)
+ *  <Settings> : Settings decodes.
  *
  * Retour:
- *  <...>     : 0:Fail 1:Ok  
+ *  <TCL_...> : Code d'erreur de TCL.
  *
  * Remarques :
- *    - Uses TclGeoEER TDef structure
+ *   - Les entrees absentes gardent les valeurs de GeoPhyCore_SetDefault
+ *   - Une valeur invalide (type ou nombre de valeurs de TOPO_VEGE_RUGV) est une erreur,
+ *     elle etait auparavant ignoree
  *----------------------------------------------------------------------------
 */
-int GeoPhy_SubTranspose(TData *Topo,int I,int J,float *Sub) {
-   
-   int   i,j,idx;
-   double di,dj,d,val,val1;
-   
-   idx=0;
-   d=1.0/(Topo->Def->SubSample-1);
-
-   for(j=0;j<Topo->Def->SubSample;j++) {
-      dj=(double)J-0.5+d*j;
-      if (dj<=-0.5) dj=-0.499;
-      if (dj>=(double)Topo->Def->NJ-0.501) dj=Topo->Def->NJ-0.501;
-      
-      for(i=0;i<Topo->Def->SubSample;i++,idx++) {
-         di=(double)I-0.5+d*i;
-         if (di<=-0.5) di=-0.499;
-         if (di>=(double)Topo->Def->NI-0.501) di=Topo->Def->NI-0.501;
-         
-         Topo->GRef->Value(Topo->GRef,Topo->Def,'L',0,di,dj,0,&val,&val1);
-         Sub[idx] = val;         
-     }
+int GeoPhy_SettingsGet(Tcl_Interp *Interp,Tcl_Obj *Set,TGeoPhySet *Settings) {
+
+   Tcl_Obj *obj,**lobj;
+   char    *set,buf[32];
+   double   dval;
+   int      n,nobj;
+
+   GeoPhyCore_SetDefault(Settings);
+
+   if (!Set)
+      return(TCL_OK);
+
+   set=Tcl_GetString(Set);
+
+   // GEM topography filter
+   if ((obj=Tcl_GetVar2Ex(Interp,set,"GRD_TYP_S",0x0)))       { Settings->GrdTyp[0]=Tcl_GetString(obj)[0];Settings->GrdTyp[1]=Tcl_GetString(obj)[1]; }
+   if ((obj=Tcl_GetVar2Ex(Interp,set,"TOPO_DGFMS_L",0x0))    && Tcl_GetBooleanFromObj(Interp,obj,&Settings->DgfmS)!=TCL_OK)   return(TCL_ERROR);
+   if ((obj=Tcl_GetVar2Ex(Interp,set,"TOPO_DGFMX_L",0x0))    && Tcl_GetBooleanFromObj(Interp,obj,&Settings->DgfmX)!=TCL_OK)   return(TCL_ERROR);
+   if ((obj=Tcl_GetVar2Ex(Interp,set,"TOPO_FILMX_L",0x0))    && Tcl_GetBooleanFromObj(Interp,obj,&Settings->FilMX)!=TCL_OK)   return(TCL_ERROR);
+   if ((obj=Tcl_GetVar2Ex(Interp,set,"TOPO_CLIP_ORO_L",0x0)) && Tcl_GetBooleanFromObj(Interp,obj,&Settings->ClipOro)!=TCL_OK) return(TCL_ERROR);
+
+   // Low pass filter
+   if ((obj=Tcl_GetVar2Ex(Interp,set,"LPASSFLT_RC_DELTAX",0x0))) {
+      if (Tcl_GetDoubleFromObj(Interp,obj,&dval)!=TCL_OK) return(TCL_ERROR);
+      Settings->LPassRC=dval;
    }
-   
-   return(1);
+   if ((obj=Tcl_GetVar2Ex(Interp,set,"LPASSFLT_P",0x0))             && Tcl_GetIntFromObj(Interp,obj,&Settings->LPassP)!=TCL_OK)          return(TCL_ERROR);
+   if ((obj=Tcl_GetVar2Ex(Interp,set,"LPASSFLT_MASK_OPERATOR",0x0)) && Tcl_GetIntFromObj(Interp,obj,&Settings->LPassMaskOp)!=TCL_OK)     return(TCL_ERROR);
+   if ((obj=Tcl_GetVar2Ex(Interp,set,"LPASSFLT_MASK_THRESHOLD",0x0))) {
+      if (Tcl_GetDoubleFromObj(Interp,obj,&dval)!=TCL_OK) return(TCL_ERROR);
+      Settings->LPassMaskThres=dval;
+   }
+   if ((obj=Tcl_GetVar2Ex(Interp,set,"LPASSFLT_APPLY_MINMAX",0x0))  && Tcl_GetBooleanFromObj(Interp,obj,&Settings->LPassMinMax)!=TCL_OK) return(TCL_ERROR);
+
+   // Option to override default Roughness associated with VF class
+   if ((obj=Tcl_GetVar2Ex(Interp,set,"TOPO_VEGE_RUGV",0x0))) {
+      if (Tcl_ListObjGetElements(Interp,obj,&nobj,&lobj)!=TCL_OK)
+         return(TCL_ERROR);
+      if (nobj>0) {
+         if (nobj!=SUB_NVEGE) {
+            sprintf(buf,"%d",nobj);
+            Tcl_AppendResult(Interp,"TOPO_VEGE_RUGV need 26 values but contains:",buf,(char*)NULL);
+            return(TCL_ERROR);
+         }
+         for(n=0;n<SUB_NVEGE;n++) {
+            if (Tcl_GetDoubleFromObj(Interp,lobj[n],&dval)!=TCL_OK) return(TCL_ERROR);
+            Settings->RugV[n]=dval;
+         }
+      }
+   }
+
+   // Options to alter computations and parameters 
+   if ((obj=Tcl_GetVar2Ex(Interp,set,"TOPO_ZREF_ZV_RATIO_C",0x0)) && Tcl_GetBooleanFromObj(Interp,obj,&Settings->ZRatioC)!=TCL_OK) return(TCL_ERROR);
+   if ((obj=Tcl_GetVar2Ex(Interp,set,"TOPO_RUGV_ZVG2",0x0))       && Tcl_GetBooleanFromObj(Interp,obj,&Settings->UseZVG2)!=TCL_OK) return(TCL_ERROR);
+   if ((obj=Tcl_GetVar2Ex(Interp,set,"TOPO_ZV_MIN_THRESHOLD",0x0))) {
+      if (Tcl_GetDoubleFromObj(Interp,obj,&dval)!=TCL_OK) return(TCL_ERROR);
+      if (dval>0.0) Settings->ZVMin=dval;
+   }
+
+   return(TCL_OK);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_DefCopy>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Copier les valeurs d'un champ dans un tableau float
+ *
+ * Parametres :
+ *  <Def>     : Definition des donnees du champ.
+ *
+ * Retour:
+ *  <Fld>     : Tableau NI*NJ a liberer (NULL si erreur d'allocation)
+ *
+ * Remarques :
+ *   - Les noyaux travaillent en float quel que soit le type du champ
+ *----------------------------------------------------------------------------
+*/
+static float* GeoPhy_DefCopy(TDef *Def) {
+
+   float        *fld;
+   unsigned long n,nij;
+
+   nij=(unsigned long)Def->NI*Def->NJ;
+   if ((fld=(float*)malloc(nij*sizeof(float)))) {
+      for(n=0;n<nij;n++) {
+         Def_Get(Def,0,n,fld[n]);
+      }
+   }
+   return(fld);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_TopoValue>
+ * Creation : Aout 2013 - J.P. Gauthier - CMC/CMOE
+ *
+ * But      : Interpoler lineairement la topographie a une position de grille
+ *
+ * Parametres :
+ *  <Data>    : Champ de topographie (TData).
+ *  <I>       : Position en I (0 based).
+ *  <J>       : Position en J (0 based).
+ *
+ * Retour:
+ *  <Val>     : Valeur interpolee
+ *
+ * Remarques :
+ *   - Garde l'interpolation de la georeference pour GeoPhyCore_SubGrid
+ *----------------------------------------------------------------------------
+*/
+static double GeoPhy_TopoValue(void *Data,double I,double J) {
+
+   TData  *topo=(TData*)Data;
+   double  val,val1;
+
+   topo->GRef->Value(topo->GRef,topo->Def,'L',0,I,J,0,&val,&val1);
+   return(val);
 }
 
 /*----------------------------------------------------------------------------
@@ -131,447 +224,210 @@ int GeoPhy_GridPointResolution(TGeoRef *Ref,TDef *Def,int I,int J,double *DX,dou
 }
 
 /*----------------------------------------------------------------------------
- * Nom      : <GeoPhy_LegacyAsh>
+ * Nom      : <GeoPhy_GridResolution>
  * Creation : Aout 2013 - J.P. Gauthier - CMC/CMOE
  *
- * But      : Calcul de la longueur de rugosite et pentes sous-maille.
+ * But      : Get the grid resolution in X and Y in meters of every gridpoint
  *
  * Parametres :
- *  <H>       : HAUTEUR DES ECHELLES NON RESOLUES.
- *  <HTOT>    : VALEUR DE H.
- *  <ASTOT>   : VALEUR DE A/S. 
- *  <NI>      : NOMBRE DE POINTS EN I DE LA GRILLE CIBLE.
- *  <NJ>      : NOMBRE DE POINTS EN J DE LA GRILLE CIBLE.
- *  <DX>      : RESOLUTION EN X DE LA GRILLE CIBLE.
- *  <DY>      : RESOLUTION EN Y DE LA GRILLE CIBLE.
- *  <VAR>     : VALEUR DE LA VARIANCE DES ECHELLES NON-RESOLUES.
- *  <HX2>     : PENTE EN X AU CARRE DES ECHELLES NON-RESOLUES.
- *  <HY2>     : PENTE EN Y AU CARRE DES ECHELLES NON-RESOLUES.
- *  <HXY>     : PRODUIT DES PENTES EN X ET EN Y DES ECHELLES  NON-RESOLUES.
+ *  <Ref>     : Georeference definition.
+ *  <Def>     : Field data definition.
+ *  <DX>      : X resolution in meters (NI*NJ).
+ *  <DY>      : Y resolution in meters (NI*NJ).
  *
  * Retour:
- *  <...> : 
+ *  <...>     : 0:Fail 1:Ok  
  *
  * Remarques :
- *    - Fonction extraite de genesis et creee par Judy St-James en 1998 
- *      et revisee en 2001
+ *    - We use the middle of the grid cell as a goo distance approximation
+ *      instead of usgin the average/max of each side
+ *    - The cell segments are reprojected one grid row at a time
  *----------------------------------------------------------------------------
 */
-int GeoPhy_LegacyAsh(TDef *Topo,float *H,float DX,float DY,float *HTOT,float *ASTOT,float *VAR,float *HX2,float *HY2, float *HXY) {
-
-   float dhdx,dhdx2,dhdy,dhdy2,dhdxdy,hy,hx,sasx,sasy,avgh,varh,sumh,hh,ll;
-   float sdx,sdy,dx,dy,dm;
-   int   s,i,j,l,tm,icheq,ssquare,ni,idx,idxe;
-   int   tmp[SUB_SIZE],idm[SUB_SIZE];
+static int GeoPhy_GridResolution(TGeoRef *Ref,TDef *Def,float *DX,float *DY) {
    
-   s       = Topo->SubSample-1;
-   ssquare = Topo->SubSample*Topo->SubSample;
-   sdx      = DX/s;
-   sdy      = DY/s;
-
-   varh=avgh=sasx=sasy=hy=hx=dhdx=dhdx2=dhdy=dhdy2=dhdxdy=0.0f;
-
-   // Parcours de la grille fine en x de j=1 a f1
-   idx=0;
-   ni=Topo->SubSample;
-   
-   for(j=0;j<Topo->SubSample;j++) {
-
-      icheq = 0;
-      tm = 0;
-      idx=j*ni;
-      
-      for(i=0;i<Topo->SubSample-1;i++,idx++) {
-
-         // Calcul du terme A/S en direction des x.
-         sasx += fabsf(H[idx+1]-H[idx]);
-
-         // Calcul de la moyenne des echelles non-resolues
-         avgh += H[idx];
-
-         // Calcul des pentes en x et en y des echelles non-resolues.
-         // Methode de differenciation de second ordre (Leapfrog).
-         if (j==0) {
-            dhdy  = (H[idx+ni]-H[idx])/sdy;
-         } else if (j==s) {
-            dhdy = (H[idx]-H[idx-ni])/sdy;
-         } else {
-            dhdy = (H[idx+ni]-H[idx-ni])/(2.0*sdy);
-         }
-
-         if (i==0) {
-            dhdx = (H[idx+1]-H[idx])/sdx;
-         } else {
-            dhdx = (H[idx+1]-H[idx-1])/(2.0*sdx);
-         }
-         
-         dhdy2  += (dhdy*dhdy);
-         dhdx2  += (dhdx*dhdx);
-         dhdxdy += (dhdx*dhdy);               
-
-         // Recherche des MAX et des MIN en direction des x.     
-         if (H[idx+1]==H[idx]) {
-            tmp[i+1] = 3;
-
-            if (icheq==0) {
-               tmp[i] = 3;
-               icheq = 1;
-               continue;
-            }
-
-         } else if (H[idx+1] > H[idx]) {
-            tmp[i+1] = 2;
-
-            if (icheq==0) {
-               idm[++tm] = i;
-               tmp[i] = 1;
-               icheq = 1;
-               continue;
-            }
-
-         } else {
-            tmp[i+1] = 1;
-
-            if (icheq==0) {
-               idm[++tm] = i;
-               tmp[i] = 2;
-               icheq = 1;
-               continue;
-            }
-         }
-
-         if (tmp[i]>2) {
-            if (tmp[i+1]==1) {
-               idm[++tm] = i;
-            } else if (tmp[i+1]==2) {
-               idm[++tm] = i;
-            }
-         } else if (tmp[i+1]>tmp[i]) {        
-            if (tmp[i+1]==3) {
-               idm[++tm] = i;
-            } else {
-               idm[++tm] = i;
-            }
-         } else if (tmp[i+1]<tmp[i]) {
-            idm[++tm] = i;                     
-         }
+   float  *di,*dj,*dlat,*dlon,fi,fj;
+   double  dx[4],dy[4];
+   int     i,j,k,n;
+   unsigned long idx;
+
+   n=4*Def->NI;
+   di=(float*)malloc(4*n*sizeof(float));
+   if (!di)
+      return(0);
+   dj=di+n;
+   dlat=di+2*n;
+   dlon=di+3*n;
+
+   for(j=0;j<Def->NJ;j++) {
+      for(i=0,k=0;i<Def->NI;i++,k+=4) {
+         fi=i+1.0; fj=j+1.0;
+         di[k]=fi-0.5;   dj[k]=fj;
+         di[k+1]=fi+0.5; dj[k+1]=fj;
+         di[k+2]=fi;     dj[k+2]=fj-0.5;
+         di[k+3]=fi;     dj[k+3]=fj+0.5;
       }
 
-      // Calcul des pentes en x et en y des echelles non-resolues a la frontiere i=Topo->SubSample-1
-      idxe=j*ni+ni-1;
-      dhdx   = (H[idxe]-H[idxe-1])/sdx;
+      // Reproject gridpoint length coordinates as segments crossing center of cell
+      c_gdllfxy(Ref->Ids[0],dlat,dlon,di,dj,n);
 
-      if (j==0) {
-         dhdy = (H[idxe+ni]-H[idxe])/sdy;
-      } else if (j==s) {
-         dhdy = (H[idxe]-H[idxe-ni])/sdy;
-      } else {
-         dhdy = (H[idxe+ni]-H[idxe-ni])/(2.0*sdy);
-      }
-
-      dhdy2  += (dhdy*dhdy);
-      dhdx2  += (dhdx*dhdx);
-      dhdxdy += (dhdx*dhdy);
+      for(i=0,k=0;i<Def->NI;i++,k+=4) {
+         dx[0]=DEG2RAD(dlon[k]);   dy[0]=DEG2RAD(dlat[k]);
+         dx[1]=DEG2RAD(dlon[k+1]); dy[1]=DEG2RAD(dlat[k+1]);
+         dx[2]=DEG2RAD(dlon[k+2]); dy[2]=DEG2RAD(dlat[k+2]);
+         dx[3]=DEG2RAD(dlon[k+3]); dy[3]=DEG2RAD(dlat[k+3]);
 
-      // Calcul de la moyenne des echelles non-resolues
-      avgh = avgh + H[idxe];
+         // Get distance in meters
+         idx=(unsigned long)j*Def->NI+i;
+         DX[idx]=DIST(0.0,dy[0],dx[0],dy[1],dx[1]);
+         DY[idx]=DIST(0.0,dy[2],dx[2],dy[3],dx[3]);
 
-      if (tmp[s]==1) {
-         idm[++tm] = s;
-      } else if (tmp[s]==2) {
-         idm[++tm] = s;
-      }
-
-      // Calcul du term h
-      hh=ll=0.0f;
-
-      if (tm) {
-
-         for (l=1;l<tm;l++) {
-            
-            dx = (float)(idm[l+1] - idm[l]);
-            sumh = fabsf((H[j*ni+idm[l+1]] - H[j*ni+idm[l]])*dx*sdx);
-            hh += sumh;
-            ll += dx;
-         }
-
-         hh /= (ll*sdx);
-         hy += hh;
-
-      } else {
-         hy = 0.0;
+         // If x distance is null, we crossed the pole
+         if (DX[idx]==0.0)
+            DX[idx]=(M_PI*DY[idx])/Def->NI;
       }
    }
-
-   // Moyenne des pentes des echelles non-resolues
-   *HX2 = dhdx2/ssquare;
-   *HY2 = dhdy2/ssquare;
-   *HXY = dhdxdy/ssquare;
-   hy  = hy/Topo->SubSample;
-
-   sasx = sasx/(DX*Topo->SubSample);
-
-   // Calcul de la moyenne des echelles non-resolues
-   avgh = avgh/(ssquare);
+   free(di);
    
-   // Calcul du terme A/S en direction des y
-   for(i=0;i<ni;i++) {
-
-      icheq = 0;
-      tm    = 0;
-
-      for(j=0;j<ni-1;j++) {
-         idx=j*ni+i;
-
-         sasy+=fabsf(H[idx+ni] - H[idx]);
-
-         // Calcul de la variance des echelles non-resolues
-         dm=H[idx]-avgh;
-         varh += (dm*dm)/ssquare;
-         
-         // Recherche des MAX et des MIN en direction des y.
-         if (H[idx+ni] == H[idx]) {
-
-            tmp[j+1] = 3;
-
-            if (icheq==0) {
-               tmp[j] = 3;
-               icheq = 1;
-               continue;
-            }
-
-         } else if (H[idx+ni]>H[idx]) {
-
-            tmp[j+1] = 2;
-
-            if (icheq==0) {
-               idm[++tm]=j;
-               tmp[j]= 1;
-               icheq = 1;
-               continue;
-            }
-         } else {
-
-            tmp[j+1] = 1;
-
-            if (icheq==0) {
-               idm[++tm] = j;
-               tmp[j]= 2;
-               icheq = 1;
-               continue;
-            }
-         }
-
-
-         if (tmp[j]>2) {
-            if (tmp[j+1]==1) {
-               idm[++tm]= j;
-            } else if  (tmp[j+1]==2) {
-               idm[++tm]= j;
-            }
-         } else if (tmp[j+1]>tmp[j]) {           
-            if (tmp[j+1]==3) {
-               idm[++tm]= j;
-            } else {
-               idm[++tm]= j;
-            }
-         } else if (tmp[j+1]<tmp[j]) {
-               idm[++tm]= j;
-         }
-      }
-
-      // Calcul de la variance des echelles non-resolues
-      idxe=(ni-1)*ni+i;
-      dm=H[idxe]-avgh;
-      varh += (dm*dm)/ssquare;
-
-      if (tmp[s]==1) {
-         idm[++tm]= s;
-      } else if (tmp[s]==2) {
-         idm[++tm]= s;
-      }
-
-      // Calcul du term h
-      hh=ll=0.0f;
-
-      if (tm) {
+   return(1);
+}
 
-         for (l=1;l<tm;l++) {
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_SubPack>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Store the sub-grid samples of a field in a compact quantized form
+ *
+ * Parametres :
+ *  <Def>       : Field data definition holding the sub-grid samples.
+ *  <Tolerance> : Maximum quantization error accepted (same unit as samples).
+ *  <Error>     : Maximum quantization error of the compact form.
+ *
+ * Retour:
+ *  <Sub>     : Compact sub-grid samples (NULL if the tolerance can't be met)
+ *
+ * Remarques :
+ *    - On success, the float samples (Def->Sub) are released
+ *----------------------------------------------------------------------------
+*/
+TGeoPhySub* GeoPhy_SubPack(TDef *Def,float Tolerance,float *Error) {
 
-            dy = (float)(idm[l+1] - idm[l]);
-            sumh = fabsf(H[idm[l+1]*ni+i] - H[idm[l]*ni+i])*dy*sdy;
-            hh += sumh;
-            ll += dy;
-         }
+   TGeoPhySub *sub;
 
-         hh /= (ll*sdy);
-         hx += hh;
-      } else {
-         hx = 0.0f;
-      }
+   if ((sub=GeoPhyCore_SubPack(Def->Sub,Def->NI,Def->NJ,Def->SubSample,Def->NoData,Tolerance,Error))) {
+      free(Def->Sub);
+      Def->Sub=NULL;
    }
-
-   hx    /= Topo->SubSample;         
-   sasy  /= (DY*Topo->SubSample);
-   *HTOT  = (hx + hy)/2.0f;
-   *ASTOT = (sasx + sasy)/2.0f;
-
-   // Calcul de la variance des echelles non-resolues
-   *VAR = sqrtf(varh); 
-
-   return(1);
+   return(sub);
 }
 
 /*----------------------------------------------------------------------------
  * Nom      : <GeoPhy_SubGridLegacy>
  * Creation : Aout 2013 - J.P. Gauthier - CMC/CMOE
  *
- * But      : Calcul de la longueur de rugosite scalaire donnée par Grant et Mason.
+ * But      : Calcul de la longueur de rugosite scalaire donnee par Grant et Mason.
  *
  * Parametres :
  *  <Interp>  : Interpreteur TCL.
- *  <Topo>    : Topographie cible.
- *  <Vege>    : Végétation cible ou ZVG2 si Settings(TOPO_RUGV_ZVG2)=True
- *  <ZZ>      : Longueur de rugosité scalaire cible en X seulement. 
- *  <LH>      : Variance des échelles non résolues.
- *  <DH>      : Biais des échelles non résolues.
- *  <HX2>     : Pentes en X au carré des échelles non-résolues.
- *  <HY2>     : Pentes en Y au carré des échelles non-résolues.
- *  <HXY>     : Produits des pentes en X et Y des échelles non-résolues.
+ *  <Fld>     : Ensembles de 8 champs (topo vege zz lh dh hx2 hy2 hxy), N*8
+ *  <Packed>  : Sous-grille compacte de chaque topographie (NULL si Topo->Def->Sub)
+ *  <N>       : Nombre d'ensembles.
+ *  <Set>     : Settings decodes.
  *
  * Retour:
- *  <...> : 
+ *  <TCL_...> : Code d'erreur de TCL.
  *
  * Remarques :
- *    - Fonction extraite de genesis et creee par Judy St-James en 1998 
- *      et revisee en 2001
+ *    - Les ensembles doivent partager la grille de la premiere topographie,
+ *      dont les resolutions ne sont calculees qu'une fois
+ *    - Le calcul est fait par GeoPhyCore_SubGrid
  *----------------------------------------------------------------------------
 */
-int GeoPhy_SubGridLegacy(Tcl_Interp *Interp,TData *Topo,TData *Vege,TData *ZZ,TData *LH,TData *DH,TData *HX2,TData *HY2,TData *HXY, Tcl_Obj *Set) {
+int GeoPhy_SubGridLegacy(Tcl_Interp *Interp,TData **Fld,TGeoPhySub **Packed,int N,TGeoPhySet *Set) {
  
-   int   i,j,idx,ind,s,vg,sub;
-   float as,htot,sum,silh;
-   float a,b;
-   float rugv[]={ 0.001,0.001,0.001,1.5,3.5,1.0,2.0,3.0,0.8,0.05,0.15,0.15,0.02,0.08,0.08,0.08,0.35,0.25,0.1,0.08,1.35,0.01,0.05,0.05,1.5,0.05 };
-   float topo[SUB_SIZE*SUB_SIZE];
-   double dx,dy;
-   float *zz,*lh,*dh,*hx2,*hy2,*hxy;
-   int    zratioc=0;
-   int    use_zvg2=0;
-   float  zv, zvmin=0.0003;
-
-   Tcl_Obj *obj;
-   
-   if (!Topo || !Vege) {
-      Tcl_AppendResult(Interp,"Invalid topographic and/or vegetation field",(char*)NULL);
-      return(TCL_ERROR);   
-   }
-   if (!Topo->Def->Sub) {
-      Tcl_AppendResult(Interp,"Subgrid topography has not been calculated",(char*)NULL);
-      return(TCL_ERROR);   
-   }
-
-   // Option to override default Roughness associated with VF class
-   if ((obj=Tcl_GetVar2Ex(Interp,Tcl_GetString(Set),"TOPO_VEGE_RUGV",0x0))) {
-      double   dval;
-      int   nv;
-      const char **list=NULL;
-      if (Tcl_SplitList(Interp,Tcl_GetString(obj),&nv,&list)==TCL_OK) {
-         if (nv > 0) {
-            if (nv != 26) {
-               char buf[32];
-               sprintf( buf, "%d", nv );
-               Tcl_AppendResult(Interp,"TOPO_VEGE_RUGV need 26 values but contains:", buf, (char*)NULL);
-               Tcl_Free((char*)list);
-               return(TCL_ERROR);
-            }
-            for (i = 0; i < 26 ; i++) {
-               Tcl_GetDouble(Interp,list[i],&dval);
-               rugv[i] = dval;
-            }
+   TGeoPhySubGrid *grid=NULL;
+   TData          *topo,*vege;
+   float          *dx=NULL,*dy=NULL;
+   int             n,f,code=TCL_ERROR;
+   unsigned long   nij;
+
+   for(n=0;n<N;n++) {
+      topo=Fld[n*8];
+      vege=Fld[n*8+1];
+      if (!topo || !vege) {
+         Tcl_AppendResult(Interp,"Invalid topographic and/or vegetation field",(char*)NULL);
+         return(TCL_ERROR);   
+      }
+      for(f=1;f<8;f++) {
+         if (!Fld[n*8+f] || Fld[n*8+f]->Def->NI!=topo->Def->NI || Fld[n*8+f]->Def->NJ!=topo->Def->NJ) {
+            Tcl_AppendResult(Interp,"Invalid or mismatched sub-grid field",(char*)NULL);
+            return(TCL_ERROR);   
          }
-         Tcl_Free((char*)list);
+      }
+      if (topo->GRef!=Fld[0]->GRef) {
+         Tcl_AppendResult(Interp,"All topographic fields must share the same grid",(char*)NULL);
+         return(TCL_ERROR);   
+      }
+      // Use the float samples when available, otherwise the compact ones if they match the grid
+      if (!topo->Def->Sub && (!Packed[n] || Packed[n]->NI!=topo->Def->NI || Packed[n]->NJ!=topo->Def->NJ || Packed[n]->SubSample!=topo->Def->SubSample)) {
+         Tcl_AppendResult(Interp,"Subgrid topography has not been calculated",(char*)NULL);
+         return(TCL_ERROR);   
       }
    }
+   if (!N)
+      return(TCL_OK);
 
-   // Options to alter computations and parameters 
-   if (Set) {
-      double dval;
-      if ((obj=Tcl_GetVar2Ex(Interp,Tcl_GetString(Set),"TOPO_ZREF_ZV_RATIO_C",0x0))) { Tcl_GetBooleanFromObj(Interp,obj,&zratioc); }
-      if ((obj=Tcl_GetVar2Ex(Interp,Tcl_GetString(Set),"TOPO_RUGV_ZVG2",0x0))) { Tcl_GetBooleanFromObj(Interp,obj,&use_zvg2); }
-      if ((obj=Tcl_GetVar2Ex(Interp,Tcl_GetString(Set),"TOPO_ZV_MIN_THRESHOLD",0x0))) {
-         Tcl_GetDoubleFromObj(Interp,obj,&dval);
-         if (dval > 0.0) zvmin = dval;
-      }
+   topo=Fld[0];
+   nij=(unsigned long)topo->Def->NI*topo->Def->NJ;
+
+   grid=(TGeoPhySubGrid*)calloc(N,sizeof(TGeoPhySubGrid));
+   dx=(float*)malloc(nij*sizeof(float));
+   dy=(float*)malloc(nij*sizeof(float));
+   if (!grid || !dx || !dy || !GeoPhy_GridResolution(topo->GRef,topo->Def,dx,dy)) {
+      Tcl_AppendResult(Interp,"Unable to allocate sub-grid buffers",(char*)NULL);
+      goto end;
    }
-  
-   // Get array pointers
-   Def_Pointer(ZZ->Def,0,0,zz);
-   Def_Pointer(LH->Def,0,0,lh);
-   Def_Pointer(DH->Def,0,0,dh);
-   Def_Pointer(HX2->Def,0,0,hx2);
-   Def_Pointer(HY2->Def,0,0,hy2);
-   Def_Pointer(HXY->Def,0,0,hxy);
-   
-   idx=0;
-   s=Topo->Def->SubSample*Topo->Def->SubSample;
-   
-   // Loop on topo gridpoint
-   for(j=0;j<Topo->Def->NJ;j++) {
-      for(i=0;i<Topo->Def->NI;i++,idx++) {
-
-         // Interpolate topo on subgrid
-         GeoPhy_SubTranspose(Topo,i,j,topo);
-         
-         // Get gridpoint resolution (meters)
-         GeoPhy_GridPointResolution(Topo->GRef,Topo->Def,i,j,&dx,&dy);
-         
-         // Calculate height difference 
-         sum = 0.0f;
-         sub=idx*s;
-         for(ind=0;ind<s;ind++,sub++) {
-
-            // If the value is valid
-            if (Topo->Def->Sub[sub]!=Topo->Def->NoData) {
-               sum += topo[ind] = Topo->Def->Sub[sub]-topo[ind];
-            } else {
-               topo[ind] = 0.0;
-            }
-         }
-         dh[idx] = sum/s;
 
-         GeoPhy_LegacyAsh(Topo->Def,topo,dx,dy,&htot,&as,&lh[idx],&hx2[idx],&hy2[idx],&hxy[idx]);
+   for(n=0;n<N;n++) {
+      topo=Fld[n*8];
+      grid[n].Topo=GeoPhy_DefCopy(topo->Def);
+      grid[n].Vege=GeoPhy_DefCopy(Fld[n*8+1]->Def);
+      if (!grid[n].Topo || !grid[n].Vege) {
+         Tcl_AppendResult(Interp,"Unable to allocate sub-grid buffers",(char*)NULL);
+         goto end;
+      }
+      grid[n].Sub=topo->Def->Sub;
+      grid[n].Packed=topo->Def->Sub?NULL:Packed[n];
+      grid[n].SubSample=topo->Def->SubSample;
+      grid[n].NoData=topo->Def->NoData;
+      grid[n].Value=GeoPhy_TopoValue;
+      grid[n].Data=topo;
+      Def_Pointer(Fld[n*8+2]->Def,0,0,grid[n].ZZ);
+      Def_Pointer(Fld[n*8+3]->Def,0,0,grid[n].LH);
+      Def_Pointer(Fld[n*8+4]->Def,0,0,grid[n].DH);
+      Def_Pointer(Fld[n*8+5]->Def,0,0,grid[n].HX2);
+      Def_Pointer(Fld[n*8+6]->Def,0,0,grid[n].HY2);
+      Def_Pointer(Fld[n*8+7]->Def,0,0,grid[n].HXY);
+   }
 
-         if (use_zvg2) {
-            Def_Get(Vege->Def,0,idx,zv);
-         } else {
-            Def_Get(Vege->Def,0,idx,vg);
-            zv = rugv[vg-1];
-         }
+   if (!GeoPhyCore_SubGrid(Set,grid,N,Fld[0]->Def->NI,Fld[0]->Def->NJ,dx,dy)) {
+      Tcl_AppendResult(Interp,"Unable to compute sub-grid fields",(char*)NULL);
+      goto end;
+   }
+   code=TCL_OK;
 
-         // avoid problem with htot/(2*zv)
-         zv = (zv > zvmin) ? zv : zvmin;
-
-         Def_Get(Vege->Def,0,idx,vg);
-
-         htot = FMAX(htot,HMIN);
-         silh =  0.5f*CT*as/2.0f;
-         if (zratioc)
-            b    = logf(1.0 + htot/(2.0f*zv));
-         else
-            b    = logf(htot/(2.0f*zv));
-         b    = (VK*VK)/(b*b);         
-         a    = (VK*VK)/(silh + b);
-         
-         lh[idx] *=2.0f;
-         if (zratioc)
-            zz[idx] = htot/(2.0f*(expf(sqrtf(a))-1.0));
-         else
-            zz[idx] = htot/(2.0f*expf(sqrtf(a)));
+end:
+   if (grid) {
+      for(n=0;n<N;n++) {
+         if (grid[n].Topo) free(grid[n].Topo);
+         if (grid[n].Vege) free(grid[n].Vege);
       }
+      free(grid);
    }
+   if (dx) free(dx);
+   if (dy) free(dy);
    
-   return(TCL_OK);
+   return(code);
 }    
 
 /*----------------------------------------------------------------------------
@@ -582,106 +438,68 @@ int GeoPhy_SubGridLegacy(Tcl_Interp *Interp,TData *Topo,TData *Vege,TData *ZZ,TD
  *
  * Parametres :
  *  <Interp>  : Interpreteur TCL.
- *  <Field>   : Champ a filtrer
- *  <Set>     : Array Tcl du contenue de namelist (gem_settings.nml)
+ *  <Field>   : Champs a filtrer
+ *  <NField>  : Nombre de champs
+ *  <Set>     : Settings decodes.
  *
  * Retour:
  *  <TCL_...> : Code d'erreur de TCL.
  *
  * Remarques :
- *   - Extrait du filtre de GEM
+ *   - Les champs doivent partager la grille du premier
  *----------------------------------------------------------------------------
 */
-int GeoPhy_ZFilterTopo(Tcl_Interp *Interp,TData *Field,Tcl_Obj *Set) {
-
-   Tcl_Obj *obj;
+int GeoPhy_ZFilterTopo(Tcl_Interp *Interp,TData **Field,int NField,TGeoPhySet *Set) {
 
-   float *fld,lcfac,mlr,frco;
-   int    idx,i,j,nio,njo,dgfm,cliporo,norm;
-   int    digfil=0,tdxfil=0,mapfac=0;
-   char   grtyp[2]="GU",lagrd;
+   float       **fld;
+   int           f,code=TCL_OK;
+   unsigned long n,nij;
 
-   extern void f77name(smp_digt_flt)();
-   extern void f77name(smp_2del_flt)();
-
-   if (!Field) {
-      Tcl_AppendResult(Interp,"GeoPhy_ZFilterTopo: Invalid topography field",(char*)NULL);
-      return(TCL_ERROR);
+   for(f=0;f<NField;f++) {
+      if (!Field[f] || Field[f]->GRef!=Field[0]->GRef || Field[f]->Def->NI!=Field[0]->Def->NI || Field[f]->Def->NJ!=Field[0]->Def->NJ) {
+         Tcl_AppendResult(Interp,"GeoPhy_ZFilterTopo: Invalid topography field or not on the same grid",(char*)NULL);
+         return(TCL_ERROR);
+      }
    }
-   GeoRef_Expand(Field->GRef);
-
-   dgfm=5;
-   lcfac=2.0;
-   mlr=3.0;
-   norm=TRUE;
-   frco=0.5;
-   lagrd=FALSE;
-   cliporo=FALSE;
-
-   if ((obj=Tcl_GetVar2Ex(Interp,Tcl_GetString(Set),"GRD_TYP_S",0x0)))       { grtyp[0]=Tcl_GetString(obj)[0];grtyp[1]=Tcl_GetString(obj)[1]; }
-   if ((obj=Tcl_GetVar2Ex(Interp,Tcl_GetString(Set),"TOPO_DGFMS_L",0x0)))    { Tcl_GetBooleanFromObj(Interp,obj,&mapfac); }
-   if ((obj=Tcl_GetVar2Ex(Interp,Tcl_GetString(Set),"TOPO_DGFMX_L",0x0)))    { Tcl_GetBooleanFromObj(Interp,obj,&digfil); }
-   if ((obj=Tcl_GetVar2Ex(Interp,Tcl_GetString(Set),"TOPO_FILMX_L",0x0)))    { Tcl_GetBooleanFromObj(Interp,obj,&tdxfil); }
-   if ((obj=Tcl_GetVar2Ex(Interp,Tcl_GetString(Set),"TOPO_CLIP_ORO_L",0x0))) { Tcl_GetBooleanFromObj(Interp,obj,&cliporo); }
-
-   if (!digfil && !tdxfil) {
+   if (!NField || (!Set->DgfmX && !Set->FilMX)) {
       return(TCL_OK);
    }
+   GeoRef_Expand(Field[0]->GRef);
 
-   if ( grtyp[0]=='L' && grtyp[1]=='U' ) {
-     lagrd=TRUE;
+   if (!(fld=(float**)calloc(NField,sizeof(float*)))) {
+      Tcl_AppendResult(Interp,"GeoPhy_ZFilterTopo: Unable to allocate field table",(char*)NULL);
+      return(TCL_ERROR);
    }
-   grtyp[0]='G';
+   nij=(unsigned long)Field[0]->Def->NI*Field[0]->Def->NJ;
 
-   nio=lagrd?Field->Def->NI:Field->Def->NI-1;
-   njo=Field->Def->NJ;
-
-   fld=(float*)malloc(nio*njo*sizeof(float));
-      for(i=0;i<nio;i++) {
-         for(j=0;j<njo;j++) {
-            idx=j*nio+i;
-            Def_Get(Field->Def,0,FIDX2D(Field->Def,i,j),fld[idx]);
-         }
+   for(f=0;f<NField;f++) {
+      if (!(fld[f]=GeoPhy_DefCopy(Field[f]->Def))) {
+         Tcl_AppendResult(Interp,"GeoPhy_ZFilterTopo: Unable to allocate field copy",(char*)NULL);
+         code=TCL_ERROR;
+         goto end;
       }
-
-
-   /*Apply digital filter*/
-   if (digfil) {
-      if (cliporo) {
-         for(i=0;i<nio*njo;i++) {
-            if (fld[i]<0.0) fld[i]=0.0;
-         }
-      }
-      f77name(smp_digt_flt)(fld,Field->GRef->AX,Field->GRef->AY,&nio,&njo,&lagrd,grtyp,&dgfm,&lcfac,&mlr,&mapfac,&norm);
    }
 
-   /*Apply 2-delta-xy filter*/
-   if (tdxfil) {
-      if (cliporo) {
-         for(i=0;i<nio*njo;i++) {
-            if (fld[i]<0.0) fld[i]=0.0;
-         }
-      }
-      f77name(smp_2del_flt)(fld,Field->GRef->AX,Field->GRef->AY,&nio,&njo,&lagrd,grtyp,&frco);
+   if (!GeoPhyCore_ZFilter(Set,fld,NField,Field[0]->Def->NI,Field[0]->Def->NJ,Field[0]->GRef->AX,Field[0]->GRef->AY)) {
+      Tcl_AppendResult(Interp,"GeoPhy_ZFilterTopo: Unable to filter fields",(char*)NULL);
+      code=TCL_ERROR;
+      goto end;
    }
 
-   for(j=0;j<Field->Def->NJ;j++) {
-      for(i=0;i<nio;i++) {
-         idx=j*nio+i;
-         Def_Set(Field->Def,0,FIDX2D(Field->Def,i,j),fld[idx]);
-      }
-   }
-   if (!lagrd) {
-      for(j=0;j<Field->Def->NJ;j++) {
-         idx=j*nio;
-         Def_Set(Field->Def,0,FIDX2D(Field->Def,Field->Def->NI-1,j),fld[idx]);
+   for(f=0;f<NField;f++) {
+      for(n=0;n<nij;n++) {
+         Def_Set(Field[f]->Def,0,n,fld[f][n]);
       }
    }
 
+end:
+   for(f=0;f<NField;f++) {
+      if (fld[f]) free(fld[f]);
+   }
    free(fld);
-   return(TCL_OK);
-}
 
+   return(code);
+}
 
 /*----------------------------------------------------------------------------
  * Nom      : <GeoPhy_LPassFilter>
@@ -691,9 +509,10 @@ int GeoPhy_ZFilterTopo(Tcl_Interp *Interp,TData *Field,Tcl_Obj *Set) {
  *
  * Parametres :
  *  <Interp>  : Interpreteur TCL.
- *  <Field>   : Champ a filtrer
- *  <Mask>    : Champ pour masquer
- *  <Set>     : Array Tcl du contenue de namelist (gem_settings.nml)
+ *  <Field>   : Champs a filtrer
+ *  <NField>  : Nombre de champs
+ *  <Set>     : Settings decodes.
+ *  <Mask>    : Champ pour masquer (NULL si aucun)
  *
  * Retour:
  *  <TCL_...> : Code d'erreur de TCL.
@@ -701,51 +520,135 @@ int GeoPhy_ZFilterTopo(Tcl_Interp *Interp,TData *Field,Tcl_Obj *Set) {
  * Remarques :
  *----------------------------------------------------------------------------
 */
-int GeoPhy_LPassFilter(Tcl_Interp *Interp,TData *Field,Tcl_Obj *Set,TData *Mask) {
+int GeoPhy_LPassFilter(Tcl_Interp *Interp,TData **Field,int NField,TGeoPhySet *Set,TData *Mask) {
 
-   Tcl_Obj *obj;
-   double   rcD;
-   float    rc=3.0;
-   double   mask_thresD;
-   float    mask_thres=0.01;
-   int      mask_op=1;
-   int      p=20;
-   int      apply_minmaxI;
-   char     apply_minmax;
-   int      ni, nj;
-   float    *fld, *mask=NULL;
+   float **fld,*mask=NULL;
+   int     f;
 
-   extern   void f77name(lpass_filter) ( void *, void *, int *, int *, float *, int *, int *, float *, char * );
+   for(f=0;f<NField;f++) {
+      if (!Field[f] || Field[f]->Def->NI!=Field[0]->Def->NI || Field[f]->Def->NJ!=Field[0]->Def->NJ) {
+         Tcl_AppendResult(Interp,"GeoPhy_LPassFilter: Invalid or mismatched field",(char*)NULL);
+         return(TCL_ERROR);
+      }
+   }
+   if (!NField) {
+      return(TCL_OK);
+   }
+   if (Mask && (Mask->Def->NI!=Field[0]->Def->NI || Mask->Def->NJ!=Field[0]->Def->NJ)) {
+      Tcl_AppendResult(Interp,"GeoPhy_LPassFilter: Mask dimensions mismatch",(char*)NULL);
+      return(TCL_ERROR);
+   }
 
-   if ((obj=Tcl_GetVar2Ex(Interp,Tcl_GetString(Set),"LPASSFLT_RC_DELTAX",0x0)))       { Tcl_GetDoubleFromObj(Interp,obj,&rcD); }
-   if ((obj=Tcl_GetVar2Ex(Interp,Tcl_GetString(Set),"LPASSFLT_P",0x0)))               { Tcl_GetIntFromObj(Interp,obj,&p); }
-   if ((obj=Tcl_GetVar2Ex(Interp,Tcl_GetString(Set),"LPASSFLT_MASK_OPERATOR",0x0)))   { Tcl_GetIntFromObj(Interp,obj,&mask_op); }
-   if ((obj=Tcl_GetVar2Ex(Interp,Tcl_GetString(Set),"LPASSFLT_MASK_THRESHOLD",0x0)))  { Tcl_GetDoubleFromObj(Interp,obj,&mask_thresD); }
-   if ((obj=Tcl_GetVar2Ex(Interp,Tcl_GetString(Set),"LPASSFLT_APPLY_MINMAX",0x0)))    { Tcl_GetBooleanFromObj(Interp,obj,&apply_minmaxI); }
+   if (!(fld=(float**)malloc(NField*sizeof(float*)))) {
+      Tcl_AppendResult(Interp,"GeoPhy_LPassFilter: Unable to allocate field table",(char*)NULL);
+      return(TCL_ERROR);
+   }
+   for(f=0;f<NField;f++) {
+      Def_Pointer(Field[f]->Def,0,0,fld[f]);
+   }
+   if (Mask) {
+      Def_Pointer(Mask->Def,0,0,mask);
+   }
 
+   GeoPhyCore_LPassFilter(Set,fld,NField,mask,Field[0]->Def->NI,Field[0]->Def->NJ);
+   free(fld);
 
+   return(TCL_OK);
+}
 
-   ni = Field->Def->NI;
-   nj = Field->Def->NJ;
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_EmissionKernel>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Accumuler les emissions de tous les types de vegetation en une
+ *            seule passe (produit fractions x facteurs d'emission par maille)
+ *
+ * Parametres :
+ *  <Interp>  : Interpreteur TCL.
+ *  <Frac>    : Fractions des types de vegetation (cube, un niveau par type).
+ *  <Mask>    : Masque des mailles a ignorer (==1.0) (NULL si aucun).
+ *  <Area>    : Aire des mailles (NULL si aucune).
+ *  <Out>     : Champs d'emissions a accumuler.
+ *  <NOut>    : Nombre de champs d'emissions.
+ *  <Level>   : Niveau de Frac de chaque type.
+ *  <Factor>  : Facteurs d'emission (NType x NOut).
+ *  <NType>   : Nombre de types.
+ *  <AreaOut> : Multiplier par l'aire pour chaque champ d'emission.
+ *
+ * Retour:
+ *  <TCL_...> : Code d'erreur de TCL.
+ *
+ * Remarques :
+ *    - Out[o]+=sum(Frac[Level[t]]*Factor[t][o])*(AreaOut[o]?Area:1)
+ *    - Sums are kept in double for the cell and written once per output
+ *----------------------------------------------------------------------------
+*/
+int GeoPhy_EmissionKernel(Tcl_Interp *Interp,TData *Frac,TData *Mask,TData *Area,TData **Out,int NOut,int *Level,double *Factor,int NType,int *AreaOut) {
 
+   unsigned long n,nij;
+   int           t,o;
+   double        f,m,a,val,*sum;
 
-   apply_minmax = (char)apply_minmaxI;
-   mask_thres = mask_thresD;
-   rc = rcD;
+   if (!Frac) {
+      Tcl_AppendResult(Interp,"GeoPhy_EmissionKernel: Invalid fraction field",(char*)NULL);
+      return(TCL_ERROR);
+   }
+   nij=Frac->Def->NI*Frac->Def->NJ;
 
-   Def_Pointer(Field->Def,0,0,fld);
-   if (Mask != NULL)
-      {
-      Def_Pointer(Mask->Def,0,0,mask);
+   for(o=0;o<NOut;o++) {
+      if (!Out[o] || Out[o]->Def->NI*Out[o]->Def->NJ!=nij) {
+         Tcl_AppendResult(Interp,"GeoPhy_EmissionKernel: Invalid or mismatched emission field",(char*)NULL);
+         return(TCL_ERROR);
+      }
+   }
+   if ((Mask && Mask->Def->NI*Mask->Def->NJ!=nij) || (Area && Area->Def->NI*Area->Def->NJ!=nij)) {
+      Tcl_AppendResult(Interp,"GeoPhy_EmissionKernel: Mask or area dimensions mismatch",(char*)NULL);
+      return(TCL_ERROR);
+   }
+   for(t=0;t<NType;t++) {
+      if (Level[t]<0 || Level[t]>=Frac->Def->NK) {
+         Tcl_AppendResult(Interp,"GeoPhy_EmissionKernel: Vegetation type level out of fraction cube",(char*)NULL);
+         return(TCL_ERROR);
+      }
+   }
+
+   if (!(sum=(double*)malloc(NOut*sizeof(double)))) {
+      Tcl_AppendResult(Interp,"GeoPhy_EmissionKernel: Unable to allocate temporary buffer",(char*)NULL);
+      return(TCL_ERROR);
+   }
+
+   for(n=0;n<nij;n++) {
+
+      // Masked cells do not get any contribution
+      if (Mask) {
+         Def_Get(Mask->Def,0,n,m);
+         if (m==1.0)
+            continue;
       }
-    
-   /* disable mask operator if mask field not available */ 
-   if (mask == NULL)
-      {
-      mask_op = 0;
+
+      for(o=0;o<NOut;o++) sum[o]=0.0;
+
+      for(t=0;t<NType;t++) {
+         Def_Get(Frac->Def,0,Level[t]*nij+n,f);
+         if (f==0.0)
+            continue;
+         for(o=0;o<NOut;o++) {
+            sum[o]+=f*Factor[t*NOut+o];
+         }
       }
 
-   f77name(lpass_filter) ( fld, mask, &ni, &nj, &rc, &p, &mask_op, &mask_thres, &apply_minmax );
+      a=1.0;
+      if (Area) {
+         Def_Get(Area->Def,0,n,a);
+      }
 
-   return TCL_OK;
+      for(o=0;o<NOut;o++) {
+         Def_Get(Out[o]->Def,0,n,val);
+         val+=AreaOut[o]?sum[o]*a:sum[o];
+         Def_Set(Out[o]->Def,0,n,val);
+      }
    }
+
+   free(sum);
+   return(TCL_OK);
+}
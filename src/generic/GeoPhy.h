@@ -37,14 +37,20 @@
 #include "tcl.h"
 #include "RPN.h"
 #include "tclData.h"
+#include "GeoPhyCore.h"
 
-#define VK       0.4f         // ???
-#define CT       0.5f         // ???
-#define HMIN     2.7182818f   // ???
-#define SUB_SIZE 256          // Sub-grid maximum resolution
+#define GEOPHY_MERGE_ADD 0   // Add accumulations to field values
+#define GEOPHY_MERGE_MAX 1   // Keep maximum of accumulations and field values
 
-int GeoPhy_SubGridLegacy(Tcl_Interp *Interp,TData *Topo,TData *Vege,TData *ZZ,TData *VAR,TData *HMH,TData *HX2,TData *HY2,TData *HXY, Tcl_Obj *Set);
-int GeoPhy_ZFilterTopo(Tcl_Interp *Interp,TData *Field,Tcl_Obj *Set);
-int GeoPhy_LPassFilter(Tcl_Interp *Interp,TData *Field,Tcl_Obj *Set,TData *Mask);
+int         GeoPhy_SettingsGet(Tcl_Interp *Interp,Tcl_Obj *Set,TGeoPhySet *Settings);
+TGeoPhySub* GeoPhy_SubPack(TDef *Def,float Tolerance,float *Error);
+
+int GeoPhy_SubGridLegacy(Tcl_Interp *Interp,TData **Fld,TGeoPhySub **Packed,int N,TGeoPhySet *Set);
+int GeoPhy_ZFilterTopo(Tcl_Interp *Interp,TData **Field,int NField,TGeoPhySet *Set);
+int GeoPhy_LPassFilter(Tcl_Interp *Interp,TData **Field,int NField,TGeoPhySet *Set,TData *Mask);
+int GeoPhy_EmissionKernel(Tcl_Interp *Interp,TData *Frac,TData *Mask,TData *Area,TData **Out,int NOut,int *Level,double *Factor,int NType,int *AreaOut);
+int GeoPhy_DEMOverview(Tcl_Interp *Interp,char *In,char *Out,double *NoData);
+int GeoPhy_RasterAverage(Tcl_Interp *Interp,TData **Out,int NOut,Tcl_Obj *Files,double NoData,int *Limits,int Tile);
+int GeoPhy_DrainDensity(Tcl_Interp *Interp,TData *RSum,TData *LSum,TData *LArea,Tcl_Obj *Rivers,Tcl_Obj *Lakes,double *Limits,int Merge,int NThread);
 
 #endif
@@ -0,0 +1,189 @@
+/*=========================================================
+ * Environnement Canada
+ * Centre Meteorologique Canadien
+ * 2100 Trans-Canadienne
+ * Dorval, Quebec
+ *
+ * Projet       : Lecture et traitements de divers fichiers de donnees
+ * Fichier      : GeoPhyDEM.c
+ * Creation     : Octobre 2026 - CMC/CMDS
+ *
+ * Description  : Fonctions de preparation des bases de donnees de topographie.
+ *
+ * Remarques    :
+ *
+ * License      :
+ *    This library is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation,
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with this library; if not, write to the
+ *    Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ *    Boston, MA 02111-1307, USA.
+ *
+ *=========================================================
+ */
+#include "GeoPhy.h"
+
+#ifdef HAVE_GDAL
+#include "gdal.h"
+#include "cpl_string.h"
+
+#define DEM_NODATA -32768.0   // Valeur nodata par defaut des niveaux d'apercu
+#endif
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_DEMOverview>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Construire le niveau d'apercu suivant d'une tuile de topographie.
+ *
+ * Parametres :
+ *  <Interp>  : Interpreteur TCL.
+ *  <In>      : Tuile source (DEM a 1 bande ou niveau d'apercu precedent).
+ *  <Out>     : Fichier GeoTIFF du niveau a creer.
+ *  <NoData>  : Valeur nodata de la source (NULL pour celle du fichier).
+ *
+ * Retour:
+ *  <TCL_...> : Code d'erreur de TCL.
+ *
+ * Remarques :
+ *   - Chaque pixel du niveau regroupe 2x2 pixels sources et conserve 3 bandes:
+ *     la moyenne, la moyenne des carres et le nombre d'echantillons valides, de
+ *     sorte que les moyennes et RMS de chaque bloc restent exactes une fois
+ *     ponderees par le nombre, les blocs etant toutefois attribues entiers aux
+ *     mailles, le resultat est approximatif aux bords des mailles
+ *   - Un niveau d'apercu en entree (3 bandes) est agrege avec ses nombres, ce
+ *     qui permet de construire la pyramide niveau par niveau
+ *----------------------------------------------------------------------------
+*/
+int GeoPhy_DEMOverview(Tcl_Interp *Interp,char *In,char *Out,double *NoData) {
+
+#ifdef HAVE_GDAL
+   GDALDatasetH    in,out;
+   GDALRasterBandH band[3],oband[3];
+   GDALDriverH     drv;
+   double          tr[6],nodata,*row[3],*acc[3],v,w;
+   char          **opts=NULL;
+   int             b,nb,has,nx,ny,ox,oy,x,y,dy,ok=1;
+
+   GDALAllRegister();
+
+   if (!(in=GDALOpen(In,GA_ReadOnly))) {
+      Tcl_AppendResult(Interp,"GeoPhy_DEMOverview: Unable to open source tile ",In,(char*)NULL);
+      return(TCL_ERROR);
+   }
+
+   nb=GDALGetRasterCount(in)>=3?3:1;
+   for(b=0;b<nb;b++) {
+      band[b]=GDALGetRasterBand(in,b+1);
+   }
+   if (NoData) {
+      nodata=*NoData;
+   } else {
+      nodata=GDALGetRasterNoDataValue(band[0],&has);
+      if (!has) nodata=DEM_NODATA;
+   }
+
+   nx=GDALGetRasterXSize(in);
+   ny=GDALGetRasterYSize(in);
+   ox=(nx+1)/2;
+   oy=(ny+1)/2;
+
+   // Create the overview level with twice the pixel size, in double precision since
+   // the mean-square band of high topography would lose the RMS in Float32 (GTiff bands share one type)
+   drv=GDALGetDriverByName("GTiff");
+   opts=CSLSetNameValue(opts,"TILED","YES");
+   opts=CSLSetNameValue(opts,"COMPRESS","DEFLATE");
+   opts=CSLSetNameValue(opts,"PREDICTOR","3");
+   if (!drv || !(out=GDALCreate(drv,Out,ox,oy,3,GDT_Float64,opts))) {
+      CSLDestroy(opts);
+      GDALClose(in);
+      Tcl_AppendResult(Interp,"GeoPhy_DEMOverview: Unable to create overview ",Out,(char*)NULL);
+      return(TCL_ERROR);
+   }
+   CSLDestroy(opts);
+
+   if (GDALGetGeoTransform(in,tr)==CE_None) {
+      tr[1]*=2.0; tr[2]*=2.0;
+      tr[4]*=2.0; tr[5]*=2.0;
+      GDALSetGeoTransform(out,tr);
+   }
+   GDALSetProjection(out,GDALGetProjectionRef(in));
+
+   for(b=0;b<3;b++) {
+      oband[b]=GDALGetRasterBand(out,b+1);
+      row[b]=(double*)malloc(nx*sizeof(double));
+      acc[b]=(double*)malloc(ox*sizeof(double));
+      if (!row[b] || !acc[b]) ok=0;
+   }
+   GDALSetRasterNoDataValue(oband[0],nodata);
+   GDALSetRasterNoDataValue(oband[1],nodata);
+
+   for(y=0;ok && y<oy;y++) {
+      memset(acc[0],0x0,ox*sizeof(double));
+      memset(acc[1],0x0,ox*sizeof(double));
+      memset(acc[2],0x0,ox*sizeof(double));
+
+      // Accumulate the sums of values, squares and counts of the 2 source rows
+      for(dy=0;dy<2 && (y*2+dy)<ny;dy++) {
+         for(b=0;b<nb;b++) {
+            if (GDALRasterIO(band[b],GF_Read,0,y*2+dy,nx,1,row[b],nx,1,GDT_Float64,0,0)!=CE_None) {
+               ok=0;
+            }
+         }
+         for(x=0;x<nx;x++) {
+            v=row[0][x];
+            if (nb==3) {
+               if ((w=row[2][x])<=0.0) continue;
+               acc[0][x>>1]+=v*w;
+               acc[1][x>>1]+=row[1][x]*w;
+               acc[2][x>>1]+=w;
+            } else {
+               if (v==nodata) continue;
+               acc[0][x>>1]+=v;
+               acc[1][x>>1]+=v*v;
+               acc[2][x>>1]+=1.0;
+            }
+         }
+      }
+
+      for(x=0;x<ox;x++) {
+         if (acc[2][x]>0.0) {
+            acc[0][x]/=acc[2][x];
+            acc[1][x]/=acc[2][x];
+         } else {
+            acc[0][x]=acc[1][x]=nodata;
+         }
+      }
+      for(b=0;b<3;b++) {
+         if (GDALRasterIO(oband[b],GF_Write,0,y,ox,1,acc[b],ox,1,GDT_Float64,0,0)!=CE_None) {
+            ok=0;
+         }
+      }
+   }
+
+   for(b=0;b<3;b++) {
+      if (row[b]) free(row[b]);
+      if (acc[b]) free(acc[b]);
+   }
+   GDALClose(out);
+   GDALClose(in);
+
+   if (!ok) {
+      Tcl_AppendResult(Interp,"GeoPhy_DEMOverview: Unable to build overview ",Out,(char*)NULL);
+      return(TCL_ERROR);
+   }
+   return(TCL_OK);
+#else
+   Tcl_AppendResult(Interp,"GeoPhy_DEMOverview: Library not built with GDAL",(char*)NULL);
+   return(TCL_ERROR);
+#endif
+}
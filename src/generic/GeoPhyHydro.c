@@ -0,0 +1,783 @@
+/*=========================================================
+ * Environnement Canada
+ * Centre Meteorologique Canadien
+ * 2100 Trans-Canadienne
+ * Dorval, Quebec
+ *
+ * Projet       : Lecture et traitements de divers fichiers de donnees
+ * Fichier      : GeoPhyHydro.c
+ * Creation     : Octobre 2026 - CMC/CMDS
+ *
+ * Description  : Fonctions de calculs pour champs hydrologiques.
+ *
+ * Remarques    :
+ *
+ * License      :
+ *    This library is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation,
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with this library; if not, write to the
+ *    Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ *    Boston, MA 02111-1307, USA.
+ *
+ *=========================================================
+ */
+#include "GeoPhy.h"
+#include <pthread.h>
+#include <unistd.h>
+
+#ifdef HAVE_GDAL
+#include "gdal.h"
+#include "ogr_api.h"
+#include "ogr_srs_api.h"
+
+#define DRAIN_LINE  0x0       // Line part (length only)
+#define DRAIN_RING  0x1       // Polygon outer ring (perimeter and area)
+#define DRAIN_HOLE  0x2       // Polygon inner ring (perimeter and area removed)
+#define DRAIN_CHUNK 64        // Number of parts fetched at once by a thread
+#define DRAIN_MEMORY 1024     // Memory budget of the per thread partial sums (Mb)
+
+// Feature part projected in grid space
+typedef struct TDrainPart {
+   int     N;                 // Number of vertices
+   int     Type;              // DRAIN_LINE, DRAIN_RING or DRAIN_HOLE
+   int     I0,J0,I1,J1;       // Cell bounds
+   float  *X,*Y;              // Grid coordinates (0 based)
+   double *Lat,*Lon;          // Geographic coordinates (radians)
+} TDrainPart;
+
+// Accumulation context shared by threads
+typedef struct TDrainCtx {
+   int             NI,NJ;     // Grid dimensions
+   int             NPart;     // Number of parts
+   int             Next;      // Next part to process
+   int             Target;    // Target of lengths (0:river 1:lake)
+   TDrainPart     *Parts;     // Parts to accumulate
+   double         *CellArea;  // Cell area in meters (NULL if no area needed)
+   pthread_mutex_t Lock;      // Lock on Next
+} TDrainCtx;
+
+// Per thread partial sums
+typedef struct TDrainThread {
+   TDrainCtx *Ctx;            // Shared context
+   double    *Sum[3];         // Partial sums (river length, lake perimeter, lake area)
+   double    *Buf[4];         // Clipping buffers
+   int        Size[4];        // Clipping buffers size (in vertices)
+   int        NSeam;          // Number of segments skipped across a grid seam
+} TDrainThread;
+
+int GeoPhy_GridPointResolution(TGeoRef *Ref,TDef *Def,int I,int J,double *DX,double *DY);
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_DrainLine>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Distribute the length of a line over the cells it crosses
+ *
+ * Parametres :
+ *  <Ctx>     : Accumulation context.
+ *  <Part>    : Line or ring to distribute.
+ *  <Sum>     : Partial sums to accumulate into.
+ *
+ * Retour:
+ *  <NSeam>   : Number of segments skipped across a grid seam
+ *
+ * Remarques :
+ *    - Each segment is walked cell by cell (grid traversal), its geodesic
+ *      length being split proportionally to the grid space length in each cell
+ *----------------------------------------------------------------------------
+*/
+static int GeoPhy_DrainLine(TDrainCtx *Ctx,TDrainPart *Part,double *Sum) {
+
+   int    n,ci,cj,si,sj,nc,nseam=0;
+   double x0,y0,dx,dy,len,t,tn,tmx,tmy,tdx,tdy;
+
+   for(n=0;n<Part->N-1;n++) {
+      len=DIST(0.0,Part->Lat[n],Part->Lon[n],Part->Lat[n+1],Part->Lon[n+1]);
+      if (len<=0.0)
+         continue;
+
+      x0=Part->X[n];
+      y0=Part->Y[n];
+      dx=Part->X[n+1]-x0;
+      dy=Part->Y[n+1]-y0;
+
+      // Segment wrapping around a global grid seam
+      if (fabs(dx)>Ctx->NI*0.5) {
+         nseam++;
+         continue;
+      }
+
+      ci=floor(x0+0.5);
+      cj=floor(y0+0.5);
+      si=dx>0?1:-1;
+      sj=dy>0?1:-1;
+      tmx=dx!=0.0?((ci+0.5*si)-x0)/dx:HUGE_VAL;
+      tmy=dy!=0.0?((cj+0.5*sj)-y0)/dy:HUGE_VAL;
+      tdx=dx!=0.0?1.0/fabs(dx):HUGE_VAL;
+      tdy=dy!=0.0?1.0/fabs(dy):HUGE_VAL;
+
+      // Number of cells crossed is bounded, protect against numerical drift
+      nc=abs((int)floor(Part->X[n+1]+0.5)-ci)+abs((int)floor(Part->Y[n+1]+0.5)-cj)+1;
+
+      for(t=0.0;t<1.0 && nc--;) {
+         tn=FMIN(FMIN(tmx,tmy),1.0);
+         if (ci>=0 && ci<Ctx->NI && cj>=0 && cj<Ctx->NJ) {
+            Sum[cj*Ctx->NI+ci]+=(tn-t)*len;
+         }
+         t=tn;
+         if (tmx<tmy) {
+            ci+=si;
+            tmx+=tdx;
+         } else {
+            cj+=sj;
+            tmy+=tdy;
+         }
+      }
+   }
+   return(nseam);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_DrainClip>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Clip a polygon against an axis aligned half plane (Sutherland-Hodgman)
+ *
+ * Parametres :
+ *  <In>      : Input vertices (x,y interleaved).
+ *  <N>       : Number of input vertices.
+ *  <Out>     : Output vertices (at least 2*N).
+ *  <Axis>    : Axis (0:X 1:Y).
+ *  <Val>     : Half plane limit.
+ *  <Sign>    : Side kept (1:greater -1:lower).
+ *
+ * Retour:
+ *  <N>       : Number of output vertices
+ *
+ * Remarques :
+ *----------------------------------------------------------------------------
+*/
+static int GeoPhy_DrainClip(double *In,int N,double *Out,int Axis,double Val,int Sign) {
+
+   int     n,no=0,in0,in1;
+   double *p0,*p1,t;
+
+   if (N<3)
+      return(0);
+
+   p0=&In[(N-1)*2];
+   in0=(p0[Axis]-Val)*Sign>=0.0;
+
+   for(n=0;n<N;n++) {
+      p1=&In[n*2];
+      in1=(p1[Axis]-Val)*Sign>=0.0;
+
+      if (in0!=in1) {
+         t=(Val-p0[Axis])/(p1[Axis]-p0[Axis]);
+         Out[no*2]  =p0[0]+t*(p1[0]-p0[0]);
+         Out[no*2+1]=p0[1]+t*(p1[1]-p0[1]);
+         Out[no*2+Axis]=Val;
+         no++;
+      }
+      if (in1) {
+         Out[no*2]  =p1[0];
+         Out[no*2+1]=p1[1];
+         no++;
+      }
+      p0=p1;
+      in0=in1;
+   }
+   return(no);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_DrainBuffer>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Make sure a thread clipping buffer is large enough
+ *
+ * Parametres :
+ *  <Thread>  : Thread data.
+ *  <B>       : Buffer index.
+ *  <N>       : Number of vertices needed.
+ *
+ * Retour:
+ *  <...>     : 0:Fail 1:Ok
+ *
+ * Remarques :
+ *----------------------------------------------------------------------------
+*/
+static int GeoPhy_DrainBuffer(TDrainThread *Thread,int B,int N) {
+
+   double *buf;
+
+   if (Thread->Size[B]<N) {
+      if (!(buf=(double*)realloc(Thread->Buf[B],N*2*sizeof(double)))) {
+         return(0);
+      }
+      Thread->Buf[B]=buf;
+      Thread->Size[B]=N;
+   }
+   return(1);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_DrainArea>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Distribute the area of a polygon ring over the cells it covers
+ *
+ * Parametres :
+ *  <Thread>  : Thread data.
+ *  <Part>    : Ring to distribute.
+ *  <Sum>     : Partial sums to accumulate into.
+ *
+ * Retour:
+ *
+ * Remarques :
+ *    - The ring is first clipped to each cell row, then each row strip is
+ *      clipped to the cells of the row
+ *    - Holes are removed from the sums
+ *----------------------------------------------------------------------------
+*/
+static void GeoPhy_DrainArea(TDrainThread *Thread,TDrainPart *Part,double *Sum) {
+
+   TDrainCtx *ctx=Thread->Ctx;
+   int        n,i,j,ns,nc,nr,idx;
+   double    *ring,*strip,*cell,*tmp,a,sign;
+
+   nr=Part->N;
+   if (nr<3 || !GeoPhy_DrainBuffer(Thread,0,nr) || !GeoPhy_DrainBuffer(Thread,1,nr*2) || !GeoPhy_DrainBuffer(Thread,2,nr*4) || !GeoPhy_DrainBuffer(Thread,3,nr*8)) {
+      return;
+   }
+   ring=Thread->Buf[0];
+   for(n=0;n<nr;n++) {
+      ring[n*2]=Part->X[n];
+      ring[n*2+1]=Part->Y[n];
+   }
+   sign=Part->Type==DRAIN_HOLE?-1.0:1.0;
+
+   for(j=Part->J0;j<=Part->J1;j++) {
+      // Clip to row strip
+      tmp=Thread->Buf[1];
+      strip=Thread->Buf[2];
+      ns=GeoPhy_DrainClip(ring,nr,tmp,1,j-0.5,1);
+      ns=GeoPhy_DrainClip(tmp,ns,strip,1,j+0.5,-1);
+      if (ns<3)
+         continue;
+
+      if (!GeoPhy_DrainBuffer(Thread,1,ns*2) || !GeoPhy_DrainBuffer(Thread,3,ns*4)) {
+         return;
+      }
+      for(i=Part->I0;i<=Part->I1;i++) {
+         // Clip strip to cell
+         tmp=Thread->Buf[1];
+         cell=Thread->Buf[3];
+         nc=GeoPhy_DrainClip(strip,ns,tmp,0,i-0.5,1);
+         nc=GeoPhy_DrainClip(tmp,nc,cell,0,i+0.5,-1);
+         if (nc<3)
+            continue;
+
+         // Shoelace area in grid units (fraction of the cell)
+         a=0.0;
+         for(n=0;n<nc;n++) {
+            idx=(n+1)%nc;
+            a+=cell[n*2]*cell[idx*2+1]-cell[idx*2]*cell[n*2+1];
+         }
+         idx=j*ctx->NI+i;
+         Sum[idx]+=sign*fabs(a)*0.5*ctx->CellArea[idx];
+      }
+   }
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_DrainThread>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Thread accumulating parts into its partial sums
+ *
+ * Parametres :
+ *  <Data>    : Thread data (TDrainThread).
+ *
+ * Retour:
+ *
+ * Remarques :
+ *    - Parts are fetched by chunks from the shared context
+ *----------------------------------------------------------------------------
+*/
+static void* GeoPhy_DrainThread(void *Data) {
+
+   TDrainThread *thread=(TDrainThread*)Data;
+   TDrainCtx    *ctx=thread->Ctx;
+   TDrainPart   *part;
+   int           n,n0,n1;
+
+   while(1) {
+      pthread_mutex_lock(&ctx->Lock);
+      n0=ctx->Next;
+      n1=ctx->Next=FMIN(ctx->Next+DRAIN_CHUNK,ctx->NPart);
+      pthread_mutex_unlock(&ctx->Lock);
+
+      if (n0>=n1)
+         break;
+
+      for(n=n0;n<n1;n++) {
+         part=&ctx->Parts[n];
+
+         // Lines and rings go to the target length, rings of lake files also to the lake area
+         if (thread->Sum[ctx->Target])
+            thread->NSeam+=GeoPhy_DrainLine(ctx,part,thread->Sum[ctx->Target]);
+         if (part->Type!=DRAIN_LINE && ctx->Target==1 && thread->Sum[2])
+            GeoPhy_DrainArea(thread,part,thread->Sum[2]);
+      }
+   }
+   return(NULL);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_DrainAddPart>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Add a simple geometry (line or ring) to the part list
+ *
+ * Parametres :
+ *  <Parts>   : Part list.
+ *  <NPart>   : Number of parts.
+ *  <Size>    : Allocated size of the part list.
+ *  <Geom>    : Simple geometry.
+ *  <Type>    : Part type.
+ *
+ * Retour:
+ *  <...>     : 0:Fail 1:Ok
+ *
+ * Remarques :
+ *----------------------------------------------------------------------------
+*/
+static int GeoPhy_DrainAddPart(TDrainPart **Parts,int *NPart,int *Size,OGRGeometryH Geom,int Type) {
+
+   TDrainPart *part;
+   int         n,nv;
+
+   if ((nv=OGR_G_GetPointCount(Geom))<2)
+      return(1);
+
+   if (*NPart>=*Size) {
+      *Size=*Size?*Size*2:1024;
+      if (!(part=(TDrainPart*)realloc(*Parts,*Size*sizeof(TDrainPart)))) {
+         return(0);
+      }
+      *Parts=part;
+   }
+   part=&(*Parts)[*NPart];
+   part->N=nv;
+   part->Type=Type;
+   part->X=(float*)malloc(nv*2*sizeof(float));
+   part->Lat=(double*)malloc(nv*2*sizeof(double));
+   if (!part->X || !part->Lat) {
+      free(part->X);
+      free(part->Lat);
+      return(0);
+   }
+   part->Y=part->X+nv;
+   part->Lon=part->Lat+nv;
+
+   for(n=0;n<nv;n++) {
+      part->Lon[n]=OGR_G_GetX(Geom,n);
+      part->Lat[n]=OGR_G_GetY(Geom,n);
+   }
+   (*NPart)++;
+
+   return(1);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_DrainAddGeom>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Decompose a geometry into lines and rings
+ *
+ * Parametres :
+ *  <Parts>   : Part list.
+ *  <NPart>   : Number of parts.
+ *  <Size>    : Allocated size of the part list.
+ *  <Geom>    : Geometry.
+ *
+ * Retour:
+ *  <...>     : 0:Fail 1:Ok
+ *
+ * Remarques :
+ *----------------------------------------------------------------------------
+*/
+static int GeoPhy_DrainAddGeom(TDrainPart **Parts,int *NPart,int *Size,OGRGeometryH Geom) {
+
+   int n,ok=1;
+
+   switch(wkbFlatten(OGR_G_GetGeometryType(Geom))) {
+      case wkbLineString:
+      case wkbLinearRing:
+         ok=GeoPhy_DrainAddPart(Parts,NPart,Size,Geom,DRAIN_LINE);
+         break;
+
+      case wkbPolygon:
+         for(n=0;ok && n<OGR_G_GetGeometryCount(Geom);n++) {
+            ok=GeoPhy_DrainAddPart(Parts,NPart,Size,OGR_G_GetGeometryRef(Geom,n),n?DRAIN_HOLE:DRAIN_RING);
+         }
+         break;
+
+      case wkbMultiLineString:
+      case wkbMultiPolygon:
+      case wkbGeometryCollection:
+         for(n=0;ok && n<OGR_G_GetGeometryCount(Geom);n++) {
+            ok=GeoPhy_DrainAddGeom(Parts,NPart,Size,OGR_G_GetGeometryRef(Geom,n));
+         }
+         break;
+
+      default:
+         break;
+   }
+   return(ok);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_DrainRead>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Read the features of a vector file into parts
+ *
+ * Parametres :
+ *  <Interp>  : Interpreteur TCL.
+ *  <File>    : Vector file path.
+ *  <Limits>  : Grid geographic limits (la0,lo0,la1,lo1) or NULL.
+ *  <Parts>   : Part list.
+ *  <NPart>   : Number of parts.
+ *  <Size>    : Allocated size of the part list.
+ *
+ * Retour:
+ *  <Nb>      : Number of features read (-1 on error)
+ *
+ * Remarques :
+ *    - Non geographic layers are reprojected to WGS84
+ *    - The spatial filter uses the layer index when one is available
+ *----------------------------------------------------------------------------
+*/
+static int GeoPhy_DrainRead(Tcl_Interp *Interp,char *File,double *Limits,TDrainPart **Parts,int *NPart,int *Size) {
+
+   GDALDatasetH                 ds;
+   OGRLayerH                    layer;
+   OGRFeatureH                  feature;
+   OGRGeometryH                 geom;
+   OGRSpatialReferenceH         src,dst=NULL;
+   OGRCoordinateTransformationH tr=NULL;
+   int                          nb=0,ok=1;
+
+   if (!(ds=GDALOpenEx(File,GDAL_OF_VECTOR|GDAL_OF_READONLY,NULL,NULL,NULL))) {
+      Tcl_AppendResult(Interp,"GeoPhy_DrainDensity: Unable to open file ",File,(char*)NULL);
+      return(-1);
+   }
+   layer=GDALDatasetGetLayer(ds,0);
+
+   if ((src=OGR_L_GetSpatialRef(layer)) && !OSRIsGeographic(src)) {
+      dst=OSRNewSpatialReference(NULL);
+      OSRSetWellKnownGeogCS(dst,"WGS84");
+#if GDAL_VERSION_MAJOR>=3
+      OSRSetAxisMappingStrategy(dst,OAMS_TRADITIONAL_GIS_ORDER);
+#endif
+      tr=OCTNewCoordinateTransformation(src,dst);
+   } else if (Limits && Limits[1]<=Limits[3]) {
+      OGR_L_SetSpatialFilterRect(layer,Limits[1],Limits[0],Limits[3],Limits[2]);
+   }
+
+   OGR_L_ResetReading(layer);
+   while(ok && (feature=OGR_L_GetNextFeature(layer))) {
+      if ((geom=OGR_F_GetGeometryRef(feature))) {
+         if (!tr || OGR_G_Transform(geom,tr)==OGRERR_NONE) {
+            ok=GeoPhy_DrainAddGeom(Parts,NPart,Size,geom);
+            nb++;
+         }
+      }
+      OGR_F_Destroy(feature);
+   }
+
+   if (tr)  OCTDestroyCoordinateTransformation(tr);
+   if (dst) OSRDestroySpatialReference(dst);
+   GDALClose(ds);
+
+   if (!ok) {
+      Tcl_AppendResult(Interp,"GeoPhy_DrainDensity: Unable to allocate features of ",File,(char*)NULL);
+      return(-1);
+   }
+   return(nb);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_DrainProject>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Project parts in grid space and find their cell bounds
+ *
+ * Parametres :
+ *  <Ref>     : Grid georeference.
+ *  <Ctx>     : Accumulation context.
+ *
+ * Retour:
+ *
+ * Remarques :
+ *    - Parts outside of the grid are removed (cell bounds index)
+ *    - Geographic coordinates are converted to radians for distances
+ *----------------------------------------------------------------------------
+*/
+static void GeoPhy_DrainProject(TGeoRef *Ref,TDrainCtx *Ctx) {
+
+   TDrainPart *part;
+   float      *lat,*lon;
+   double      x0,y0,x1,y1;
+   int         p,n,np=0,nv=0;
+
+   for(p=0;p<Ctx->NPart;p++) nv=FMAX(nv,Ctx->Parts[p].N);
+   lat=(float*)malloc(nv*2*sizeof(float));
+   lon=lat+nv;
+
+   for(p=0;p<Ctx->NPart;p++) {
+      part=&Ctx->Parts[p];
+
+      for(n=0;n<part->N;n++) {
+         lat[n]=part->Lat[n];
+         lon[n]=part->Lon[n];
+      }
+      c_gdxyfll(Ref->Ids[0],part->X,part->Y,lat,lon,part->N);
+
+      x0=y0=HUGE_VAL;
+      x1=y1=-HUGE_VAL;
+      for(n=0;n<part->N;n++) {
+         part->X[n]-=1.0;
+         part->Y[n]-=1.0;
+         part->Lat[n]=DEG2RAD(part->Lat[n]);
+         part->Lon[n]=DEG2RAD(part->Lon[n]);
+         x0=FMIN(x0,part->X[n]); x1=FMAX(x1,part->X[n]);
+         y0=FMIN(y0,part->Y[n]); y1=FMAX(y1,part->Y[n]);
+      }
+      part->I0=FMAX(0,floor(x0+0.5));
+      part->J0=FMAX(0,floor(y0+0.5));
+      part->I1=FMIN(Ctx->NI-1,floor(x1+0.5));
+      part->J1=FMIN(Ctx->NJ-1,floor(y1+0.5));
+
+      // Keep only parts overlapping the grid
+      if (part->I0<=part->I1 && part->J0<=part->J1) {
+         Ctx->Parts[np++]=*part;
+      } else {
+         free(part->X);
+         free(part->Lat);
+      }
+   }
+   Ctx->NPart=np;
+   free(lat);
+}
+#endif
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_DrainDensity>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Accumule les longueurs de rivieres, perimetres et aires de lacs
+ *            par maille pour le calcul de la densite de drainage
+ *
+ * Parametres :
+ *  <Interp>  : Interpreteur TCL.
+ *  <RSum>    : Somme des longueurs de rivieres (NULL si non requis).
+ *  <LSum>    : Somme des perimetres de lacs (NULL si non requis).
+ *  <LArea>   : Somme des aires de lacs (NULL si non requis).
+ *  <Rivers>  : Liste des fichiers de rivieres.
+ *  <Lakes>   : Liste des fichiers de lacs.
+ *  <Limits>  : Limites geographiques de la grille (la0,lo0,la1,lo1) ou NULL.
+ *  <Merge>   : Mode de fusion dans les champs (GEOPHY_MERGE_ADD ou GEOPHY_MERGE_MAX).
+ *  <NThread> : Nombre de threads (<=0 pour tous les processeurs).
+ *
+ * Retour:
+ *  <TCL_...> : Code d'erreur de TCL (resultat: {nb_features nb_seam_segments}).
+ *
+ * Remarques :
+ *    - Equivalent of the fstdfield gridinterp LENGTH_CONSERVATIVE/FEATURE_LENGTH_METER
+ *      and CONSERVATIVE/FEATURE_AREA_METER accumulations of HydroX
+ *    - Polygon rings of river files add to the river length only, those of lake
+ *      files to the lake perimeter and area
+ *    - Each thread accumulates into its own partial sums which are reduced at the end,
+ *      so a whole database is processed in one call
+ *    - The number of threads is capped so that the partial sums fit in DRAIN_MEMORY
+ *    - Grid seams (global grids) are not handled, segments crossing them are skipped
+ *      and their count returned for the caller to report
+ *----------------------------------------------------------------------------
+*/
+int GeoPhy_DrainDensity(Tcl_Interp *Interp,TData *RSum,TData *LSum,TData *LArea,Tcl_Obj *Rivers,Tcl_Obj *Lakes,double *Limits,int Merge,int NThread) {
+
+#ifdef HAVE_GDAL
+   TData        *fld[3],*ref=NULL;
+   TDrainCtx     ctx;
+   TDrainThread *threads=NULL;
+   pthread_t    *tids=NULL;
+   Tcl_Obj      *list[2],*obj;
+   double        dx,dy,val,sum;
+   int           f,l,n,t,i,j,nfile,nfeat=0,nb,size,ncell,nt,nfld=0,nseam=0,ok=1;
+
+   fld[0]=RSum;
+   fld[1]=LSum;
+   fld[2]=LArea;
+   for(f=0;f<3;f++) {
+      if (fld[f]) {
+         nfld++;
+         if (!ref) {
+            ref=fld[f];
+         } else if (fld[f]->Def->NI!=ref->Def->NI || fld[f]->Def->NJ!=ref->Def->NJ) {
+            Tcl_AppendResult(Interp,"GeoPhy_DrainDensity: Fields dimensions mismatch",(char*)NULL);
+            return(TCL_ERROR);
+         }
+      }
+   }
+   if (!ref) {
+      Tcl_AppendResult(Interp,"GeoPhy_DrainDensity: No valid field to accumulate into",(char*)NULL);
+      return(TCL_ERROR);
+   }
+
+   if (NThread<=0) {
+      NThread=FMAX(1,sysconf(_SC_NPROCESSORS_ONLN));
+   }
+
+   memset(&ctx,0x0,sizeof(TDrainCtx));
+   ctx.NI=ref->Def->NI;
+   ctx.NJ=ref->Def->NJ;
+   ncell=ctx.NI*ctx.NJ;
+
+   // Each thread holds full grid partial sums, limit their number to the memory budget
+   nt=FMAX(1,(DRAIN_MEMORY*1048576.0)/((double)nfld*ncell*sizeof(double)));
+   NThread=FMIN(NThread,nt);
+   pthread_mutex_init(&ctx.Lock,NULL);
+
+   // Cell areas in meters for lake area distribution
+   if (LArea) {
+      if (!(ctx.CellArea=(double*)malloc(ncell*sizeof(double)))) {
+         Tcl_AppendResult(Interp,"GeoPhy_DrainDensity: Unable to allocate cell areas",(char*)NULL);
+         return(TCL_ERROR);
+      }
+      for(j=0;j<ctx.NJ;j++) {
+         for(i=0;i<ctx.NI;i++) {
+            GeoPhy_GridPointResolution(ref->GRef,ref->Def,i,j,&dx,&dy);
+            ctx.CellArea[j*ctx.NI+i]=dx*dy;
+         }
+      }
+   }
+
+   // Per thread partial sums
+   threads=(TDrainThread*)calloc(NThread,sizeof(TDrainThread));
+   tids=(pthread_t*)malloc(NThread*sizeof(pthread_t));
+   for(t=0;threads && t<NThread;t++) {
+      threads[t].Ctx=&ctx;
+      for(f=0;f<3;f++) {
+         if (fld[f] && !(threads[t].Sum[f]=(double*)calloc(ncell,sizeof(double)))) {
+            ok=0;
+         }
+      }
+   }
+   if (!threads || !tids || !ok) {
+      Tcl_AppendResult(Interp,"GeoPhy_DrainDensity: Unable to allocate partial sums",(char*)NULL);
+      nfeat=-1;
+      goto end;
+   }
+
+   // Process rivers then lakes, one file at a time
+   list[0]=Rivers;
+   list[1]=Lakes;
+   for(l=0;l<2;l++) {
+      if (!list[l] || Tcl_ListObjLength(Interp,list[l],&nfile)!=TCL_OK)
+         continue;
+
+      ctx.Target=l;
+      for(n=0;n<nfile;n++) {
+         Tcl_ListObjIndex(Interp,list[l],n,&obj);
+
+         ctx.NPart=size=0;
+         ctx.Parts=NULL;
+         if ((nb=GeoPhy_DrainRead(Interp,Tcl_GetString(obj),Limits,&ctx.Parts,&ctx.NPart,&size))<0) {
+            for(i=0;i<ctx.NPart;i++) {
+               free(ctx.Parts[i].X);
+               free(ctx.Parts[i].Lat);
+            }
+            free(ctx.Parts);
+            nfeat=-1;
+            goto end;
+         }
+         nfeat+=nb;
+
+         // Projection uses the grid library which is not thread safe
+         GeoPhy_DrainProject(ref->GRef,&ctx);
+
+         ctx.Next=0;
+         nt=FMIN(NThread,(ctx.NPart+DRAIN_CHUNK-1)/DRAIN_CHUNK);
+         for(t=1;t<nt;t++) {
+            pthread_create(&tids[t],NULL,GeoPhy_DrainThread,&threads[t]);
+         }
+         GeoPhy_DrainThread(&threads[0]);
+         for(t=1;t<nt;t++) {
+            pthread_join(tids[t],NULL);
+         }
+
+         for(i=0;i<ctx.NPart;i++) {
+            free(ctx.Parts[i].X);
+            free(ctx.Parts[i].Lat);
+         }
+         free(ctx.Parts);
+      }
+   }
+
+   for(t=0;t<NThread;t++) {
+      nseam+=threads[t].NSeam;
+   }
+
+   // Reduce partial sums into the fields
+   for(f=0;f<3;f++) {
+      if (!fld[f])
+         continue;
+
+      for(i=0;i<ncell;i++) {
+         sum=0.0;
+         for(t=0;t<NThread;t++) {
+            sum+=threads[t].Sum[f][i];
+         }
+         Def_Get(fld[f]->Def,0,i,val);
+         val=Merge==GEOPHY_MERGE_MAX?FMAX(val,sum):val+sum;
+         Def_Set(fld[f]->Def,0,i,val);
+      }
+   }
+
+end:
+   if (threads) {
+      for(t=0;t<NThread;t++) {
+         for(f=0;f<3;f++) free(threads[t].Sum[f]);
+         for(f=0;f<4;f++) free(threads[t].Buf[f]);
+      }
+      free(threads);
+   }
+   free(tids);
+   free(ctx.CellArea);
+   pthread_mutex_destroy(&ctx.Lock);
+
+   if (nfeat<0)
+      return(TCL_ERROR);
+
+   obj=Tcl_NewListObj(0,NULL);
+   Tcl_ListObjAppendElement(Interp,obj,Tcl_NewIntObj(nfeat));
+   Tcl_ListObjAppendElement(Interp,obj,Tcl_NewIntObj(nseam));
+   Tcl_SetObjResult(Interp,obj);
+   return(TCL_OK);
+#else
+   Tcl_AppendResult(Interp,"GeoPhy_DrainDensity: Library not built with GDAL",(char*)NULL);
+   return(TCL_ERROR);
+#endif
+}
@@ -0,0 +1,277 @@
+/*=========================================================
+ * Environnement Canada
+ * Centre Meteorologique Canadien
+ * 2100 Trans-Canadienne
+ * Dorval, Quebec
+ *
+ * Projet       : Lecture et traitements de divers fichiers de donnees
+ * Fichier      : GeoPhyRaster.c
+ * Creation     : Octobre 2026 - CMC/CMDS
+ *
+ * Description  : Fonctions de moyennage de bases de donnees matricielles.
+ *
+ * Remarques    :
+ *
+ * License      :
+ *    This library is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation,
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with this library; if not, write to the
+ *    Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ *    Boston, MA 02111-1307, USA.
+ *
+ *=========================================================
+ */
+#include "GeoPhy.h"
+
+#ifdef HAVE_GDAL
+#include "gdal.h"
+#include "ogr_srs_api.h"
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_RasterMap>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Trouver la maille de grille de chaque pixel d'une tuile
+ *
+ * Parametres :
+ *  <Ref>     : Georeference de la grille.
+ *  <NI>      : Dimension en I de la grille.
+ *  <NJ>      : Dimension en J de la grille.
+ *  <Tr>      : Transformation affine des rasters.
+ *  <Trans>   : Transformation vers latlon (NULL si les rasters sont en latlon).
+ *  <X0>      : Pixel de depart en X.
+ *  <Y0>      : Pixel de depart en Y.
+ *  <W>       : Largeur de la tuile.
+ *  <H>       : Hauteur de la tuile.
+ *  <Map>     : Index des mailles (-1 si hors grille).
+ *  <Buf>     : Tampon de travail (4*W*H float).
+ *
+ * Retour:
+ *
+ * Remarques :
+ *    - Le centre du pixel determine la maille, comme le moyennage par point
+ *      (celldim 1) de fstdfield gridinterp
+ *----------------------------------------------------------------------------
+*/
+static void GeoPhy_RasterMap(TGeoRef *Ref,int NI,int NJ,double *Tr,OGRCoordinateTransformationH Trans,int X0,int Y0,int W,int H,long *Map,float *Buf) {
+
+   float  *lat,*lon,*gx,*gy;
+   double  px,py,x,y;
+   int     i,j,n,ci,cj;
+
+   lat=Buf;
+   lon=Buf+W*H;
+   gx=Buf+2*W*H;
+   gy=Buf+3*W*H;
+
+   for(j=0,n=0;j<H;j++) {
+      py=Y0+j+0.5;
+      for(i=0;i<W;i++,n++) {
+         px=X0+i+0.5;
+         x=Tr[0]+px*Tr[1]+py*Tr[2];
+         y=Tr[3]+px*Tr[4]+py*Tr[5];
+         if (Trans && !OCTTransform(Trans,1,&x,&y,NULL)) {
+            x=y=-999.0;
+         }
+         lon[n]=x;
+         lat[n]=y;
+      }
+   }
+
+   c_gdxyfll(Ref->Ids[0],gx,gy,lat,lon,W*H);
+
+   for(n=0;n<W*H;n++) {
+      ci=floor(gx[n]-0.5);
+      cj=floor(gy[n]-0.5);
+      Map[n]=(lat[n]<-900.0 || ci<0 || cj<0 || ci>=NI || cj>=NJ)?-1:(long)cj*NI+ci;
+   }
+}
+#endif
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_RasterAverage>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Moyenner en une seule passe toutes les bandes d'un ensemble de
+ *            rasters co-localises sur une grille
+ *
+ * Parametres :
+ *  <Interp>  : Interpreteur TCL.
+ *  <Out>     : Champs de sortie, un par bande dans l'ordre des fichiers.
+ *  <NOut>    : Nombre de champs de sortie.
+ *  <Files>   : Liste des fichiers rasters.
+ *  <NoData>  : Valeur nodata de toutes les bandes.
+ *  <Limits>  : Fenetre de pixels a traiter (x0,y0,x1,y1) ou NULL pour tout.
+ *  <Tile>    : Dimension des tuiles de lecture.
+ *
+ * Retour:
+ *  <TCL_...> : Code d'erreur de TCL.
+ *
+ * Remarques :
+ *    - Equivalent of the per band tile loop of fstdfield gridinterp AVERAGE
+ *      with point cells (celldim 1), the cells without samples are left as is
+ *    - The rasters are read tile by tile in lockstep so the grid cell of each
+ *      pixel is found only once for all bands
+ *    - The sums use NOut*NI*NJ*12 bytes, callers should split large stacks
+ *    - NoData is used for every band, whatever nodata value the band defines,
+ *      as gdalband stats -nodata does in the per band path
+ *----------------------------------------------------------------------------
+*/
+int GeoPhy_RasterAverage(Tcl_Interp *Interp,TData **Out,int NOut,Tcl_Obj *Files,double NoData,int *Limits,int Tile) {
+
+#ifdef HAVE_GDAL
+   GDALDatasetH                *ds=NULL;
+   OGRSpatialReferenceH         src=NULL,dst=NULL;
+   OGRCoordinateTransformationH ct=NULL;
+   Tcl_Obj    *obj;
+   TGeoRef    *ref;
+   double      tr[6],trf[6],*sum=NULL;
+   unsigned    int *cnt=NULL;
+   float      *val=NULL,*buf=NULL,nodata;
+   long       *map=NULL;
+   int         nf,f,b,o,nb,x,y,w,h,n,nx=0,ny=0,x0,y0,x1,y1,ni,nj,code=TCL_ERROR;
+   unsigned long nij,c;
+
+   if (Tcl_ListObjLength(Interp,Files,&nf)!=TCL_OK) {
+      return(TCL_ERROR);
+   }
+   if (!NOut || !Out[0]) {
+      Tcl_AppendResult(Interp,"GeoPhy_RasterAverage: Invalid output fields",(char*)NULL);
+      return(TCL_ERROR);
+   }
+   ref=Out[0]->GRef;
+   ni=Out[0]->Def->NI;
+   nj=Out[0]->Def->NJ;
+   nij=(unsigned long)ni*nj;
+   for(o=0;o<NOut;o++) {
+      if (!Out[o] || Out[o]->Def->NI!=ni || Out[o]->Def->NJ!=nj) {
+         Tcl_AppendResult(Interp,"GeoPhy_RasterAverage: Invalid or mismatched output field",(char*)NULL);
+         return(TCL_ERROR);
+      }
+   }
+
+   GDALAllRegister();
+
+   // Open the rasters and check that they are co-registered
+   ds=(GDALDatasetH*)calloc(nf,sizeof(GDALDatasetH));
+   for(f=0,nb=0;f<nf;f++) {
+      Tcl_ListObjIndex(Interp,Files,f,&obj);
+      if (!(ds[f]=GDALOpen(Tcl_GetString(obj),GA_ReadOnly))) {
+         Tcl_AppendResult(Interp,"GeoPhy_RasterAverage: Unable to open raster ",Tcl_GetString(obj),(char*)NULL);
+         goto end;
+      }
+      if (GDALGetGeoTransform(ds[f],f?trf:tr)!=CE_None) {
+         Tcl_AppendResult(Interp,"GeoPhy_RasterAverage: Raster has no geotransform ",Tcl_GetString(obj),(char*)NULL);
+         goto end;
+      }
+      if (!f) {
+         nx=GDALGetRasterXSize(ds[f]);
+         ny=GDALGetRasterYSize(ds[f]);
+      } else if (GDALGetRasterXSize(ds[f])!=nx || GDALGetRasterYSize(ds[f])!=ny || memcmp(tr,trf,6*sizeof(double))) {
+         Tcl_AppendResult(Interp,"GeoPhy_RasterAverage: Raster is not co-registered with the first one ",Tcl_GetString(obj),(char*)NULL);
+         goto end;
+      }
+      nb+=GDALGetRasterCount(ds[f]);
+   }
+   if (nb!=NOut) {
+      Tcl_AppendResult(Interp,"GeoPhy_RasterAverage: Number of output fields does not match number of bands",(char*)NULL);
+      goto end;
+   }
+
+   // Nodata value, in the precision the bands are read at
+   nodata=(float)NoData;
+
+   // Projected rasters need their pixel centers in latlon
+   if (nf) {
+      src=OSRNewSpatialReference(GDALGetProjectionRef(ds[0]));
+      if (src && GDALGetProjectionRef(ds[0])[0]!='\0' && !OSRIsGeographic(src)) {
+         dst=OSRNewSpatialReference(NULL);
+         OSRSetWellKnownGeogCS(dst,"WGS84");
+#if GDAL_VERSION_MAJOR>=3
+         OSRSetAxisMappingStrategy(src,OAMS_TRADITIONAL_GIS_ORDER);
+         OSRSetAxisMappingStrategy(dst,OAMS_TRADITIONAL_GIS_ORDER);
+#endif
+         ct=OCTNewCoordinateTransformation(src,dst);
+      }
+   }
+
+   x0=0;y0=0;x1=nx-1;y1=ny-1;
+   if (Limits) {
+      x0=FMAX(0,Limits[0]);    y0=FMAX(0,Limits[1]);
+      x1=FMIN(nx-1,Limits[2]); y1=FMIN(ny-1,Limits[3]);
+   }
+
+   sum=(double*)calloc((size_t)NOut*nij,sizeof(double));
+   cnt=(unsigned int*)calloc((size_t)NOut*nij,sizeof(unsigned int));
+   val=(float*)malloc((size_t)Tile*Tile*sizeof(float));
+   buf=(float*)malloc((size_t)4*Tile*Tile*sizeof(float));
+   map=(long*)malloc((size_t)Tile*Tile*sizeof(long));
+   if (!sum || !cnt || !val || !buf || !map) {
+      Tcl_AppendResult(Interp,"GeoPhy_RasterAverage: Unable to allocate accumulation buffers",(char*)NULL);
+      goto end;
+   }
+
+   for(y=y0;y<=y1;y+=Tile) {
+      for(x=x0;x<=x1;x+=Tile) {
+         w=FMIN(Tile,x1-x+1);
+         h=FMIN(Tile,y1-y+1);
+
+         // Map the pixels once, then accumulate every band of every raster
+         GeoPhy_RasterMap(ref,ni,nj,tr,ct,x,y,w,h,map,buf);
+
+         for(f=0,o=0;f<nf;f++) {
+            for(b=1;b<=GDALGetRasterCount(ds[f]);b++,o++) {
+               if (GDALRasterIO(GDALGetRasterBand(ds[f],b),GF_Read,x,y,w,h,val,w,h,GDT_Float32,0,0)!=CE_None) {
+                  Tcl_AppendResult(Interp,"GeoPhy_RasterAverage: Unable to read raster tile",(char*)NULL);
+                  goto end;
+               }
+               for(n=0;n<w*h;n++) {
+                  if (map[n]<0 || val[n]==nodata || isnan(val[n]))
+                     continue;
+                  c=(unsigned long)o*nij+map[n];
+                  sum[c]+=val[n];
+                  cnt[c]++;
+               }
+            }
+         }
+      }
+   }
+
+   for(o=0;o<NOut;o++) {
+      for(c=0;c<nij;c++) {
+         if (cnt[(unsigned long)o*nij+c]) {
+            Def_Set(Out[o]->Def,0,c,sum[(unsigned long)o*nij+c]/cnt[(unsigned long)o*nij+c]);
+         }
+      }
+   }
+   code=TCL_OK;
+
+end:
+   if (ds) {
+      for(f=0;f<nf;f++) if (ds[f]) GDALClose(ds[f]);
+      free(ds);
+   }
+   if (ct)  OCTDestroyCoordinateTransformation(ct);
+   if (src) OSRDestroySpatialReference(src);
+   if (dst) OSRDestroySpatialReference(dst);
+   if (sum) free(sum);
+   if (cnt) free(cnt);
+   if (val) free(val);
+   if (buf) free(buf);
+   if (map) free(map);
+
+   return(code);
+#else
+   Tcl_AppendResult(Interp,"GeoPhy_RasterAverage: Library not built with GDAL",(char*)NULL);
+   return(TCL_ERROR);
+#endif
+}
@@ -33,7 +33,18 @@
 
 #include "GeoPhy.h"
 
+TCL_DECLARE_MUTEX(MUTEX_GEOPHYSUB)
+
+static Tcl_HashTable GeoPhy_SubTable;
+static int           GeoPhy_InitDone=0;
+
 static int GeoPhy_Cmd(ClientData clientData,Tcl_Interp *Interp,int Objc,Tcl_Obj *CONST Objv[]);
+static int GeoPhy_EmissionCmd(Tcl_Interp *Interp,Tcl_Obj *CONST Objv[]);
+static int GeoPhy_SubGridCmd(Tcl_Interp *Interp,int Objc,Tcl_Obj *CONST Objv[]);
+static TData** GeoPhy_DataList(Tcl_Interp *Interp,Tcl_Obj *List,int *N);
+static int GeoPhy_RasterAverageCmd(Tcl_Interp *Interp,int Objc,Tcl_Obj *CONST Objv[]);
+static TGeoPhySub* GeoPhy_SubGet(char *Name);
+static void        GeoPhy_SubPut(char *Name,TGeoPhySub *Sub);
 
 /*--------------------------------------------------------------------------------------------------------------
  * Nom          : <TclgeoPhy_Init>
@@ -56,11 +67,359 @@ int Tclgeophy_Init(Tcl_Interp *Interp) {
       return(TCL_ERROR);
    }
 
+   Tcl_MutexLock(&MUTEX_GEOPHYSUB);
+   if (!GeoPhy_InitDone++) {
+      Tcl_InitHashTable(&GeoPhy_SubTable,TCL_STRING_KEYS);
+   }
+   Tcl_MutexUnlock(&MUTEX_GEOPHYSUB);
+
    Tcl_CreateObjCommand(Interp,"geophy",GeoPhy_Cmd,(ClientData)NULL,(Tcl_CmdDeleteProc *)NULL);
 
    return(TCL_OK);
 }
 
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_SubGet>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Get the compact sub-grid samples associated to a field.
+ *
+ * Parametres     :
+ *  <Name>        : Field name
+ *
+ * Retour:
+ *  <Sub>         : Compact sub-grid samples (NULL if none)
+ *
+ * Remarques :
+ *
+ *----------------------------------------------------------------------------
+*/
+static TGeoPhySub* GeoPhy_SubGet(char *Name) {
+
+   Tcl_HashEntry *entry;
+   TGeoPhySub    *sub=NULL;
+
+   Tcl_MutexLock(&MUTEX_GEOPHYSUB);
+   if ((entry=Tcl_FindHashEntry(&GeoPhy_SubTable,Name))) {
+      sub=(TGeoPhySub*)Tcl_GetHashValue(entry);
+   }
+   Tcl_MutexUnlock(&MUTEX_GEOPHYSUB);
+
+   return(sub);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_SubPut>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Associate compact sub-grid samples to a field, freeing any previous ones.
+ *
+ * Parametres     :
+ *  <Name>        : Field name
+ *  <Sub>         : Compact sub-grid samples (NULL to only free)
+ *
+ * Retour:
+ *
+ * Remarques :
+ *
+ *----------------------------------------------------------------------------
+*/
+static void GeoPhy_SubPut(char *Name,TGeoPhySub *Sub) {
+
+   Tcl_HashEntry *entry;
+   int            new;
+
+   Tcl_MutexLock(&MUTEX_GEOPHYSUB);
+   if ((entry=Tcl_FindHashEntry(&GeoPhy_SubTable,Name))) {
+      GeoPhyCore_SubFree((TGeoPhySub*)Tcl_GetHashValue(entry));
+      Tcl_DeleteHashEntry(entry);
+   }
+   if (Sub) {
+      entry=Tcl_CreateHashEntry(&GeoPhy_SubTable,Name,&new);
+      Tcl_SetHashValue(entry,Sub);
+   }
+   Tcl_MutexUnlock(&MUTEX_GEOPHYSUB);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_DataList>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Get the fields of a list of field names.
+ *
+ * Parametres     :
+ *  <Interp>      : Interpreteur TCL.
+ *  <List>        : List of field names
+ *  <N>           : Number of fields
+ *
+ * Retour:
+ *  <Fields>      : Field table to free (NULL on error)
+ *
+ * Remarques :
+ *   - Unknown fields are reported by name
+ *----------------------------------------------------------------------------
+*/
+static TData** GeoPhy_DataList(Tcl_Interp *Interp,Tcl_Obj *List,int *N) {
+
+   TData   **fld;
+   Tcl_Obj **lobj;
+   int       n;
+
+   if (Tcl_ListObjGetElements(Interp,List,N,&lobj)!=TCL_OK) {
+      return(NULL);
+   }
+   if (!(fld=(TData**)malloc((*N?*N:1)*sizeof(TData*)))) {
+      Tcl_AppendResult(Interp,"Unable to allocate field table",(char*)NULL);
+      return(NULL);
+   }
+   for(n=0;n<*N;n++) {
+      if (!(fld[n]=Data_Get(Tcl_GetString(lobj[n])))) {
+         Tcl_AppendResult(Interp,"Invalid field ",Tcl_GetString(lobj[n]),(char*)NULL);
+         free(fld);
+         return(NULL);
+      }
+   }
+   return(fld);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_SubGridCmd>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Decode the arguments of the subgrid_legacy command and call the kernel.
+ *
+ * Parametres     :
+ *  <Interp>      : Interpreteur TCL.
+ *  <Objc>        : Nombre d'arguments
+ *  <Objv>        : Liste des arguments (topo vege zz lh dh hx2 hy2 hxy ?settings?)
+ *
+ * Retour:
+ *  <TCL_...> : Code d'erreur de TCL.
+ *
+ * Remarques :
+ *   - Each field argument can be a list, all of the same length, to compute
+ *     many sets on the same grid in one call
+ *----------------------------------------------------------------------------
+*/
+static int GeoPhy_SubGridCmd(Tcl_Interp *Interp,int Objc,Tcl_Obj *CONST Objv[]) {
+
+   TGeoPhySet   set;
+   TGeoPhySub **sub=NULL;
+   TData      **fld=NULL,**lst;
+   Tcl_Obj     *obj;
+   int          f,n,nfld,nset=0,code=TCL_ERROR;
+
+   if (GeoPhy_SettingsGet(Interp,Objc==11?Objv[10]:NULL,&set)!=TCL_OK) {
+      return(TCL_ERROR);
+   }
+
+   for(f=0;f<8;f++) {
+      if (!(lst=GeoPhy_DataList(Interp,Objv[2+f],&nfld))) {
+         goto end;
+      }
+      if (!f) {
+         nset=nfld;
+         fld=(TData**)malloc((nset?nset:1)*8*sizeof(TData*));
+         sub=(TGeoPhySub**)malloc((nset?nset:1)*sizeof(TGeoPhySub*));
+         if (!fld || !sub) {
+            free(lst);
+            Tcl_AppendResult(Interp,"Unable to allocate field table",(char*)NULL);
+            goto end;
+         }
+      } else if (nfld!=nset) {
+         free(lst);
+         Tcl_AppendResult(Interp,"All field lists must have the same length",(char*)NULL);
+         goto end;
+      }
+      for(n=0;n<nset;n++) {
+         fld[n*8+f]=lst[n];
+      }
+      free(lst);
+   }
+
+   for(n=0;n<nset;n++) {
+      if (Tcl_ListObjIndex(Interp,Objv[2],n,&obj)!=TCL_OK || !obj) {
+         goto end;
+      }
+      sub[n]=GeoPhy_SubGet(Tcl_GetString(obj));
+   }
+
+   code=GeoPhy_SubGridLegacy(Interp,fld,sub,nset,&set);
+
+end:
+   if (fld) free(fld);
+   if (sub) free(sub);
+
+   return(code);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_EmissionCmd>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Decode the arguments of the emissions command and call the kernel.
+ *
+ * Parametres     :
+ *  <Interp>      : Interpreteur TCL.
+ *  <Objv>        : Liste des arguments (fractions mask area outputs factors areaflags)
+ *
+ * Retour:
+ *  <TCL_...> : Code d'erreur de TCL.
+ *
+ * Remarques :
+ *   - Each factors row is {level factor_1 ... factor_nout}
+ *   - Empty mask or area names means none, unknown field names are reported by name
+ *   - The area flags list is either empty (none) or holds one flag per output
+ *----------------------------------------------------------------------------
+*/
+static int GeoPhy_EmissionCmd(Tcl_Interp *Interp,Tcl_Obj *CONST Objv[]) {
+
+   TData   *frac,*mask=NULL,*area=NULL,**out=NULL;
+   Tcl_Obj **lobj,*robj;
+   int      nout,ntype,nflag,nrow,o,t,code=TCL_ERROR;
+   int     *level=NULL,*flag=NULL;
+   double  *factor=NULL,val;
+
+   if (!(frac=Data_Get(Tcl_GetString(Objv[2])))) {
+      Tcl_AppendResult(Interp,"Invalid field ",Tcl_GetString(Objv[2]),(char*)NULL);
+      return(TCL_ERROR);
+   }
+   if (Tcl_GetCharLength(Objv[3]) && !(mask=Data_Get(Tcl_GetString(Objv[3])))) {
+      Tcl_AppendResult(Interp,"Invalid field ",Tcl_GetString(Objv[3]),(char*)NULL);
+      return(TCL_ERROR);
+   }
+   if (Tcl_GetCharLength(Objv[4]) && !(area=Data_Get(Tcl_GetString(Objv[4])))) {
+      Tcl_AppendResult(Interp,"Invalid field ",Tcl_GetString(Objv[4]),(char*)NULL);
+      return(TCL_ERROR);
+   }
+
+   if (Tcl_ListObjGetElements(Interp,Objv[5],&nout,&lobj)!=TCL_OK || Tcl_ListObjLength(Interp,Objv[6],&ntype)!=TCL_OK) {
+      return(TCL_ERROR);
+   }
+
+   out=(TData**)malloc(nout*sizeof(TData*));
+   flag=(int*)calloc(nout,sizeof(int));
+   level=(int*)malloc(ntype*sizeof(int));
+   factor=(double*)malloc(ntype*nout*sizeof(double));
+   if (!out || !flag || !level || !factor) {
+      Tcl_AppendResult(Interp,"Unable to allocate emission tables",(char*)NULL);
+      goto end;
+   }
+
+   for(o=0;o<nout;o++) {
+      if (!(out[o]=Data_Get(Tcl_GetString(lobj[o])))) {
+         Tcl_AppendResult(Interp,"Invalid field ",Tcl_GetString(lobj[o]),(char*)NULL);
+         goto end;
+      }
+   }
+
+   // Factor rows
+   for(t=0;t<ntype;t++) {
+      if (Tcl_ListObjIndex(Interp,Objv[6],t,&robj)!=TCL_OK || !robj) {
+         goto end;
+      }
+      if (Tcl_ListObjGetElements(Interp,robj,&nrow,&lobj)!=TCL_OK || nrow!=nout+1) {
+         Tcl_AppendResult(Interp,"Invalid factors row, must be {level factor_1 ... factor_n}",(char*)NULL);
+         goto end;
+      }
+      if (Tcl_GetIntFromObj(Interp,lobj[0],&level[t])!=TCL_OK) {
+         goto end;
+      }
+      for(o=0;o<nout;o++) {
+         if (Tcl_GetDoubleFromObj(Interp,lobj[o+1],&val)!=TCL_OK) {
+            goto end;
+         }
+         factor[t*nout+o]=val;
+      }
+   }
+
+   // Area multiplication flags (none if empty)
+   if (Tcl_ListObjGetElements(Interp,Objv[7],&nflag,&lobj)!=TCL_OK) {
+      goto end;
+   }
+   if (nflag && nflag!=nout) {
+      Tcl_AppendResult(Interp,"Invalid area flags, must be empty or hold one flag per output",(char*)NULL);
+      goto end;
+   }
+   for(o=0;o<nflag;o++) {
+      if (Tcl_GetBooleanFromObj(Interp,lobj[o],&flag[o])!=TCL_OK) {
+         goto end;
+      }
+   }
+
+   code=GeoPhy_EmissionKernel(Interp,frac,mask,area,out,nout,level,factor,ntype,flag);
+
+end:
+   free(out);
+   free(flag);
+   free(level);
+   free(factor);
+
+   return(code);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <GeoPhy_RasterAverageCmd>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Decode the arguments of the rasteraverage command and call the kernel.
+ *
+ * Parametres     :
+ *  <Interp>      : Interpreteur TCL.
+ *  <Objc>        : Nombre d'arguments
+ *  <Objv>        : Liste des arguments (outputs files nodata ?limits? ?tilesize?)
+ *
+ * Retour:
+ *  <TCL_...> : Code d'erreur de TCL.
+ *
+ * Remarques :
+ *   - Empty limits means the whole rasters
+ *----------------------------------------------------------------------------
+*/
+static int GeoPhy_RasterAverageCmd(Tcl_Interp *Interp,int Objc,Tcl_Obj *CONST Objv[]) {
+
+   TData   **out=NULL;
+   Tcl_Obj **lobj;
+   int       nout,nobj,o,limits[4],*lim=NULL,tile=1024,code=TCL_ERROR;
+   double    nodata;
+
+   if (Tcl_ListObjGetElements(Interp,Objv[2],&nout,&lobj)!=TCL_OK || Tcl_GetDoubleFromObj(Interp,Objv[4],&nodata)!=TCL_OK) {
+      return(TCL_ERROR);
+   }
+
+   if (!(out=(TData**)malloc(nout*sizeof(TData*)))) {
+      Tcl_AppendResult(Interp,"Unable to allocate output field table",(char*)NULL);
+      return(TCL_ERROR);
+   }
+   for(o=0;o<nout;o++) {
+      out[o]=Data_Get(Tcl_GetString(lobj[o]));
+   }
+
+   if (Objc>5 && Tcl_GetCharLength(Objv[5])) {
+      if (Tcl_ListObjGetElements(Interp,Objv[5],&nobj,&lobj)!=TCL_OK || nobj!=4) {
+         Tcl_AppendResult(Interp,"Invalid limits, must be {x0 y0 x1 y1}",(char*)NULL);
+         goto end;
+      }
+      for(o=0;o<4;o++) {
+         if (Tcl_GetIntFromObj(Interp,lobj[o],&limits[o])!=TCL_OK) {
+            goto end;
+         }
+      }
+      lim=limits;
+   }
+   if (Objc>6 && (Tcl_GetIntFromObj(Interp,Objv[6],&tile)!=TCL_OK || tile<=0)) {
+      Tcl_AppendResult(Interp,"Invalid tile size",(char*)NULL);
+      goto end;
+   }
+
+   code=GeoPhy_RasterAverage(Interp,out,nout,Objv[3],nodata,lim,tile);
+
+end:
+   free(out);
+
+   return(code);
+}
+
 /*----------------------------------------------------------------------------
  * Nom      : <System_Cmd>
  * Creation : Mai 2009 - J.P. Gauthier - CMC/CMOE
@@ -77,17 +436,27 @@ int Tclgeophy_Init(Tcl_Interp *Interp) {
  *  <TCL_...> : Code d'erreur de TCL.
  *
  * Remarques :
- *
+ *   - Field lists must only hold known field names, an unknown name is an error
+ *   - The settings array is decoded once by GeoPhy_SettingsGet, a value of the wrong
+ *     type (ie: TOPO_DGFMS_L "maybe", LPASSFLT_P 2.5) or a TOPO_VEGE_RUGV without 26
+ *     values is now an error where it used to be silently ignored
  *----------------------------------------------------------------------------
 */
 
 static int GeoPhy_Cmd(ClientData clientData,Tcl_Interp *Interp,int Objc,Tcl_Obj *CONST Objv[]){
 
-   int   idx;
-   TData  *topo,*vege,*zz,*lh,*dh,*hx2,*hy2,*hxy;
+   int   idx,n,nobj,merge,nthread;
+   double tol,nodata,limits[4],*lim;
+   float  err;
+   TData  *topo,*mask,**fld,*drain[3];
+   TGeoPhySub *sub;
+   TGeoPhySet  set;
+   Tcl_Obj    *obj,**lobj;
    
-   static CONST char *sopt[] = { "zfilter","subgrid_legacy","lpass_filter", NULL };
-   enum               opt { ZFILTER,SUBGRID_LEGACY,LPASS_FILTER };
+   static CONST char *sopt[] = { "zfilter","subgrid_legacy","subgrid_pack","subgrid_free","lpass_filter","draindensity","emissions","demoverview","rasteraverage", NULL };
+   enum               opt { ZFILTER,SUBGRID_LEGACY,SUBGRID_PACK,SUBGRID_FREE,LPASS_FILTER,DRAINDENSITY,EMISSIONS,DEMOVERVIEW,RASTERAVERAGE };
+   static CONST char *sdrain[] = { "-limits","-threads","-max", NULL };
+   enum               drain { LIMITS,THREADS,MAX };
 
    Tcl_ResetResult(Interp);
 
@@ -103,45 +472,149 @@ static int GeoPhy_Cmd(ClientData clientData,Tcl_Interp *Interp,int Objc,Tcl_Obj
    switch ((enum opt)idx) {
       case ZFILTER:
          if(Objc!=4) {
-            Tcl_WrongNumArgs(Interp,2,Objv,"field settings");
+            Tcl_WrongNumArgs(Interp,2,Objv,"fields settings");
+            return(TCL_ERROR);
+         }
+         if (GeoPhy_SettingsGet(Interp,Objv[3],&set)!=TCL_OK || !(fld=GeoPhy_DataList(Interp,Objv[2],&nobj))) {
             return(TCL_ERROR);
          }
-         topo=Data_Get(Tcl_GetString(Objv[2]));
-         
-         return(GeoPhy_ZFilterTopo(Interp,topo,Objv[3]));
+         n=GeoPhy_ZFilterTopo(Interp,fld,nobj,&set);
+         free(fld);
+         return(n);
          break;
 
       case SUBGRID_LEGACY:
-         if(Objc<10) {
+         if(Objc!=10 && Objc!=11) {
             Tcl_WrongNumArgs(Interp,2,Objv,"topo vege zz lh dh hx2 hy2 hxy ?settings?");
             return(TCL_ERROR);
          }
-         topo=Data_Get(Tcl_GetString(Objv[2]));
-         vege=Data_Get(Tcl_GetString(Objv[3]));
-         zz=Data_Get(Tcl_GetString(Objv[4]));
-         lh=Data_Get(Tcl_GetString(Objv[5]));
-         dh=Data_Get(Tcl_GetString(Objv[6]));
-         hx2=Data_Get(Tcl_GetString(Objv[7]));
-         hy2=Data_Get(Tcl_GetString(Objv[8]));
-         hxy=Data_Get(Tcl_GetString(Objv[9]));
-         
-         if(Objc==11)
-            return(GeoPhy_SubGridLegacy(Interp,topo,vege,zz,lh,dh,hx2,hy2,hxy,Objv[10]));
-         else
-            return(GeoPhy_SubGridLegacy(Interp,topo,vege,zz,lh,dh,hx2,hy2,hxy,NULL));
+         return(GeoPhy_SubGridCmd(Interp,Objc,Objv));
+         break;
+
+      case SUBGRID_PACK:
+         if(Objc!=4) {
+            Tcl_WrongNumArgs(Interp,2,Objv,"topo tolerance");
+            return(TCL_ERROR);
+         }
+         if (!(topo=Data_Get(Tcl_GetString(Objv[2])))) {
+            Tcl_AppendResult(Interp,"Invalid topographic field",(char*)NULL);
+            return(TCL_ERROR);   
+         }
+         if (Tcl_GetDoubleFromObj(Interp,Objv[3],&tol)!=TCL_OK) {
+            return(TCL_ERROR);
+         }
+         if ((sub=GeoPhy_SubPack(topo->Def,tol,&err))) {
+            GeoPhy_SubPut(Tcl_GetString(Objv[2]),sub);
+         }
+
+         // Return packing status and maximum quantization error
+         obj=Tcl_NewListObj(0,NULL);
+         Tcl_ListObjAppendElement(Interp,obj,Tcl_NewBooleanObj(sub!=NULL));
+         Tcl_ListObjAppendElement(Interp,obj,Tcl_NewDoubleObj(err));
+         Tcl_SetObjResult(Interp,obj);
+         break;
+
+      case SUBGRID_FREE:
+         if(Objc!=3) {
+            Tcl_WrongNumArgs(Interp,2,Objv,"topo");
+            return(TCL_ERROR);
+         }
+         GeoPhy_SubPut(Tcl_GetString(Objv[2]),NULL);
          break;
 
       case LPASS_FILTER:
          if((Objc!=4)&&(Objc!=5)) {
-            Tcl_WrongNumArgs(Interp,2,Objv,"me_field settings ?mask_field?");
+            Tcl_WrongNumArgs(Interp,2,Objv,"me_fields settings ?mask_field?");
+            return(TCL_ERROR);
+         }
+         mask=Objc==5?Data_Get(Tcl_GetString(Objv[4])):NULL;
+         if (GeoPhy_SettingsGet(Interp,Objv[3],&set)!=TCL_OK || !(fld=GeoPhy_DataList(Interp,Objv[2],&nobj))) {
+            return(TCL_ERROR);
+         }
+         n=GeoPhy_LPassFilter(Interp,fld,nobj,&set,mask);
+         free(fld);
+         return(n);
+         break;
+
+      case DRAINDENSITY:
+         if(Objc<7) {
+            Tcl_WrongNumArgs(Interp,2,Objv,"rsum lsum lare rivers lakes ?-limits {la0 lo0 la1 lo1}? ?-threads nb? ?-max?");
+            return(TCL_ERROR);
+         }
+         lim=NULL;
+         merge=GEOPHY_MERGE_ADD;
+         nthread=0;
+
+         for(n=7;n<Objc;n++) {
+            if (Tcl_GetIndexFromObj(Interp,Objv[n],sdrain,"option",0,&idx)!=TCL_OK) {
+               return(TCL_ERROR);
+            }
+            switch ((enum drain)idx) {
+               case LIMITS:
+                  if (++n==Objc || Tcl_ListObjGetElements(Interp,Objv[n],&nobj,&lobj)!=TCL_OK || nobj!=4) {
+                     Tcl_AppendResult(Interp,"Invalid limits, must be {la0 lo0 la1 lo1}",(char*)NULL);
+                     return(TCL_ERROR);
+                  }
+                  for(idx=0;idx<4;idx++) {
+                     if (Tcl_GetDoubleFromObj(Interp,lobj[idx],&limits[idx])!=TCL_OK) {
+                        return(TCL_ERROR);
+                     }
+                  }
+                  lim=limits;
+                  break;
+
+               case THREADS:
+                  if (++n==Objc || Tcl_GetIntFromObj(Interp,Objv[n],&nthread)!=TCL_OK) {
+                     Tcl_AppendResult(Interp,"Invalid number of threads",(char*)NULL);
+                     return(TCL_ERROR);
+                  }
+                  break;
+
+               case MAX:
+                  merge=GEOPHY_MERGE_MAX;
+                  break;
+            }
+         }
+
+         // Empty field names are not accumulated
+         for(n=0;n<3;n++) {
+            drain[n]=NULL;
+            if (Tcl_GetCharLength(Objv[2+n]) && !(drain[n]=Data_Get(Tcl_GetString(Objv[2+n])))) {
+               Tcl_AppendResult(Interp,"Invalid field ",Tcl_GetString(Objv[2+n]),(char*)NULL);
+               return(TCL_ERROR);
+            }
+         }
+         return(GeoPhy_DrainDensity(Interp,drain[0],drain[1],drain[2],Objv[5],Objv[6],lim,merge,nthread));
+         break;
+
+      case EMISSIONS:
+         if(Objc!=8) {
+            Tcl_WrongNumArgs(Interp,2,Objv,"fractions mask area outputs factors areaflags");
+            return(TCL_ERROR);
+         }
+         return(GeoPhy_EmissionCmd(Interp,Objv));
+         break;
+
+      case DEMOVERVIEW:
+         if(Objc!=4 && Objc!=5) {
+            Tcl_WrongNumArgs(Interp,2,Objv,"tile overview ?nodata?");
+            return(TCL_ERROR);
+         }
+         if (Objc==5) {
+            if (Tcl_GetDoubleFromObj(Interp,Objv[4],&nodata)!=TCL_OK) {
+               return(TCL_ERROR);
+            }
+            return(GeoPhy_DEMOverview(Interp,Tcl_GetString(Objv[2]),Tcl_GetString(Objv[3]),&nodata));
+         }
+         return(GeoPhy_DEMOverview(Interp,Tcl_GetString(Objv[2]),Tcl_GetString(Objv[3]),NULL));
+         break;
+
+      case RASTERAVERAGE:
+         if(Objc!=5 && Objc!=6 && Objc!=7) {
+            Tcl_WrongNumArgs(Interp,2,Objv,"outputs files nodata ?{x0 y0 x1 y1}? ?tilesize?");
             return(TCL_ERROR);
-         } else {
-            TData *mask=NULL;
-            topo=Data_Get(Tcl_GetString(Objv[2]));
-            if (Objc == 5)
-               mask=Data_Get(Tcl_GetString(Objv[4]));
-            return(GeoPhy_LPassFilter(Interp,topo,Objv[3],mask));
          }
+         return(GeoPhy_RasterAverageCmd(Interp,Objc,Objv));
          break;
    }
    return(TCL_OK);
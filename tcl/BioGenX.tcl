@@ -44,6 +44,10 @@ namespace eval BioGenX { } {
 
    set Param(VegtypeNomVar) VB
 
+   #----- Emission fields accumulated by the native emission kernel and which of them are scaled by the cell area
+   set Param(EmissList)     [list BGXISOP BGXMONO BGXVOC BGXNO BGXISOW BGXMONW BGXVOCW BGXNOW BGXLAI BGXVCHK ]
+   set Param(EmissArea)     [list 1       1       1      1     1       1       1       1      0      0       ]
+
    set Param(ToleranceVCHK) 0.0001
    set Param(ecartmaxVCHK) [expr 1.0 + $Param(ToleranceVCHK)]
    set Param(ecartminVCHK) [expr 1.0 - $Param(ToleranceVCHK)]
@@ -89,7 +93,7 @@ proc BioGenX::LULC_15Classes { Grid } {
    Log::Print INFO "Generating 15 category land-use classification"
 
    #----- Recuperation du champ VF
-   if { [catch { fstdfield read BGXVF GPXOUTFILE -1 "" -1 -1 -1 "" "VF" } ] } {
+   if { [catch { GenX::FieldRead BGXVF GPXOUTFILE -1 "" -1 -1 -1 "" "VF" } ] } {
       Log::Print ERROR "Calculating 15 category LULC requires use of -vege option"
       Log::End 1
    }
@@ -124,7 +128,7 @@ proc BioGenX::LULC_15Classes { Grid } {
    vexpr BGXLU BGXLU()()(14) = BGXVF()()(20)
 
    fstdfield define BGXLU -ETIKET LULC-GRAHM -TYPVAR "C"
-   fstdfield write BGXLU GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite BGXLU GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    fstdfield free BGXLU BGXCFRAC BGXTFRAC
 }
@@ -175,7 +179,7 @@ proc BioGenX::TrFractions_15Classes { Grid } {
    fstdfield copy  BGXCFRAC $Grid
 
    #----- Recuperation du champ LULC
-   if { [catch { fstdfield read BGXLU GPXAUXFILE -1 "" -1 -1 -1 "" "LU15" } ] } {
+   if { [catch { GenX::FieldRead BGXLU GPXAUXFILE -1 "" -1 -1 -1 "" "LU15" } ] } {
       Log::Print ERROR "Calculating 15-category Transport fraction requires call to BioGenX::LULC_15Classes"
       Log::End 1
    }
@@ -187,7 +191,7 @@ proc BioGenX::TrFractions_15Classes { Grid } {
    vexpr BGXTFRAC 1.0 - BGXCFRAC
 
    fstdfield define BGXTFRAC -NOMVAR TFRC -ETIKET "TR FRAC 15" -TYPVAR "C"
-   fstdfield write BGXTFRAC GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite BGXTFRAC GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    fstdfield free BGXTFRAC BGXCFRAC BGXLU
 }
@@ -216,7 +220,7 @@ proc BioGenX::TrFractions_26Classes { Grid } {
    fstdfield copy  BGXCFRAC $Grid
 
    #----- Recuperation du champ VF
-   if { [catch { fstdfield read BGXVF GPXOUTFILE -1 "" -1 -1 -1 "" "VF" } ] } {
+   if { [catch { GenX::FieldRead BGXVF GPXOUTFILE -1 "" -1 -1 -1 "" "VF" } ] } {
       Log::Print ERROR "Calculating 26-category Transport fraction requires use of -vege and -check options."
       Log::End 1
    }
@@ -228,7 +232,7 @@ proc BioGenX::TrFractions_26Classes { Grid } {
    vexpr BGXTFRAC 1.0 - BGXCFRAC
 
    fstdfield define BGXTFRAC -NOMVAR TFRC -ETIKET "TR FRAC 26" -TYPVAR "C"
-   fstdfield write BGXTFRAC GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite BGXTFRAC GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    fstdfield free BGXTFRAC BGXCFRAC BGXVF
 }
@@ -372,7 +376,7 @@ proc BioGenX::StateField { Grid } {
    GenX::GridClear $Grid -1.0
    fstdfield copy BGXST $Grid
    fstdfield define BGXST -NOMVAR "ST" -ETIKET "DUMMY"
-   fstdfield write BGXST GPXOUTFILE -12 True $GenX::Param(Compress)
+   GenX::FieldWrite BGXST GPXOUTFILE -12 True $GenX::Param(Compress)
 }
 
 #-------------------------------------------------------------------------------
@@ -415,11 +419,11 @@ proc BioGenX::CalcEmissions { Grid  } {
    #----- Save output
    foreach field $BioGenX::Param(FieldList) varname $BioGenX::Param(NameList) season $BioGenX::Param(NameList) fichier $BioGenX::Param(FileOut) {
       fstdfield define BGX$field -ETIKET "EMISSIONS" -TYPVAR $season -NOMVAR $varname -IP1 0
-      fstdfield write BGX$field GPX${fichier}FILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite BGX$field GPX${fichier}FILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    }
    #----- Save merge mask for different databases
    fstdfield define BGXRMS -NOMVAR BRMS -IP1 1200
-   fstdfield write BGXRMS GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite BGXRMS GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    #----- Free output fields
    foreach field $BioGenX::Param(FieldList) {
@@ -454,7 +458,7 @@ proc BioGenX::CalcEmissionsVF { Grid } {
    BioGenX::ReadEmissfacFile $GenX::Param(DBase)/$GenX::Path(BELD3)/Factors/$BioGenX::Path(VFFactors)
 
    #----- Recuperation du champ VF
-   if { [catch { fstdfield read BGXVF GPXOUTFILE -1 "" -1 -1 -1 "" "VF" } ] } {
+   if { [catch { GenX::FieldRead BGXVF GPXOUTFILE -1 "" -1 -1 -1 "" "VF" } ] } {
       Log::Print ERROR "Calculating emissions from USGS DB requires use of -vege option"
       Log::End 1
    }
@@ -469,39 +473,21 @@ proc BioGenX::CalcEmissionsVF { Grid } {
    set vo_cst [expr $Const(C2ovoc) * $Const(Mug2g) * $Const(H2s)]
    set no_cst [expr $Const(C2no)   * $Const(Mug2g) * $Const(H2s)]
 
-   #----- Calcul des concentrations finales des emissions biogeniques...
+   #----- Table des facteurs d'emission par type de vegetation (niveau du cube VF)
+   #----- ete, hiver, Leaf Area Index et champ de verification des index
+   set factors {}
    foreach k $GeoPhysX::Param(VegeTypes) {
-
-      #----- Extraire la fraction dans un champ temporaire
-      vexpr BGXTMP BGXVF()()([expr $k-1])
-
-      #----- Masquer la zone a ne pas travailler
-      vexpr BGXTMP ifelse(BGXRMS==1.0,0.0,BGXTMP)
-
-      #----- ...pour la saison d'ete
-      eval "vexpr BGXISOP BGXISOP+$ef1($k)*BGXTMP*$io_cst*BGXAREA"
-      eval "vexpr BGXMONO BGXMONO+$ef2($k)*BGXTMP*$mo_cst*BGXAREA"
-      eval "vexpr BGXVOC   BGXVOC+$ef3($k)*BGXTMP*$vo_cst*BGXAREA"
-      eval "vexpr BGXNO     BGXNO+$ef4($k)*BGXTMP*$no_cst*BGXAREA"
-
-      #----- ...pour la saison d'hiver
-      eval "vexpr BGXISOW BGXISOW+$ef1($k)*BGXTMP*$winterfact($k)*$io_cst*BGXAREA"
-      eval "vexpr BGXMONW BGXMONW+$ef2($k)*BGXTMP*$winterfact($k)*$mo_cst*BGXAREA"
-      eval "vexpr BGXVOCW BGXVOCW+$ef3($k)*BGXTMP*$winterfact($k)*$vo_cst*BGXAREA"
-      eval "vexpr BGXNOW   BGXNOW+$ef4($k)*BGXTMP*$winterfact($k)*$no_cst*BGXAREA"
-
-      #----- Calcul du Leaf Area Index
-      eval "vexpr BGXLAI   BGXLAI+BGXTMP*$leafarea($k)"
-
-      #----- Calcul du champ de verification des index
-      #----- Le total du champ doit donner 1 partout.
-      vexpr BGXVCHK BGXVCHK+BGXTMP
+      lappend factors [list [expr $k-1] \
+         [expr $ef1($k)*$io_cst] [expr $ef2($k)*$mo_cst] [expr $ef3($k)*$vo_cst] [expr $ef4($k)*$no_cst] \
+         [expr $ef1($k)*$winterfact($k)*$io_cst] [expr $ef2($k)*$winterfact($k)*$mo_cst] [expr $ef3($k)*$winterfact($k)*$vo_cst] [expr $ef4($k)*$winterfact($k)*$no_cst] \
+         $leafarea($k) 1.0]
    }
 
-   vexpr BGXAREA ifelse(BGXRMS,0.0,BGXAREA)
+   #----- Calcul des concentrations finales des emissions biogeniques en une seule passe,
+   #----- la zone a ne pas travailler (BGXRMS==1.0) etant masquee
+   geophy emissions BGXVF BGXRMS BGXAREA $Param(EmissList) $factors $Param(EmissArea)
 
-   #----- Liberer l'espace memoire des champs temporaires
-   fstdfield free BGXTMP
+   vexpr BGXAREA ifelse(BGXRMS,0.0,BGXAREA)
 }
 
 #-------------------------------------------------------------------------------
@@ -595,29 +581,16 @@ proc BioGenX::CalcEmissionsBELD { Grid } {
          Log::Print DEBUG "On fait $file"
          #----- Ecrire le champ VG
          fstdfield define $Grid -ETIKET [format %04i $k] -NOMVAR $nomvarVG
-         fstdfield write $Grid GPX${fichier}FILE -32 True
+         GenX::FieldWrite $Grid GPX${fichier}FILE -32 True
       } else {
 
-         #----- Calcul des concentrations finales des emissions biogeniques...
-
-         #----- ...pour la saison d'ete
-         eval "vexpr BGXISOP BGXISOP+$ef1($k)*$Grid"
-         eval "vexpr BGXMONO BGXMONO+$ef2($k)*$Grid"
-         eval "vexpr BGXVOC   BGXVOC+$ef3($k)*$Grid"
-         eval "vexpr BGXNO     BGXNO+$ef4($k)*$Grid"
-
-         #----- ...pour la saison d'hiver
-         eval "vexpr BGXISOW BGXISOW+$ef1($k)*$Grid*$winterfact($k)"
-         eval "vexpr BGXMONW BGXMONW+$ef2($k)*$Grid*$winterfact($k)"
-         eval "vexpr BGXVOCW BGXVOCW+$ef3($k)*$Grid*$winterfact($k)"
-         eval "vexpr BGXNOW   BGXNOW+$ef4($k)*$Grid*$winterfact($k)"
-
-         #----- Calcul du Leaf Area Index
-         eval "vexpr BGXLAI   BGXLAI+$Grid*$leafarea($k)"
-
-         #----- Calcul du champ de verification des index
-         #----- Le total du champ doit donner 1 partout.
-         vexpr BGXVCHK BGXVCHK+$Grid
+         #----- Calcul des concentrations finales des emissions biogeniques en une seule passe
+         #----- (ete, hiver, Leaf Area Index et champ de verification des index),
+         #----- les constantes et l'aire etant appliquees a la fin
+         set factors [list [list 0 $ef1($k) $ef2($k) $ef3($k) $ef4($k) \
+            [expr $ef1($k)*$winterfact($k)] [expr $ef2($k)*$winterfact($k)] [expr $ef3($k)*$winterfact($k)] [expr $ef4($k)*$winterfact($k)] \
+            $leafarea($k) 1.0]]
+         geophy emissions $Grid "" "" $Param(EmissList) $factors {}
       }
       #----- Nettoyer  0 le champ Grid pour eviter que les interpolations
       #----- AVERAGE et autres ne moyennent les champs d'une fois a l'autre
@@ -629,7 +602,7 @@ proc BioGenX::CalcEmissionsBELD { Grid } {
       Log::Print DEBUG "On ecrit VCHK"
       #----- Ecrire le champ VG
       fstdfield define BGXVCHK -ETIKET "$Param(TagBeld3)" -NOMVAR "VCHK"
-      fstdfield write BGXVCHK GPXAUXFILE -32 True
+      GenX::FieldWrite BGXVCHK GPXAUXFILE -32 True
 
    } else {
       #----- Fin du calcul des emissions biogeniques
@@ -682,7 +655,7 @@ proc BioGenX::AURAMSBiogFromVF { Grid } {
    #----- Creeer les champs vides pour les types de sols non-prsents dans la BD
    for { set j 3 } { $j <= 233 } { incr j 1 } {
       fstdfield define $Grid -ETIKET [format %04i $j] -NOMVAR $nomvarVG
-      fstdfield write $Grid GPXAUXFILE -32 True
+      GenX::FieldWrite $Grid GPXAUXFILE -32 True
    }
 
    #----- Mapping many-to-one VF fields to BELD3 categories
@@ -709,12 +682,12 @@ proc BioGenX::AURAMSBiogFromVF { Grid } {
       foreach level $levels {
          Log::Print DEBUG "   BioGenX::AURAMSBiogFromVF Mapping VF $level to BELD3 [format %04i $etik]"
          set ip1 [ expr 1200 - $level ]
-         fstdfield read VGTEMP GPXOUTFILE -1 "" $ip1 -1 -1 "" "VF"
+         GenX::FieldRead VGTEMP GPXOUTFILE -1 "" $ip1 -1 -1 "" "VF"
          vexpr SUM SUM + VGTEMP
       }
 
       fstdfield define SUM -ETIKET [format %04i $etik] -NOMVAR $nomvarVG -TYPVAR "C"
-      fstdfield write SUM GPXAUXFILE -32 True
+      GenX::FieldWrite SUM GPXAUXFILE -32 True
 
    }
 
@@ -753,19 +726,19 @@ proc BioGenX::MergeAurams { Grid } {
 
    #----- Obtenir le champs VCHK
    Log::Print DEBUG "   BioGenX::MergeAurams Read VCHK field"
-   fstdfield read BGXVCHK_B GPXAUXFILE -1 "$Param(TagBeld3)" -1 -1 -1 "" "VCHK"
+   GenX::FieldRead BGXVCHK_B GPXAUXFILE -1 "$Param(TagBeld3)" -1 -1 -1 "" "VCHK"
 
    #----- Boucler sur tous les champ VG
    for { set j 3 } { $j <= 233 } { incr j 1 } {
 
       set etik [format %04i $j]
-      fstdfield read BELD GPXAUXFILE -1 "$etik" -1 -1 -1 "" "VG_B"
-      fstdfield read VF   GPXAUXFILE -1 "$etik" -1 -1 -1 "" "VG_F"
+      GenX::FieldRead BELD GPXAUXFILE -1 "$etik" -1 -1 -1 "" "VG_B"
+      GenX::FieldRead VF   GPXAUXFILE -1 "$etik" -1 -1 -1 "" "VG_F"
 
       vexpr VG_M ifelse((BGXVCHK_B >= $Param(ecartminVCHK)) && (BGXVCHK_B <= $Param(ecartmaxVCHK)), BELD, VF)
 
       fstdfield define VG_M -ETIKET $etik -NOMVAR $BioGenX::Param(VegtypeNomVar) -TYPVAR C
-      fstdfield write VG_M GPXOUTFILE 0 True
+      GenX::FieldWrite VG_M GPXOUTFILE 0 True
 
       fstdfield free VG_M
    }
@@ -0,0 +1,220 @@
+#============================================================================
+# Environnement Canada
+# Centre Meteorologique Canadien
+# 2121 Trans-Canadienne
+# Dorval, Quebec
+#
+# Project    : Generateur de champs geophysiques.
+# File       : GenDEMPyramid.tcl
+# Creation   : Octobre 2026 - CMC/CMDS
+# Description: Build the DEM overview pyramid used by GenPhysX on coarse grids
+#
+# Parameters   :
+#   <DB>       : DEM database among { SRTM30 SRTM90 CDEM FABDEM }
+#   <Levels>   : Number of overview levels (Default GenX::Param(PyramidLevels))
+#   <Force>    : Rebuild existing overviews (Default False)
+#
+# Remarks  :
+#   - Level L of a tile is written to $GenX::Path(Pyramid)/L<L>/<tile path relative to
+#     the database root>.tif, with 3 bands: mean, mean-square and sample count
+#   - Each level is built from the previous one, counts weight the averages by the samples
+#     they hold, but the overview blocks only approximate the grid cells at their edges
+#   - Overviews older than their tile are rebuilt, a .lock file created exclusively lets
+#     several instances work concurrently on the same database
+#   - A lock left by a dead process (same host) or older than Param(LockAge) is ignored
+#============================================================================
+
+source $env(GENPHYSX_PATH)/tcl/GenX.tcl
+source $env(GENPHYSX_PATH)/tcl/GeoPhysX.tcl
+
+namespace eval GenDEMPyramid { } {
+   variable Param
+
+   set Param(DBs)    { SRTM30 SRTM90 CDEM FABDEM }
+   set Param(NoData) { -32768 -32768 -32767 "" }      ;# Tile nodata, "" to use the one in the file
+   set Param(LockAge) 3600                            ;# Age (s) after which a tile lock is considered stale
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GenDEMPyramid::Files>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Get the tiles of a DEM database.
+#
+# Parameters :
+#   <DB>     : DEM database
+#
+# Return:
+#   <Files>  : List of tiles
+#
+# Remarks :
+#
+#----------------------------------------------------------------------------
+proc GenDEMPyramid::Files { DB } {
+
+   set dbase $GenX::Param(DBase)
+
+   switch $DB {
+      "SRTM30" { return [glob -nocomplain $dbase/$GenX::Path(SRTM30)/UNIT_*/*.TIF] }
+      "SRTM90" { return [glob -nocomplain $dbase/$GenX::Path(SRTM90)/srtm_*.TIF] }
+      "CDEM"   { return [glob -nocomplain $dbase/$GenX::Path(CDEM)/*/cdem_dem_*.tif] }
+      "FABDEM" { set dbdir $dbase/$GenX::Path(FABDEM)
+                 set files {}
+                 set layer [lindex [ogrfile open PYRINDEXFILE read $dbdir/Index/Index.shp] 0]
+                 eval ogrlayer read PYRINDEXLAYER $layer
+                 for { set id 0 } { $id<[ogrlayer define PYRINDEXLAYER -nb] } { incr id } {
+                    lappend files $dbdir/[ogrlayer define PYRINDEXLAYER -feature $id IDX_PATH]
+                 }
+                 ogrlayer free PYRINDEXLAYER
+                 ogrfile close PYRINDEXFILE
+                 return $files
+               }
+   }
+   return {}
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GenDEMPyramid::LockStale>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Check if a tile lock was left behind by a dead instance.
+#
+# Parameters :
+#   <Lock>   : Lock file
+#
+# Return:
+#   <Stale>  : True if the lock can be taken over
+#
+# Remarks :
+#   - Locks hold the host and pid of their owner
+#
+#----------------------------------------------------------------------------
+proc GenDEMPyramid::LockStale { Lock } {
+   variable Param
+
+   if { [expr [clock seconds]-[file mtime $Lock]]>$Param(LockAge) } {
+      return True
+   }
+
+   if { ![catch { set f [open $Lock r]; set owner [gets $f]; close $f }] && [llength $owner]==2 } {
+      if { [lindex $owner 0]==[info hostname] && ![file exists /proc/[lindex $owner 1]] } {
+         return True
+      }
+   }
+   return False
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GenDEMPyramid::LockTake>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Take the lock of a tile.
+#
+# Parameters :
+#   <Lock>   : Lock file
+#
+# Return:
+#   <Taken>  : True if the lock was taken, False if the tile is being processed
+#
+# Remarks :
+#   - The lock is created exclusively (O_EXCL) so only one instance can get it
+#   - A stale lock is removed and the creation tried once more, an instance
+#     taking it over at the same time gets it first
+#
+#----------------------------------------------------------------------------
+proc GenDEMPyramid::LockTake { Lock } {
+
+   file mkdir [file dirname $Lock]
+
+   for { set try 0 } { $try<2 } { incr try } {
+      if { ![catch { set f [open $Lock {WRONLY CREAT EXCL}] }] } {
+         puts $f [list [info hostname] [pid]]
+         close $f
+         return True
+      }
+      if { $try || ![file exists $Lock] || ![GenDEMPyramid::LockStale $Lock] } {
+         break
+      }
+      Log::Print WARNING "   Taking over stale lock $Lock"
+      file delete -force $Lock
+   }
+   return False
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GenDEMPyramid::Process>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Build the overview levels of every tile of a DEM database.
+#
+# Parameters :
+#   <DB>     : DEM database
+#   <Levels> : Number of overview levels
+#   <Force>  : Rebuild existing overviews
+#
+# Return:
+#
+# Remarks :
+#
+#----------------------------------------------------------------------------
+proc GenDEMPyramid::Process { DB Levels Force } {
+   variable Param
+
+   if { [set idx [lsearch -exact $Param(DBs) $DB]]==-1 } {
+      Log::Print ERROR "Invalid DEM database $DB, must be one of { $Param(DBs) }"
+      Log::End 1
+   }
+   set nodata [lindex $Param(NoData) $idx]
+
+   set files [GenDEMPyramid::Files $DB]
+   set nb    [llength $files]
+   Log::Print INFO "Building $Levels overview levels for $nb $DB tiles"
+
+   set n 0
+   foreach file $files {
+      Log::Print DEBUG "   Processing tile ([incr n]/$nb) $file"
+
+      set lock [GeoPhysX::PyramidFile $file 1].lock
+      if { ![GenDEMPyramid::LockTake $lock] } {
+         Log::Print INFO "   Tile $file is being processed"
+         continue
+      }
+
+      set in $file
+      for { set l 1 } { $l<=$Levels } { incr l } {
+         set out [GeoPhysX::PyramidFile $file $l]
+
+         if { $Force || ![file exists $out] || [file mtime $out]<[file mtime $in] } {
+            file mkdir [file dirname $out]
+            if { [catch { if { $l==1 && $nodata!="" } { geophy demoverview $in $out $nodata } else { geophy demoverview $in $out } } msg] } {
+               Log::Print ERROR "Could not build overview level $l of $file:\n\n\t$msg"
+               file delete -force $out
+               break
+            }
+         }
+         set in $out
+      }
+      file delete -force $lock
+   }
+   Log::Print INFO "Overviews available under $GenX::Param(DBase)/$GenX::Path(Pyramid)"
+}
+
+Log::Start GenDEMPyramid $GenX::Param(Version)$GenX::Param(VersionState)
+
+if { ![llength $argv] } {
+   Log::Print ERROR "Usage: GenDEMPyramid DB ?Levels? ?Force?\n\n\tDB among { $GenDEMPyramid::Param(DBs) }"
+   Log::End 1
+}
+
+set levels $GenX::Param(PyramidLevels)
+set force  False
+if { [llength $argv]>1 } {
+   set levels [lindex $argv 1]
+}
+if { [llength $argv]>2 } {
+   set force [lindex $argv 2]
+}
+
+GenDEMPyramid::Process [lindex $argv 0] $levels $force
+
+Log::End 0
@@ -74,6 +74,17 @@ source $env(GENPHYSX_PATH)/tcl/IndustrX.tcl
 
 Log::Start GenPhysX $GenX::Param(Version)$GenX::Param(VersionState)
 
+#----- Write the output fields pending in memory on any exit through Log::End,
+#      otherwise the fields already generated by the previous stages would be lost
+if { [info commands Log::End]=="" } {
+   auto_load Log::End
+}
+rename Log::End Log::EndNoFlush
+proc Log::End { args } {
+   catch { GenX::FieldFlush }
+   uplevel 1 Log::EndNoFlush $args
+}
+
 #----- Parse the arguments
 GenX::ParseCommandLine
 
@@ -81,12 +92,18 @@ GenX::ParseCommandLine
 fstdfile open GPXOUTFILE write $GenX::Param(OutFile)$GenX::Param(Process).fst
 fstdfile open GPXAUXFILE write $GenX::Param(OutFile)$GenX::Param(Process)_aux.fst
 
-proc ProcessCheck { Channel } {
+proc ProcessCheck { Channel Process } {
    global Param
 
    if { [eof $Channel] } {
-      close $Channel
+      #----- A failed grid process makes close raise, which would leave Param(Process) untouched
+      catch { close $Channel }
       incr Param(Process) -1
+
+      #----- If the first grid ended without publishing the topography mosaic, let the staggered ones stop waiting for it
+      if { $Process==0 && ![file exists $GenX::Param(OutFile)_topomosaic.fst] } {
+         close [open $GenX::Param(OutFile)_topomosaic.failed w]
+      }
    } else {
       puts [read -nonewline $Channel]
    }
@@ -104,6 +121,9 @@ if { [llength $grids]>1 } {
    set Param(Process) 0
    set Param(Done)    False
 
+   #----- Remove any topography mosaic left over from a previous run
+   file delete -force $GenX::Param(OutFile)_topomosaic.fst $GenX::Param(OutFile)_topomosaic.tmp $GenX::Param(OutFile)_topomosaic.failed
+
    foreach grid $grids {
       Log::Print INFO "Launching processing for grid #$Param(Process)"
 
@@ -112,7 +132,7 @@ if { [llength $grids]>1 } {
 
       set channel [open "|$env(GENPHYSX_PATH)/bin/GenPhysX $argv -process $Param(Process) 2>@1" r+]
       fconfigure $channel -blocking False -buffering line
-      fileevent $channel readable [list ProcessCheck $channel]
+      fileevent $channel readable [list ProcessCheck $channel $Param(Process)]
       incr Param(Process) 1
    }
 
@@ -137,11 +157,22 @@ if { [llength $grids]>1 } {
       }
       incr Param(Process) 1
    }
+   file delete -force $GenX::Param(OutFile)_topomosaic.fst $GenX::Param(OutFile)_topomosaic.failed
 } else {
-   GenX::Process $grids
-   GenX::MetaData $grids
+   #----- On failure, still write the output fields pending in memory so that what was generated is kept
+   if { [catch { GenX::Process $grids; GenX::MetaData $grids } msg] } {
+      set info $::errorInfo
+      catch { GenX::FieldFlush }
+      fstdfile close GPXOUTFILE
+      fstdfile close GPXAUXFILE
+      Log::Print ERROR "Processing failed:\n\n\t$info"
+      Log::End 1
+   }
 }
 
+#----- Write any output field still pending in memory
+GenX::FieldFlush
+
 fstdfile close GPXOUTFILE
 fstdfile close GPXAUXFILE
 
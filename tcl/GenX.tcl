@@ -28,8 +28,21 @@
 #   GenX::GridCopy           { SourceField DestField }
 #   GenX::GridCopyDesc       { Field FileIn FileOut }
 #   GenX::GridGet            { File }
-#   GenX::CacheGet           { File { NoData "" } }
+#   GenX::CacheGet           { File { NoData "" } { Band 0 } }
 #   GenX::CacheFree          { }
+#   GenX::FieldKey           { Id }
+#   GenX::FieldWrite         { Id File args }
+#   GenX::FieldDrop          { Reg }
+#   GenX::FieldFlush         { }
+#   GenX::FieldFind          { File DateV Etiket IP1 IP2 IP3 TV NV }
+#   GenX::FieldRead          { Id File args }
+#   GenX::GridHash           { Grid }
+#   GenX::Hash               { String }
+#   GenX::StageHash          { Name }
+#   GenX::Stage              { Name Script { Cache True } }
+#   GenX::StageReplay        { Name }
+#   GenX::StageSave          { File Params Procs Dbs }
+#   GenX::StageLoad          { File }
 #   GenX::ASTERGDEMFindFiles { Lat0 Lon0Lat1 Lon1 }
 #   GenX::CANVECFindFiles    { Lat0 Lon0 Lat1 Lon1 Layers }
 #   GenX::SRTMFindFiles      { Lat0 Lon0Lat1 Lon1 }
@@ -58,6 +71,55 @@ namespace eval GenX { } {
    variable Param
    variable Meta
    variable Batch
+   variable Fields
+   variable Stages
+
+   set Fields(List)     {}                     ;#Output fields kept in memory, oldest first
+   set Fields(Queue)    {}                     ;#Output fields pending write
+   set Fields(No)       0                      ;#Registry field counter
+   set Fields(Size)     0                      ;#Registry memory size in bytes
+   set Fields(Recording) False                 ;#Record the fields written by the current stage
+   set Fields(Record)   {}                     ;#Fields written by the current stage
+
+   #----- Processing stage inputs { upstream stages } { GenX parameters } { GEM settings patterns }
+   #      Upstream stages are those producing a field read by the stage (GenX::FieldRead/FieldFind)
+   set Stages(Params)           { Cell Target Compress NBits CappedNBits Interpolation DBase }
+   set Stages(Mask)             { {} { Mask FallbackMask Vege2Mask AddHydroLakesToMask } {} }
+   set Stages(Vege)             { {} { Vege UseVegeLUT Vege2Mask } {} }
+   set Stages(TreeCover)        { { Mask Vege } { TreeCover } {} }
+   set Stages(Topo)             { {} { Topo Sub TopoStag SubCompact SubCompactTol PyramidSamples PyramidLevels Z0Topo } {} }
+   set Stages(Bathy)            { { Mask Topo } { Bathy } {} }
+   set Stages(MaskVege)         { { Mask Vege } { Mask Vege UseVegeLUT } {} }
+   set Stages(Aspect)           { { Mask Topo MaskVege } { Aspect PyramidSamples PyramidLevels } {} }
+   set Stages(GeoMask)          { {} { GeoMask } {} }
+   set Stages(Soil)             { { Mask MaskVege } { Soil } {} }
+   set Stages(SoilDBRK)         { { Mask MaskVege } { SoilDBRK } {} }
+   set Stages(VCH)              { { Mask Vege MaskVege } { VCH Sub Z0NoTopo TOPO_ZVG2_TYPE } {} }
+   set Stages(Hydraulic)        { { Mask MaskVege Soil } { Hydraulic } {} }
+   set Stages(Check)            { { Mask Vege Topo Bathy MaskVege Soil SoilDBRK VCH Hydraulic } { Check } {} }
+   set Stages(CheckLegacy)      { { Mask Vege Topo MaskVege Check } { Sub } {} }
+   set Stages(TopoLow)          { { Topo } { Sub } {} }
+   set Stages(Gradient)         { { Topo } { Sub } {} }
+   set Stages(SubCorrection)    { { Mask Topo MaskVege TopoLow Gradient } { Sub } {} }
+   set Stages(SubLaunch)        { { Mask Topo MaskVege Check TopoLow Gradient SubCorrection } { Sub } {} }
+   set Stages(SubY789)          { { Mask Topo MaskVege Check Gradient SubCorrection SubLaunch } { Sub } {} }
+   set Stages(SubLaunchSplit)   { { Mask Topo MaskVege Check } { Sub } {} }
+   set Stages(SubY789Split)     { { Mask Topo MaskVege Check SubLaunchSplit } { Sub } {} }
+   set Stages(SubRoughness)     { { Mask Vege Topo MaskVege VCH Check CheckLegacy TopoLow Gradient SubCorrection SubLaunch SubY789 SubLaunchSplit SubY789Split }
+                                  { Sub Z0Topo Z0NoTopo Z0Filter MEFilterForZ0 CropZ0 TOPO_ZVG2_TYPE } { GRD_TYP_S TOPO_* } }
+   set Stages(SubTopoFilter)    { { Mask Topo Check SubLaunchSplit SubRoughness } { Sub MEFilter } { GRD_TYP_S TOPO_DGFMS_L TOPO_DGFMX_L TOPO_FILMX_L TOPO_CLIP_ORO_L LPASSFLT_* } }
+   set Stages(LegacySub)        { { Mask Vege Topo MaskVege VCH Check CheckLegacy TopoLow SubCorrection SubLaunchSplit SubRoughness SubTopoFilter }
+                                  { Sub Z0Topo Z0NoTopo Z0Filter MEFilterForZ0 TOPO_ZVG2_TYPE } { GRD_TYP_S TOPO_* } }
+   set Stages(Biogenic)         { { Mask Vege MaskVege Check } { Biogenic Target } {} }
+   set Stages(Hydro)            { { Mask Topo MaskVege Check } { Hydro } {} }
+   set Stages(Urban)            { { Mask Vege Topo MaskVege Check } { Urban } {} }
+   set Stages(EGMGH)            { {} { EGMGH } {} }
+
+   #----- In-memory objects left by a stage for the stages depending on it, a stage reused from
+   #      the cache is rerun to rebuild them before a stage depending on it is run (GenX::StageReplay)
+   set Stages(Topo,Memory)        { GPXME }   ;#Topography with its sub-grid samples
+   set Stages(CheckLegacy,Memory) { GPXME }   ;#Nodata and interpolation of the topography
+   set Stages(Order)              {}          ;#Stages in processing order
 
    set Param(Version)      2.6.5               ;#Application version
    set Param(VersionState) ""                  ;#Application state
@@ -66,6 +128,10 @@ namespace eval GenX { } {
    set Param(TileSize)  1024                   ;#Tile size to use for large dataset
    set Param(Cache)     {}                     ;#Input data cache list
    set Param(CacheMax)  20                     ;#Input data cache max
+   set Param(PyramidSamples) 64                ;#Minimum DEM samples per grid cell when reading DEM overviews (0=full resolution only)
+   set Param(PyramidLevels)  8                 ;#Number of DEM overview levels built by GenDEMPyramid
+   set Param(FieldCache) 1024                  ;#Output field registry memory budget in MB (0=write directly to output files)
+   set Param(StageCache) ""                    ;#Processing stage cache directory ("" = no cache, purge when a database is updated in place)
 
    set Param(Vege)       ""                    ;#Vegetation data selected
    set Param(Soil)       ""                    ;#Soil type data selected
@@ -98,6 +164,8 @@ namespace eval GenX { } {
    set Param(Z0Topo)    ""                    ;#With topography for roughness length
    set Param(Compress)  False                 ;#Compress standard file output
    set Param(TopoStag)  False                 ;#Treat mulitple grids as staggered topography
+   set Param(SubCompact) False                ;#Store sub-grid topography samples in compact (16 bit) form
+   set Param(SubCompactTol) ""                ;#Maximum compact sample error in meters (""=half the ME packing step, none for 32 bit output)
    set Param(NBits)     32                    ;#Compress standard file output
    set Param(Cell)      1                     ;#Grid cell dimension (1=1D(point 2=2D(area))
    set Param(Script)    ""                    ;#User definition script
@@ -222,6 +290,7 @@ namespace eval GenX { } {
    set Path(SOILGRIDS2) SoilGrids_v2/global
    set Path(EGM2008)    NGA/EGM2008
    set Path(EGM96)      NGA/EGM96
+   set Path(Pyramid)    Pyramid
    set Path(CHS)        CHS/bathymetry
    set Path(NCEI)       NOAA/NCEI/bathymetry
    set Path(GEBCO)      GEBCO_2014
@@ -297,6 +366,7 @@ namespace eval GenX { } {
 proc GenX::Process { Grid } {
    variable Param
 	variable Opt
+   variable Stages
 
    set Param(TMPDIR) $Param(OutFile)_tmp$Param(Process)
    set Log::Param(Process) $Param(Process)
@@ -307,34 +377,39 @@ proc GenX::Process { Grid } {
       set GeoPhysX::Opt(LegacyMode) True 
    }
 
+   #----- Stage cache keys depend on the grid
+   if { $Param(StageCache)!="" } {
+      set Stages(Grid) [GenX::GridHash $Grid]
+   }
+
    #----- Land-water mask
    if { $Param(Mask)!="" } {
-      GeoPhysX::AverageMask $Grid
+      GenX::Stage Mask { GeoPhysX::AverageMask $Grid }
    }
 
    #----- Vegetation type
    if { $Param(Vege)!="" } {
-      GeoPhysX::AverageVege $Grid
+      GenX::Stage Vege { GeoPhysX::AverageVege $Grid }
    }
 
    #----- Tree Cover
    if { $Param(TreeCover)!="" } {
-      GeoPhysX::AverageTreeCover $Grid
+      GenX::Stage TreeCover { GeoPhysX::AverageTreeCover $Grid }
    }
    
-   #----- Topography
+   #----- Topography (staggered grids share a mosaic built at run time, so it is never taken from the cache)
    if { $Param(Topo)!="" } {
-      GeoPhysX::AverageTopo $Grid
+      GenX::Stage Topo { GeoPhysX::AverageTopo $Grid } [expr !$Param(TopoStag)]
    }
    
    #----- Bathymetry
    if { $Param(Bathy)!="" } {
-      GeoPhysX::AverageBathymetry $Grid
+      GenX::Stage Bathy { GeoPhysX::AverageBathymetry $Grid }
    }
 
    #----- Consistency checks for mask vs vege
    if { $Param(Vege)!=$Param(Mask) || $Param(UseVegeLUT) } {
-      GeoPhysX::CheckMaskVegeConsistency
+      GenX::Stage MaskVege { GeoPhysX::CheckMaskVegeConsistency }
    }
 
    #----- If staggered topograhy is enabled and this is not the first grid, exit
@@ -344,100 +419,104 @@ proc GenX::Process { Grid } {
 
    #----- Slope and Aspect
    if { $Param(Aspect)!="" } {
-      GeoPhysX::AverageAspect $Grid
+      GenX::Stage Aspect { GeoPhysX::AverageAspect $Grid }
    }
 
    #----- Land-water mask
    if { $Param(GeoMask)!="" } {
-      GeoPhysX::AverageGeoMask $Grid
+      GenX::Stage GeoMask { GeoPhysX::AverageGeoMask $Grid }
    }
 
 
    #----- Soil type
    if { $Param(Soil)!="" } {
-      GeoPhysX::AverageSoil $Grid
+      GenX::Stage Soil { GeoPhysX::AverageSoil $Grid }
    }
 
    #----- depth to bedrock
    if { $Param(SoilDBRK)!="" } {
-      GeoPhysX::AverageGSRS_DBRK $Grid
+      GenX::Stage SoilDBRK { GeoPhysX::AverageGSRS_DBRK $Grid }
    }
 
    #----- Vegetation canopy height
    if { $GenX::Param(Sub)!="LEGACY" } {
       if { $GenX::Param(Z0NoTopo) == "CANOPY" } {
-         GeoPhysX::AverageVCH $Grid
+         GenX::Stage VCH { GeoPhysX::AverageVCH $Grid }
       } elseif { ($GenX::Param(Z0NoTopo) == "CANOPY_LT") || ($GenX::Param(TOPO_ZVG2_TYPE) == "CANOPY_LT") } {
-         GeoPhysX::AverageVCH $Grid 1
+         GenX::Stage VCH { GeoPhysX::AverageVCH $Grid 1 }
       }
    }
 
    #----- Hydraulic
    if { $Param(Hydraulic) } {
-      GeoPhysX::AverageSoilHydraulic $Grid
+      GenX::Stage Hydraulic { GeoPhysX::AverageSoilHydraulic $Grid }
    }
 
    #----- Consistency checks
    switch $Param(Check) {
-      "STD" { GeoPhysX::CheckConsistencyStandard }
+      "STD" { GenX::Stage Check { GeoPhysX::CheckConsistencyStandard } }
    }
 
    #----- Consistency checks similar to Genesis
    if { $GeoPhysX::Opt(LegacyMode) } {
-      GeoPhysX::CheckLegacyVG
+      GenX::Stage CheckLegacy { GeoPhysX::CheckLegacyVG }
    }
 
 
    #----- Sub grid calculations
    switch $Param(Sub) {
       "STD" {
-         GeoPhysX::AverageTopoLow  $Grid
-         GeoPhysX::AverageGradient $Grid
-         GeoPhysX::SubCorrectionFactor
-         GeoPhysX::SubLaunchingHeight
-         GeoPhysX::SubY789
-         GeoPhysX::SubRoughnessLength
-         GeoPhysX::SubTopoFilter
+         GenX::Stage TopoLow       { GeoPhysX::AverageTopoLow  $Grid }
+         GenX::Stage Gradient      { GeoPhysX::AverageGradient $Grid }
+         GenX::Stage SubCorrection { GeoPhysX::SubCorrectionFactor }
+         GenX::Stage SubLaunch     { GeoPhysX::SubLaunchingHeight }
+         GenX::Stage SubY789       { GeoPhysX::SubY789 }
+         GenX::Stage SubRoughness  { GeoPhysX::SubRoughnessLength }
+         GenX::Stage SubTopoFilter { GeoPhysX::SubTopoFilter }
       }
       "SPLIT" {
-         GeoPhysX::SubLaunchingHeightSplit
-         GeoPhysX::SubY789Split
-         GeoPhysX::SubRoughnessLength
-         GeoPhysX::SubTopoFilter
+         GenX::Stage SubLaunchSplit { GeoPhysX::SubLaunchingHeightSplit }
+         GenX::Stage SubY789Split   { GeoPhysX::SubY789Split }
+         GenX::Stage SubRoughness   { GeoPhysX::SubRoughnessLength }
+         GenX::Stage SubTopoFilter  { GeoPhysX::SubTopoFilter }
       }
       "LEGACY" {
          if { $Param(Z0Topo) == "STD" } {
-            GeoPhysX::AverageTopoLow  $Grid
-            GeoPhysX::SubCorrectionFactor
-            GeoPhysX::SubRoughnessLength
+            GenX::Stage TopoLow       { GeoPhysX::AverageTopoLow  $Grid }
+            GenX::Stage SubCorrection { GeoPhysX::SubCorrectionFactor }
+            GenX::Stage SubRoughness  { GeoPhysX::SubRoughnessLength }
          }
-         GeoPhysX::SubTopoFilter
+         GenX::Stage SubTopoFilter { GeoPhysX::SubTopoFilter }
       }
    }
 
    if { ($Param(Z0Topo) == "LEGACY")||($Param(Sub) == "LEGACY") } {
-      GeoPhysX::LegacySub $Grid
+      GenX::Stage LegacySub { GeoPhysX::LegacySub $Grid }
    }
 
    #----- Biogenic emissions calculations
    if { $Param(Biogenic)!="" } {
-      BioGenX::CalcEmissions  $Grid
-      BioGenX::TransportableFractions $Grid
+      GenX::Stage Biogenic {
+         BioGenX::CalcEmissions  $Grid
+         BioGenX::TransportableFractions $Grid
 
-      if { [ string equal $Param(Target) "AURAMS" ] } {
-         BioGenX::AURAMSBiogFromVF $Grid
+         if { [ string equal $Param(Target) "AURAMS" ] } {
+            BioGenX::AURAMSBiogFromVF $Grid
+         }
       }
    }
 
    #-----Hydrologic parameters
    if { $Param(Hydro)!="" } {
-      HydroX::DrainDensity $Grid
+      GenX::Stage Hydro { HydroX::DrainDensity $Grid }
    }
 
    #----- Urban parameters
    if { $Param(Urban)!="" } {
-      UrbanX::Process $Param(Urban) $Grid
-      #UrbanPhysX::Cover $Grid
+      GenX::Stage Urban {
+         UrbanX::Process $Param(Urban) $Grid
+         #UrbanPhysX::Cover $Grid
+      }
    }
 
    #----- SMOKE parameters
@@ -452,7 +531,7 @@ proc GenX::Process { Grid } {
 
    #----- Earth Gravitional Model
    if { $Param(EGMGH)!="" } {
-      GeoPhysX::AverageGeoidHeight $Grid
+      GenX::Stage EGMGH { GeoPhysX::AverageGeoidHeight $Grid }
    }
 }
 
@@ -658,7 +737,7 @@ proc GenX::MetaData { Grid } {
    if { [fstdfield is $Grid] } {
       set fld [MetData::TextCode $meta]
       fstdfield define $fld -NOMVAR META -IP1 [fstdfield define $Grid -IP1] -IP2 [fstdfield define $Grid -IP2] -IP3 [fstdfield define $Grid -IP3]
-      fstdfield write $fld GPXOUTFILE 0 True
+      GenX::FieldWrite $fld GPXOUTFILE 0 True
    }
 
    #---- Save as text file
@@ -729,6 +808,11 @@ proc GenX::CommandLine { } {
 
    Specific processing parameters:
       -topostag [format "%-25s : Treat multiple grids as staggered topography grids" ""]
+      -subcompact [format "%-23s : Store sub-grid topography samples in compact form when within -subcompacttol" ""]
+      -subcompacttol [format "%-20s : Maximum compact sample error in meters, bounds ME samples only (default: half the ME NBits packing step, not compacted if NBits=32)" (${::APP_COLOR_GREEN}$Param(SubCompactTol)${::APP_COLOR_RESET})]
+      -pyramid  [format "%-34s : Minimum DEM samples per grid cell when reading DEM overviews (0=full resolution)" (${::APP_COLOR_GREEN}$Param(PyramidSamples)${::APP_COLOR_RESET})]
+      -fieldcache [format "%-32s : Memory budget in MB for output fields kept in memory (0=write directly)" (${::APP_COLOR_GREEN}$Param(FieldCache)${::APP_COLOR_RESET})]
+      -stagecache [format "%-32s : Directory where processing stage outputs are cached for reruns (purge it when a database is updated in place)" (${::APP_COLOR_GREEN}$Param(StageCache)${::APP_COLOR_RESET})]
       -z0filter [format "%-25s : Apply GEM filter to roughness length" ""]
       -mefilter [format "%-34s : Select filter for topography field ME {$Param(MEFilters)}" (${::APP_COLOR_GREEN}$Param(MEFilter)${::APP_COLOR_RESET})]
       -celldim  [format "%-34s : Grid cell dimension (1=point, 2=area)" (${::APP_COLOR_GREEN}$Param(Cell)${::APP_COLOR_RESET})]
@@ -847,6 +931,11 @@ proc GenX::ParseCommandLine { } {
          "check"     { set i [Args::Parse $gargv $gargc $i VALUE         GenX::Param(Check)]; incr flags }
          "diag"      { set i [Args::Parse $gargv $gargc $i FLAG          GenX::Param(Diag)] }
          "topostag"  { set i [Args::Parse $gargv $gargc $i FLAG          GenX::Param(TopoStag)] }
+         "subcompact" { set i [Args::Parse $gargv $gargc $i FLAG         GenX::Param(SubCompact)] }
+         "subcompacttol" { set i [Args::Parse $gargv $gargc $i VALUE      GenX::Param(SubCompactTol)] }
+         "pyramid"   { set i [Args::Parse $gargv $gargc $i VALUE         GenX::Param(PyramidSamples)] }
+         "fieldcache" { set i [Args::Parse $gargv $gargc $i VALUE         GenX::Param(FieldCache)] }
+         "stagecache" { set i [Args::Parse $gargv $gargc $i VALUE         GenX::Param(StageCache)] }
          "mefilter"  { set i [Args::Parse $gargv $gargc $i VALUE         GenX::Param(MEFilter) $GenX::Param(MEFilters)]; incr flags }
          "z0filter"  { set i [Args::Parse $gargv $gargc $i FLAG          GenX::Param(Z0Filter)]; incr flags }
          "z0notopo"  { set i [Args::Parse $gargv $gargc $i VALUE         GenX::Param(Z0NoTopo) $GenX::Param(Z0NoTopos)]; incr flags }
@@ -1411,29 +1500,41 @@ proc GenX::GridGet { File } {
 # Parameters :
 #  <File>    : Standard file path
 #  <NoData>  : No data value to set
+#  <Band>    : Band to read (Default 0, all bands)
 #
 # Return:
+#   <Id>     : Cached band identifier
 #
 # Remarks :
+#   - A single band of a file is cached under its own identifier (File:Band)
 #
 #----------------------------------------------------------------------------
-proc GenX::CacheGet { File { NoData "" } } {
+proc GenX::CacheGet { File { NoData "" } { Band 0 } } {
    variable Param
 
-   if { [lsearch -exact $Param(Cache) $File]==-1 } {
-      gdalband read $File [gdalfile open DEMFILE read $File]
+   set id $File
+   if { $Band } {
+      set id $File:$Band
+   }
+
+   if { [lsearch -exact $Param(Cache) $id]==-1 } {
+      set bands [gdalfile open DEMFILE read $File]
+      if { $Band } {
+         set bands [list [lindex $bands [expr $Band-1]]]
+      }
+      gdalband read $id $bands
       if { $NoData!="" } {
-         gdalband stats $File -nodata $NoData
+         gdalband stats $id -nodata $NoData
       }
       gdalfile close DEMFILE
-      lappend Param(Cache) $File
+      lappend Param(Cache) $id
 
       if { [llength $Param(Cache)]>$Param(CacheMax) } {
          gdalband free [lindex $Param(Cache) 0]
          set Param(Cache) [lreplace $Param(Cache) 0 0]
       }
    }
-   return $File
+   return $id
 }
 
 #----------------------------------------------------------------------------
@@ -1457,6 +1558,599 @@ proc GenX::CacheFree { } {
    }
 }
 
+#----------------------------------------------------------------------------
+# Name     : <GenX::FieldKey>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Build the registry key of a field from its record descriptors.
+#
+# Parameters :
+#  <Id>      : Field identifier
+#
+# Return:
+#   <Key>    : List of {DATEV ETIKET IP1 IP2 IP3 TYPVAR NOMVAR}
+#
+# Remarks :
+#
+#----------------------------------------------------------------------------
+proc GenX::FieldKey { Id } {
+
+   return [list [fstdfield define $Id -DATEV] [string trim [fstdfield define $Id -ETIKET]] \
+      [fstdfield define $Id -IP1] [fstdfield define $Id -IP2] [fstdfield define $Id -IP3] \
+      [string trim [fstdfield define $Id -TYPVAR]] [string trim [fstdfield define $Id -NOMVAR]]]
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GenX::FieldWrite>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Register an output field in memory and queue its write to the
+#            output file.
+#
+# Parameters :
+#  <Id>      : Field identifier
+#  <File>    : Output file identifier (GPXOUTFILE or GPXAUXFILE)
+#  <args>    : fstdfield write arguments (NBits Rewrite Compress)
+#
+# Return:
+#
+# Remarks :
+#   - The field is copied so the caller is free to modify or free it afterward
+#   - Writes are delayed until GenX::FieldFlush, either explicitly, when the
+#     memory budget Param(FieldCache) is exceeded or when a lookup misses
+#   - With Param(FieldCache) at 0, fields are written through directly
+#   - Fields packed on less than 32 bits are read back from the file on their
+#     first lookup (GenX::FieldRead), so that lookups get the same quantized
+#     values as the file without paying for fields never looked up
+#
+#----------------------------------------------------------------------------
+proc GenX::FieldWrite { Id File args } {
+   variable Param
+   variable Fields
+
+   if { $Fields(Recording) } {
+      lappend Fields(Record) [list $File [GenX::FieldKey $Id] $args]
+   }
+
+   if { $Param(FieldCache)<=0 } {
+      eval fstdfield write [list $Id $File] $args
+      return
+   }
+
+   set key     [GenX::FieldKey $Id]
+   set rewrite [lindex $args 1]
+
+   #----- A rewritten record replaces the previous one in the file, so drop it from the registry
+   foreach reg $Fields(List) {
+      if { $Fields($reg,File)==$File && $Fields($reg,Key)==$key } {
+         if { $rewrite=="" || $rewrite } {
+            GenX::FieldDrop $reg
+         } else {
+            GenX::FieldFlush
+         }
+      }
+   }
+
+   set reg   GPXREG[incr Fields(No)]
+   set nbits [lindex $args 0]
+   fstdfield copy $reg $Id
+   lappend Fields(Queue) $reg
+   set Fields($reg,Packed) [expr { $nbits!="" && $nbits!=0 && abs($nbits)<32 }]
+   set Fields($reg,File) $File
+   set Fields($reg,Key)  $key
+   set Fields($reg,Args) $args
+   set Fields($reg,Size) [expr [fstdfield define $Id -NI]*[fstdfield define $Id -NJ]*[fstdfield define $Id -NK]*4]
+   lappend Fields(List) $reg
+   set Fields(Size) [expr $Fields(Size)+$Fields($reg,Size)]
+
+   #----- Keep within memory budget by writing pending fields and releasing the oldest ones
+   if { $Fields(Size)>$Param(FieldCache)*1048576 } {
+      GenX::FieldFlush
+      while { $Fields(Size)>$Param(FieldCache)*1048576 && [llength $Fields(List)]>1 } {
+         set Fields(Evicted,$Fields([lindex $Fields(List) 0],File)) True
+         GenX::FieldDrop [lindex $Fields(List) 0]
+      }
+   }
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GenX::FieldDrop>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Remove a field from the registry.
+#
+# Parameters :
+#  <Reg>     : Registry field identifier
+#
+# Return:
+#
+# Remarks :
+#   - A pending write of the field is cancelled
+#
+#----------------------------------------------------------------------------
+proc GenX::FieldDrop { Reg } {
+   variable Fields
+
+   set Fields(List)  [lsearch -all -inline -exact -not $Fields(List) $Reg]
+   set Fields(Queue) [lsearch -all -inline -exact -not $Fields(Queue) $Reg]
+   set Fields(Size)  [expr $Fields(Size)-$Fields($Reg,Size)]
+   fstdfield free $Reg
+   array unset Fields $Reg,*
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GenX::FieldFlush>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Write the pending registry fields to their output file.
+#
+# Parameters :
+#
+# Return:
+#
+# Remarks :
+#   - Fields are written in registration order and stay available in memory
+#
+#----------------------------------------------------------------------------
+proc GenX::FieldFlush { } {
+   variable Fields
+
+   foreach reg $Fields(Queue) {
+      eval fstdfield write [list $reg $Fields($reg,File)] $Fields($reg,Args)
+   }
+   set Fields(Queue) {}
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GenX::FieldFind>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Find output fields in the registry or in the output file.
+#
+# Parameters :
+#  <File>    : Output file identifier (GPXOUTFILE or GPXAUXFILE)
+#  <DateV>   : Validity date
+#  <Etiket>  : Etiket
+#  <IP1>     : IP1
+#  <IP2>     : IP2
+#  <IP3>     : IP3
+#  <TV>      : TYPVAR
+#  <NV>      : NOMVAR
+#
+# Return:
+#   <Fields> : List of registry identifiers or file record indexes, to be
+#              used with GenX::FieldRead
+#
+# Remarks :
+#   - The file is searched, after a flush, only when nothing is found in
+#     memory or when fields of this file were released from the registry
+#
+#----------------------------------------------------------------------------
+proc GenX::FieldFind { File DateV Etiket IP1 IP2 IP3 TV NV } {
+   variable Fields
+
+   set regs {}
+   if { $DateV==-1 && ![info exists Fields(Evicted,$File)] } {
+      set etiket [string trim $Etiket]
+      set tv     [string trim $TV]
+      set nv     [string trim $NV]
+      foreach reg $Fields(List) {
+         if { $Fields($reg,File)!=$File } {
+            continue
+         }
+         set key $Fields($reg,Key)
+         if { ($etiket=="" || $etiket==[lindex $key 1]) && ($IP1==-1 || $IP1==[lindex $key 2]) && ($IP2==-1 || $IP2==[lindex $key 3]) && \
+              ($IP3==-1 || $IP3==[lindex $key 4]) && ($tv=="" || $tv==[lindex $key 5]) && ($nv=="" || $nv==[lindex $key 6]) } {
+            lappend regs $reg
+         }
+      }
+   }
+
+   if { ![llength $regs] } {
+      GenX::FieldFlush
+      set regs [fstdfield find $File $DateV $Etiket $IP1 $IP2 $IP3 $TV $NV]
+   }
+   return $regs
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GenX::FieldRead>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Read an output field from the registry or from the output file.
+#
+# Parameters :
+#  <Id>      : Field identifier to read into
+#  <File>    : Output file identifier (GPXOUTFILE or GPXAUXFILE)
+#  <args>    : Either a GenX::FieldFind result or the fstdfield read search
+#              criteria (DateV Etiket IP1 IP2 IP3 TV NV)
+#
+# Return:
+#
+# Remarks :
+#   - Like fstdfield read, an error is raised if the field does not exist
+#   - A registry field packed on less than 32 bits is flushed and replaced by
+#     its quantized record on its first lookup
+#
+#----------------------------------------------------------------------------
+proc GenX::FieldRead { Id File args } {
+   variable Fields
+
+   if { [llength $args]==1 } {
+      set regs [lindex $args 0]
+   } else {
+      set regs [eval GenX::FieldFind [list $File] $args]
+   }
+
+   set reg [lindex $regs 0]
+   if { [info exists Fields($reg,File)] } {
+      if { $Fields($reg,Packed) } {
+         GenX::FieldFlush
+         fstdfield read $reg $File [lindex [eval fstdfield find [list $File] $Fields($reg,Key)] end]
+         set Fields($reg,Packed) False
+      }
+      fstdfield copy $Id $reg
+   } elseif { [llength $args]==1 } {
+      fstdfield read $Id $File $reg
+   } else {
+      eval fstdfield read [list $Id $File] $args
+   }
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GenX::GridHash>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Build a content hash of the grid description.
+#
+# Parameters :
+#  <Grid>    : Grid on which the fields are generated
+#
+# Return:
+#   <Hash>   : Hash of the grid descriptors and positional records
+#
+# Remarks :
+#
+#----------------------------------------------------------------------------
+proc GenX::GridHash { Grid } {
+
+   set desc {}
+   foreach d { -GRTYP -NI -NJ -IG1 -IG2 -IG3 -IG4 } {
+      lappend desc [fstdfield define $Grid $d]
+   }
+
+   #----- Z grids are described by the values of their positional records
+   if { [fstdfield define $Grid -GRTYP]=="Z" } {
+      GenX::FieldFlush
+      foreach var { ">>" "^^" } {
+         fstdfield read GPXDESC GPXAUXFILE -1 "" [fstdfield define $Grid -IG1] [fstdfield define $Grid -IG2] [fstdfield define $Grid -IG3] "" $var
+         for { set i 0 } { $i<[fstdfield define GPXDESC -NI] } { incr i } {
+            for { set j 0 } { $j<[fstdfield define GPXDESC -NJ] } { incr j } {
+               lappend desc [fstdfield stats GPXDESC -gridvalue $i $j]
+            }
+         }
+      }
+      fstdfield free GPXDESC
+   }
+   return [GenX::Hash $desc]
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GenX::Hash>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Hash a string.
+#
+# Parameters :
+#  <String>  : String to hash
+#
+# Return:
+#   <Hash>   : 64 hexadecimal digits hash
+#
+# Remarks :
+#   - SHA-256 of tcllib, only loaded when the stage cache is used
+#
+#----------------------------------------------------------------------------
+proc GenX::Hash { String } {
+
+   package require sha256
+   return [sha2::sha256 -hex -- [encoding convertto utf-8 $String]]
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GenX::StageHash>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Build the cache key of a processing stage from its declared inputs.
+#
+# Parameters :
+#  <Name>    : Stage name (Index in Stages)
+#
+# Return:
+#   <Hash>   : Stage hash
+#
+# Remarks :
+#   - The inputs are the application versions, the grid, the database paths,
+#     the stage parameters and settings and the hashes of the upstream stages
+#   - Database paths are resolved (symbolic links included) and stamped with the
+#     modification time and size of their root directory, which only change when
+#     entries are added or removed at the root
+#   - Tiles rewritten in place are not detected, the stage cache directory has to
+#     be purged by hand after such a database update
+#   - Upstream stages that did not run this time do not contribute
+#
+#----------------------------------------------------------------------------
+proc GenX::StageHash { Name } {
+   variable Param
+   variable Settings
+   variable Path
+   variable Stages
+
+   set desc [list $Name $Stages(Grid)]
+   foreach ns { GenX GeoPhysX BioGenX HydroX UrbanX IndustrX } {
+      if { [info exists ${ns}::Param(Version)] } {
+         lappend desc $ns [set ${ns}::Param(Version)]
+      }
+   }
+   foreach name [lsort [array names Path]] {
+      set path [file dirname [file normalize [file join $Param(DBase) $Path($name) _]]]
+      lappend desc $name $path
+      if { ![catch { file stat $path stat }] } {
+         lappend desc $stat(mtime) $stat(size)
+      }
+   }
+
+   foreach { deps params settings } $Stages($Name) break
+   foreach name [concat $Stages(Params) $params] {
+      if { [info exists Param($name)] } {
+         lappend desc $name $Param($name)
+      }
+   }
+   foreach pattern $settings {
+      foreach name [lsort [array names Settings $pattern]] {
+         lappend desc $name $Settings($name)
+      }
+   }
+   foreach dep $deps {
+      if { [info exists Stages($dep,Hash)] } {
+         lappend desc $dep $Stages($dep,Hash)
+      }
+   }
+   return [set Stages($Name,Hash) [GenX::Hash $desc]]
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GenX::Stage>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Run a processing stage or reuse its output fields from the stage
+#            cache.
+#
+# Parameters :
+#  <Name>    : Stage name (Index in Stages)
+#  <Script>  : Script running the stage, evaluated in the caller's context
+#  <Cache>   : Stage can be reused from the cache (Default True)
+#
+# Return:
+#
+# Remarks :
+#   - The cache is enabled by setting Param(StageCache) to a directory
+#   - Every field written by the stage to the output files is saved in the
+#     cache, under a key built from its declared inputs (GenX::StageHash)
+#   - On a cache hit, the fields, the metadata and the GenX parameters changed
+#     by the stage are restored instead of running it, but not its in-memory
+#     objects (Stages(<Name>,Memory)) which are rebuilt by GenX::StageReplay
+#     when a stage depending on it has to run
+#   - A stage run outside the cache gets a unique hash so that every stage
+#     depending on it is run too
+#
+#----------------------------------------------------------------------------
+proc GenX::Stage { Name Script { Cache True } } {
+   variable Param
+   variable Fields
+   variable Meta
+   variable Stages
+
+   if { $Param(StageCache)=="" } {
+      uplevel 1 $Script
+      return
+   }
+
+   #----- Keep what is needed to rerun the stage for a later stage
+   if { [lsearch -exact $Stages(Order) $Name]==-1 } {
+      lappend Stages(Order) $Name
+   }
+   set Stages($Name,Script) $Script
+   set Stages($Name,Level)  [expr [info level]-1]
+   set Stages($Name,Run)    True
+
+   if { !$Cache } {
+      set Stages($Name,Hash) [clock microseconds]
+      GenX::StageReplay $Name
+      uplevel 1 $Script
+      return
+   }
+
+   set file [file join $Param(StageCache) $Name-[GenX::StageHash $Name]]
+
+   #----- Reuse the stage outputs if they are cached
+   if { [file exists $file.lst] && ![catch { GenX::StageLoad $file }] } {
+      Log::Print INFO "Stage $Name reused from cache $file"
+      set Stages($Name,Run) False
+      return
+   }
+
+   #----- Rebuild the in-memory objects of the upstream stages reused from the cache
+   GenX::StageReplay $Name
+
+   #----- Run the stage while recording its outputs
+   set params [array get Param]
+   set procs  $Meta(Procs)
+   set dbs    $Meta(Databases)
+   set Fields(Record) {}
+   set Fields(Recording) True
+
+   set code [catch { uplevel 1 $Script } msg]
+   set Fields(Recording) False
+   if { $code } {
+      return -code $code $msg
+   }
+
+   #----- Keep the GenX parameters modified by the stage
+   set changes {}
+   foreach { name value } [array get Param] {
+      if { ![dict exists $params $name] || [dict get $params $name]!=$value } {
+         lappend changes $name $value
+      }
+   }
+
+   set newdbs {}
+   foreach db $Meta(Databases) {
+      if { [lsearch -exact $dbs $db]==-1 } {
+         lappend newdbs $db
+      }
+   }
+
+   if { [catch { GenX::StageSave $file $changes [lrange $Meta(Procs) [llength $procs] end] $newdbs } msg] } {
+      Log::Print WARNING "Could not save stage $Name in cache: $msg"
+      catch { fstdfile close GPXSTAGEFILE }
+      file delete -force $file.fst $file.lst
+   }
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GenX::StageReplay>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Rerun the upstream stages reused from the cache whose in-memory
+#            objects are needed by a stage about to run.
+#
+# Parameters :
+#  <Name>    : Stage name (Index in Stages)
+#
+# Return:
+#
+# Remarks :
+#   - Upstream stages declaring in-memory objects (Stages(<Stage>,Memory)) are
+#     rerun in processing order, after their own upstream stages, in the context
+#     they were first called from
+#   - Their outputs are not recorded again, their cache entry being still valid
+#
+#----------------------------------------------------------------------------
+proc GenX::StageReplay { Name } {
+   variable Stages
+
+   foreach { deps params settings } $Stages($Name) break
+   foreach stage $Stages(Order) {
+      if { [lsearch -exact $deps $stage]==-1 || ![info exists Stages($stage,Memory)] || $Stages($stage,Run) } {
+         continue
+      }
+      set Stages($stage,Run) True
+      GenX::StageReplay $stage
+      Log::Print INFO "Stage $stage rerun to rebuild [join $Stages($stage,Memory) {, }] for stage $Name"
+      uplevel #$Stages($stage,Level) $Stages($stage,Script)
+   }
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GenX::StageSave>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Save the output fields recorded for a stage in the stage cache.
+#
+# Parameters :
+#  <File>    : Cache file path without extension
+#  <Params>  : GenX parameters changed by the stage (name value list)
+#  <Procs>   : Procedures registered by the stage in the metadata
+#  <Dbs>     : Databases registered by the stage in the metadata
+#
+# Return:
+#
+# Remarks :
+#   - Fields are kept in a standard file (.fst) with their grid descriptors,
+#     the record list (.lst) is written last to commit the entry
+#
+#----------------------------------------------------------------------------
+proc GenX::StageSave { File Params Procs Dbs } {
+   variable Fields
+
+   GenX::FieldFlush
+   file mkdir [file dirname $File]
+
+   #----- Only keep the last write of a record
+   set records {}
+   foreach rec $Fields(Record) {
+      set idx [lsearch -exact $records [lrange $rec 0 1]]
+      set records [lreplace $records $idx $idx]
+      lappend records [lrange $rec 0 1]
+      set args([lrange $rec 0 1]) [lindex $rec 2]
+   }
+
+   set list {}
+   fstdfile open GPXSTAGEFILE write $File.fst
+   foreach rec $records {
+      foreach { file key } $rec break
+      eval [list fstdfield read GPXSTAGE $file] $key
+      eval [list fstdfield write GPXSTAGE GPXSTAGEFILE] $args($rec)
+      GenX::GridCopyDesc GPXSTAGE $file GPXSTAGEFILE
+      lappend list [list $file $key $args($rec)]
+   }
+   fstdfile close GPXSTAGEFILE
+   fstdfield free GPXSTAGE
+
+   set f [open $File.tmp w]
+   puts $f [list $list $Params $Procs $Dbs]
+   close $f
+   file rename -force $File.tmp $File.lst
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GenX::StageLoad>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Restore the outputs of a stage from the stage cache.
+#
+# Parameters :
+#  <File>    : Cache file path without extension
+#
+# Return:
+#
+# Remarks :
+#   - Fields are written back to their output file with their original
+#     write arguments
+#
+#----------------------------------------------------------------------------
+proc GenX::StageLoad { File } {
+   variable Param
+   variable Meta
+
+   set f [open $File.lst r]
+   foreach { list params procs dbs } [read $f] break
+   close $f
+
+   if { [catch {
+      fstdfile open GPXSTAGEFILE read $File.fst
+      foreach rec $list {
+         foreach { file key args } $rec break
+         eval [list fstdfield read GPXSTAGE GPXSTAGEFILE] $key
+         eval [list GenX::FieldWrite GPXSTAGE $file] $args
+      }
+   } msg] } {
+      catch { fstdfile close GPXSTAGEFILE }
+      error $msg
+   }
+   fstdfile close GPXSTAGEFILE
+   fstdfield free GPXSTAGE
+
+   array set Param $params
+   foreach proc $procs {
+      if { [lsearch -exact $Meta(Procs) $proc]==-1 } {
+         lappend Meta(Procs) $proc
+      }
+   }
+   set Meta(Databases) [lsort -unique [concat $Meta(Databases) $dbs]]
+}
+
 #----------------------------------------------------------------------------
 # Name     : <GenX::ASTERGDEMFindFiles>
 # Creation : Novembre 2007 - Gauthier JP - CMC/CMOE
@@ -91,6 +91,8 @@ namespace eval GeoPhysX { } {
    set Param(Z0M_VegeZ0_CCILCWE) {0.001 0.001 0.001 1.75 2.0 1.0 2.0 3.0 0.8 0.1 0.1 0.2 0.05 0.2 0.10 0.15 0.15 0.25 0.10 0.25 0.75 0.01 0.1 0.1 1.75 0.5}
 
    set Param(SoilGridsV2_Soils)   {sand clay bdod cec cfvo soc silt ocd}
+   set Param(TopoMosaicWait)      1800  ;# Maximum wait (s) of staggered grids for the topography mosaic of the first grid
+   set Param(RasterStackMem)      2048  ;# Memory budget (MB) of the single pass multi-band raster averaging
 
    #----- Constants definitions
 
@@ -207,6 +209,7 @@ namespace eval GeoPhysX { } {
    set Opt(LegacyMode)   False
    set Opt(SlopOnly)     False
    set Opt(LinearNodata) True
+   set Opt(TopoMosaic)   ""
    
 }
 
@@ -229,6 +232,9 @@ proc GeoPhysX::AverageTopo { Grid } {
 
    GenX::Procs
 
+   #----- Forget compact sub-grid samples of a previous GPXME
+   geophy subgrid_free GPXME
+
    fstdfield copy GPXME  $Grid
    fstdfield copy GPXRMS $Grid
    fstdfield copy GPXRES $Grid
@@ -258,26 +264,56 @@ proc GeoPhysX::AverageTopo { Grid } {
 #      fstdfield  configure GPXWESUM  -rendertexture 1 -interpdegree NEAREST
    }
 
-   foreach topo $GenX::Param(Topo) {
-      switch $topo {
-         "USGS"      { GeoPhysX::AverageTopoUSGS      GPXME     ;#----- USGS topograhy averaging method (Global 900m) }
-         "SRTM"      { GeoPhysX::AverageTopoSRTM      GPXME $topo  ;#----- STRMv4 topograhy averaging method (Latitude -60,60 90m or 30m) }
-         "SRTM30"    { GeoPhysX::AverageTopoSRTM      GPXME $topo  ;#----- STRMv4 topograhy averaging method (Latitude -60,60 30m) }
-         "SRTM90"    { GeoPhysX::AverageTopoSRTM      GPXME $topo  ;#----- STRMv4 topograhy averaging method (Latitude -60,60 90m) }
-         "CDED50"    { GeoPhysX::AverageTopoCDED      GPXME 50  ;#----- CDED50 topograhy averaging method (Canada 90m) }
-         "CDED250"   { GeoPhysX::AverageTopoCDED      GPXME 250 ;#----- CDED250 topograhy averaging method (Canada 25m) }
-         "ASTERGDEM" { GeoPhysX::AverageTopoASTERGDEM GPXME     ;#----- ASTERGDEM topograhy averaging method (Global but south pole 25m) }
-         "GTOPO30"   { GeoPhysX::AverageTopoGTOPO30   GPXME     ;#----- GTOPO30 topograhy averaging method (Global  900m) }
-         "GMTED30"   { GeoPhysX::AverageTopoGMTED2010 GPXME 30  ;#----- GMTED2010 topograhy averaging method (Global  900m) }
-         "GMTED15"   { GeoPhysX::AverageTopoGMTED2010 GPXME 15  ;#----- GMTED2010 topograhy averaging method (Global  450m) }
-         "GMTED75"   { GeoPhysX::AverageTopoGMTED2010 GPXME 75  ;#----- GMTED2010 topograhy averaging method (Global  225m) }
-         "CDEM"      { GeoPhysX::AverageTopoCDEM      GPXME     ;#----- CDEM topograhy averaging method (Canada 25m) }
-         "FABDEM"    { GeoPhysX::AverageTopoFABDEM    GPXME     ;#----- FABDEM topograhy averaging method (Global 30m) }
+   #----- Staggered grids derive their topography from the mosaic accumulated by the first grid
+   set mosaic [GeoPhysX::TopoMosaicMode $Grid]
+
+   if { $mosaic=="READ" && [GeoPhysX::TopoMosaicDerive GPXME] } {
+      Log::Print INFO "Topography derived from the staggered topography mosaic"
+   } else {
+      #----- Let the staggered grids know right away if the mosaic will never come
+      if { [catch {
+         set k 0
+         foreach topo $GenX::Param(Topo) {
+            if { $mosaic=="WRITE" } {
+               GeoPhysX::TopoMosaicStart
+            }
+            switch $topo {
+               "USGS"      { GeoPhysX::AverageTopoUSGS      GPXME     ;#----- USGS topograhy averaging method (Global 900m) }
+               "SRTM"      { GeoPhysX::AverageTopoSRTM      GPXME $topo  ;#----- STRMv4 topograhy averaging method (Latitude -60,60 90m or 30m) }
+               "SRTM30"    { GeoPhysX::AverageTopoSRTM      GPXME $topo  ;#----- STRMv4 topograhy averaging method (Latitude -60,60 30m) }
+               "SRTM90"    { GeoPhysX::AverageTopoSRTM      GPXME $topo  ;#----- STRMv4 topograhy averaging method (Latitude -60,60 90m) }
+               "CDED50"    { GeoPhysX::AverageTopoCDED      GPXME 50  ;#----- CDED50 topograhy averaging method (Canada 90m) }
+               "CDED250"   { GeoPhysX::AverageTopoCDED      GPXME 250 ;#----- CDED250 topograhy averaging method (Canada 25m) }
+               "ASTERGDEM" { GeoPhysX::AverageTopoASTERGDEM GPXME     ;#----- ASTERGDEM topograhy averaging method (Global but south pole 25m) }
+               "GTOPO30"   { GeoPhysX::AverageTopoGTOPO30   GPXME     ;#----- GTOPO30 topograhy averaging method (Global  900m) }
+               "GMTED30"   { GeoPhysX::AverageTopoGMTED2010 GPXME 30  ;#----- GMTED2010 topograhy averaging method (Global  900m) }
+               "GMTED15"   { GeoPhysX::AverageTopoGMTED2010 GPXME 15  ;#----- GMTED2010 topograhy averaging method (Global  450m) }
+               "GMTED75"   { GeoPhysX::AverageTopoGMTED2010 GPXME 75  ;#----- GMTED2010 topograhy averaging method (Global  225m) }
+               "CDEM"      { GeoPhysX::AverageTopoCDEM      GPXME     ;#----- CDEM topograhy averaging method (Canada 25m) }
+               "FABDEM"    { GeoPhysX::AverageTopoFABDEM    GPXME     ;#----- FABDEM topograhy averaging method (Global 30m) }
+            }
+            if { $mosaic=="WRITE" } {
+               GeoPhysX::TopoMosaicSave $topo [incr k]
+            }
+         }
+
+         if { [fstdfield is GPXPYCNT] } {
+            GeoPhysX::AverageTopoPyramidMerge
+         } else {
+            fstdfield gridinterp GPXME - NOP True
+         }
+
+         if { $mosaic=="WRITE" } {
+            GeoPhysX::TopoMosaicClose
+         }
+      } msg] } {
+         if { $mosaic=="WRITE" } {
+            GeoPhysX::TopoMosaicFail
+         }
+         error $msg $::errorInfo $::errorCode
       }
    }
 
-   fstdfield gridinterp GPXME - NOP True
-
    if { $Opt(LegacyMode) } {
       vexpr (Float64)GPXMEWE  "ifelse(GPXWESUM>0.0,GPXMESUM/GPXWESUM,0.0)"
       fstdfield stats GPXME -datacopy GPXMEWE
@@ -288,20 +324,46 @@ proc GeoPhysX::AverageTopo { Grid } {
    fstdfield stats GPXME -mask ""
    #----- Save output
    fstdfield define GPXME -NOMVAR MENF -ETIKET $GenX::Param(ETIKET) -IP2 0
-   fstdfield write GPXME GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXME GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+
+   #----- Keep the sub-grid samples in compact form for LegacySub if the quantization error
+   #      stays within the tolerance, by default half the packing step of ME, which is the
+   #      rounding error of the ME written. This bounds the ME samples only: DH moves by at most
+   #      the tolerance and LH by twice, but Z0 and the slopes are not bounded (see test/GeoPhyCoreTest.c)
+   #      There is no packing step for 32 bit output, the samples stay in float form unless a tolerance is given
+   if { $GenX::Param(SubCompact) && (($GenX::Param(Sub)=="LEGACY") || ($GenX::Param(Z0Topo)=="LEGACY")) } {
+      set tol ""
+      if { $GenX::Param(SubCompactTol)!="" } {
+         set tol $GenX::Param(SubCompactTol)
+      } elseif { $GenX::Param(NBits)<32 } {
+         set tol [expr ([vexpr a "smax(GPXME)"]-[vexpr a "smin(GPXME)"])/(pow(2,$GenX::Param(NBits))-1)/2.0]
+      }
+      if { $tol=="" } {
+         Log::Print INFO "Sub-grid topography kept in float form, ME is written as 32 bit floats and no -subcompacttol was given"
+      } else {
+         set res [geophy subgrid_pack GPXME $tol]
+         if { [lindex $res 0] } {
+            Log::Print INFO "Sub-grid topography stored in compact form (max error [format %.5f [lindex $res 1]] m)"
+         } else {
+            Log::Print INFO "Sub-grid topography kept in float form, compact error ([format %.5f [lindex $res 1]] m) exceeds tolerance ([format %.5f $tol] m)"
+         }
+      }
+   }
 
    #----- Process RMS and resolution only for unstaggered grids
    if { !$GenX::Param(TopoStag) || $GenX::Param(Process)==0 } {
    
-      #----- Save RMS
-      fstdfield gridinterp GPXRMS - NOP True
+      #----- Save RMS (already averaged if overviews were used)
+      if { ![fstdfield is GPXPYCNT] } {
+         fstdfield gridinterp GPXRMS - NOP True
+      }
       vexpr GPXRMS sqrt(GPXRMS)
       fstdfield define GPXRMS -NOMVAR MRMS -ETIKET $GenX::Param(ETIKET) -IP1 1200
-      fstdfield write GPXRMS GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXRMS GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
       #----- Save resolution
       fstdfield define GPXRES -NOMVAR MRES -ETIKET $GenX::Param(ETIKET) -IP1 1200
-      fstdfield write GPXRES GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXRES GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    }
 
    #----- Finalize derivatives if applicable
@@ -312,17 +374,560 @@ proc GeoPhysX::AverageTopo { Grid } {
       fstdfield define GPXGXX -NOMVAR GXX -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
       fstdfield define GPXGYY -NOMVAR GYY -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
       fstdfield define GPXGXY -NOMVAR GXY -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-      fstdfield write GPXGXX GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-      fstdfield write GPXGYY GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-      fstdfield write GPXGXY GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXGXX GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXGYY GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXGXY GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    }
 
-   fstdfield free GPXRMS GPXRES GPXTSK
+   fstdfield free GPXRMS GPXRES GPXTSK GPXPYSUM GPXPYSQ GPXPYCNT GPXPYCOV
    if { $Opt(SubSplit) } {
       fstdfield free GPXGXX GPXGYY GPXGXY
    }
 }
 
+#----------------------------------------------------------------------------
+# Name     : <GeoPhysX::TopoMosaicMode>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Figure out if the topography mosaic shared by staggered grids
+#            is to be produced or used by this process.
+#
+# Parameters :
+#   <Grid>   : Grid on which to generate the topo
+#
+# Return:
+#   <Mode>   : WRITE for the first grid, READ for the staggered ones, "" otherwise
+#
+# Remarks :
+#    - The mosaic accumulates the DEM samples on sub-cells, two per grid cell in each
+#      direction plus one on each side, so that the cells of grids shifted by half a
+#      cell are exact unions of sub-cells
+#    - Only the plain averaging of MENF is derived from the mosaic, legacy weighting,
+#      sub-grid samples and derivatives still need the DEM databases
+#    - Area cells (GenX::Param(Cell)==2) do not split into sub-cells and are not supported
+#    - The DEM tiles are selected on the mosaic grid (see TopoCover) which spans the
+#      union of all the staggered grids
+#
+#----------------------------------------------------------------------------
+proc GeoPhysX::TopoMosaicMode { Grid } {
+   variable Opt
+
+   set Opt(TopoMosaic) ""
+
+   if { !$GenX::Param(TopoStag) || $GenX::Param(Process)=="" || $Opt(LegacyMode) || $Opt(SubSplit) || $GenX::Param(Cell)==2 } {
+      return ""
+   }
+   if { ($GenX::Param(Sub)=="LEGACY") || ($GenX::Param(Z0Topo)=="LEGACY") || [fstdfield define $Grid -GRTYP]!="Z" } {
+      return ""
+   }
+
+   if { $GenX::Param(Process)!=0 } {
+      return READ
+   }
+
+   #----- Refine the grid descriptors of the first grid
+   set ig1 [fstdfield define $Grid -IG1]
+   set ig2 [fstdfield define $Grid -IG2]
+   set ig3 [fstdfield define $Grid -IG3]
+   GenX::FieldRead GPXTIC GPXAUXFILE -1 "" $ig1 $ig2 $ig3 "" ">>"
+   GenX::FieldRead GPXTAC GPXAUXFILE -1 "" $ig1 $ig2 $ig3 "" "^^"
+   GeoPhysX::TopoMosaicAxis GPXTIC GPXMOSTIC
+   GeoPhysX::TopoMosaicAxis GPXTAC GPXMOSTAC
+
+   file delete -force $GenX::Param(OutFile)_topomosaic.tmp $GenX::Param(OutFile)_topomosaic.failed
+   fstdfile open GPXMOSFILE write $GenX::Param(OutFile)_topomosaic.tmp
+   fstdfield write GPXMOSTIC GPXMOSFILE 0 True
+   fstdfield write GPXMOSTAC GPXMOSFILE 0 True
+
+   #----- Write and read back the mosaic grid so that its georeference gets built from the refined descriptors
+   fstdfield create GPXMOS [fstdfield define GPXMOSTIC -NI] [fstdfield define GPXMOSTAC -NJ] 1 Float32
+   fstdfield define GPXMOS -NOMVAR "MOSG" -TYPVAR C -GRTYP Z -IG1 $ig1 -IG2 $ig2 -IG3 $ig3 -IP1 0 -IP2 0 -IP3 0
+   fstdfield write GPXMOS GPXMOSFILE -16 True
+   fstdfield read GPXMOS GPXMOSFILE -1 "" -1 -1 -1 "" "MOSG"
+
+   fstdfield free GPXTIC GPXTAC GPXMOSTIC GPXMOSTAC
+
+   Log::Print INFO "Accumulating staggered topography mosaic on [fstdfield define GPXMOS -NI]x[fstdfield define GPXMOS -NJ] sub-cells"
+   return WRITE
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GeoPhysX::TopoMosaicAxis>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Create a grid axis descriptor split in two sub-cells per cell.
+#
+# Parameters :
+#   <Axis>   : Axis descriptor (>> or ^^)
+#   <Id>     : Identifier of the refined descriptor to create
+#
+# Return:
+#
+# Remarks :
+#    - Cell bounds are midway between axis values, extrapolated at both ends, and
+#      one more sub-cell is added at each end to hold the staggered cells
+#
+#----------------------------------------------------------------------------
+proc GeoPhysX::TopoMosaicAxis { Axis Id } {
+
+   set ni [fstdfield define $Axis -NI]
+   set nj [fstdfield define $Axis -NJ]
+   set n  [expr $ni*$nj]
+
+   set x {}
+   for { set i 0 } { $i<$n } { incr i } {
+      if { $ni>1 } {
+         lappend x [fstdfield stats $Axis -gridvalue $i 0]
+      } else {
+         lappend x [fstdfield stats $Axis -gridvalue 0 $i]
+      }
+   }
+
+   #----- Cell bounds
+   set b [list [expr 1.5*[lindex $x 0]-0.5*[lindex $x 1]]]
+   for { set i 1 } { $i<$n } { incr i } {
+      lappend b [expr 0.5*([lindex $x [expr $i-1]]+[lindex $x $i])]
+   }
+   lappend b [expr 1.5*[lindex $x end]-0.5*[lindex $x end-1]]
+
+   #----- Sub-cell centers
+   set r [list [expr 1.5*[lindex $b 0]-0.5*[lindex $x 0]]]
+   for { set i 0 } { $i<$n } { incr i } {
+      lappend r [expr 0.5*([lindex $b $i]+[lindex $x $i])] [expr 0.5*([lindex $x $i]+[lindex $b [expr $i+1]])]
+   }
+   lappend r [expr 1.5*[lindex $b end]-0.5*[lindex $x end]]
+
+   if { $ni>1 } {
+      fstdfield create $Id [llength $r] 1 1 Float32
+   } else {
+      fstdfield create $Id 1 [llength $r] 1 Float32
+   }
+   fstdfield copyhead $Id $Axis
+
+   set i 0
+   foreach v $r {
+      if { $ni>1 } {
+         fstdfield stats $Id -gridvalue $i 0 $v
+      } else {
+         fstdfield stats $Id -gridvalue 0 $i $v
+      }
+      incr i
+   }
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GeoPhysX::TopoMosaicStart>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Start the mosaic accumulation of a DEM database.
+#
+# Parameters :
+#
+# Return:
+#
+# Remarks :
+#    - The AverageTopo* procs feed their tiles to Opt(TopoMosaic) when it is set
+#
+#----------------------------------------------------------------------------
+proc GeoPhysX::TopoMosaicStart { } {
+   variable Opt
+
+   fstdfield copy GPXMOSAIC GPXMOS
+   GenX::GridClear GPXMOSAIC 0.0
+   set Opt(TopoMosaic) GPXMOSAIC
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GeoPhysX::TopoMosaicSave>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Save the mosaic mean and sample count of a DEM database.
+#
+# Parameters :
+#   <Topo>   : DEM database name
+#   <Index>  : Order of the database in the topography list
+#
+# Return:
+#
+# Remarks :
+#
+#----------------------------------------------------------------------------
+proc GeoPhysX::TopoMosaicSave { Topo Index } {
+   variable Opt
+
+   fstdfield gridinterp GPXMOSAIC - ACCUM
+   fstdfield copy GPXMOSN GPXMOSAIC
+   fstdfield gridinterp GPXMOSAIC - NOP True
+
+   fstdfield define GPXMOSAIC -NOMVAR MOSM -ETIKET $Topo -IP1 $Index
+   fstdfield define GPXMOSN   -NOMVAR MOSN -ETIKET $Topo -IP1 $Index
+   fstdfield write GPXMOSAIC GPXMOSFILE -32 True
+   fstdfield write GPXMOSN   GPXMOSFILE -32 True
+
+   fstdfield free GPXMOSAIC GPXMOSN
+   set Opt(TopoMosaic) ""
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GeoPhysX::TopoMosaicClose>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Publish the topography mosaic to the staggered grid processes.
+#
+# Parameters :
+#
+# Return:
+#
+# Remarks :
+#    - The file is renamed once complete so that readers never see a partial mosaic
+#
+#----------------------------------------------------------------------------
+proc GeoPhysX::TopoMosaicClose { } {
+
+   fstdfile close GPXMOSFILE
+   fstdfield free GPXMOS
+   file rename -force $GenX::Param(OutFile)_topomosaic.tmp $GenX::Param(OutFile)_topomosaic.fst
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GeoPhysX::TopoMosaicFail>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Publish the failure of the topography mosaic to the staggered grid processes.
+#
+# Parameters :
+#
+# Return:
+#
+# Remarks :
+#    - Readers stop waiting as soon as the marker appears and average the DEM databases directly
+#    - The parent process also writes the marker when the first grid exits without a mosaic,
+#      ie: through Log::End before reaching AverageTopo
+#
+#----------------------------------------------------------------------------
+proc GeoPhysX::TopoMosaicFail { } {
+   variable Opt
+
+   set Opt(TopoMosaic) ""
+   catch { fstdfile close GPXMOSFILE }
+   catch { fstdfield free GPXMOS GPXMOSAIC GPXMOSN }
+   file delete -force $GenX::Param(OutFile)_topomosaic.tmp
+   close [open $GenX::Param(OutFile)_topomosaic.failed w]
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GeoPhysX::TopoCover>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Get the field whose extent selects the DEM tiles to average.
+#
+# Parameters :
+#   <Grid>   : Grid on which to generate the topo
+#
+# Return:
+#   <Field>  : Mosaic field when it is being accumulated, the grid otherwise
+#
+# Remarks :
+#    - The mosaic extends half a cell past the first grid on each side so that
+#      it covers the staggered grids too
+#
+#----------------------------------------------------------------------------
+proc GeoPhysX::TopoCover { Grid } {
+   variable Opt
+
+   if { $Opt(TopoMosaic)!="" } {
+      return $Opt(TopoMosaic)
+   }
+   return $Grid
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GeoPhysX::TopoMosaicDerive>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Derive the topography of a staggered grid from the mosaic
+#            accumulated by the first grid.
+#
+# Parameters :
+#   <Grid>   : Topography field to fill
+#
+# Return:
+#   <Ok>     : True if the mosaic was used, False if it is not available
+#
+# Remarks :
+#    - The coverage mask of the AverageTopo* procs is replayed database by database
+#      so that the finer databases keep precedence over the coarser ones
+#
+#----------------------------------------------------------------------------
+proc GeoPhysX::TopoMosaicDerive { Grid } {
+   variable Param
+
+   set file $GenX::Param(OutFile)_topomosaic.fst
+
+   #----- Wait for the first grid to publish the mosaic
+   set wait 0
+   while { ![file exists $file] } {
+      if { [file exists $GenX::Param(OutFile)_topomosaic.failed] } {
+         Log::Print WARNING "Staggered topography mosaic failed on the first grid, averaging the DEM databases directly"
+         return False
+      }
+      if { $wait>=$Param(TopoMosaicWait) } {
+         Log::Print WARNING "Staggered topography mosaic not available after $wait seconds, averaging the DEM databases directly"
+         return False
+      }
+      after 10000
+      incr wait 10
+   }
+
+   fstdfile open GPXMOSFILE read $file
+
+   foreach fld { GPXMOSSUM GPXMOSCNT GPXMOSS GPXMOSC } {
+      fstdfield copy $fld $Grid
+      GenX::GridClear $fld 0.0
+   }
+
+   foreach field [fstdfield find GPXMOSFILE -1 "" -1 -1 -1 "" "MOSM"] {
+      fstdfield read GPXMOSAIC GPXMOSFILE $field
+      set topo [string trim [fstdfield define GPXMOSAIC -ETIKET]]
+      fstdfield read GPXMOSN GPXMOSFILE -1 "" [fstdfield define GPXMOSAIC -IP1] -1 -1 "" "MOSN"
+      Log::Print DEBUG "   Gathering $topo samples from the mosaic"
+
+      #----- Gather sub-cell sums and counts on the grid
+      vexpr GPXMOSAIC GPXMOSAIC*GPXMOSN
+      GenX::GridClear { GPXMOSS GPXMOSC } 0.0
+      fstdfield gridinterp GPXMOSS GPXMOSAIC SUM
+      fstdfield gridinterp GPXMOSC GPXMOSN   SUM
+
+      #----- Only cells not yet covered by a previous database get the samples
+      vexpr GPXMOSSUM ifelse(GPXTSK,GPXMOSSUM+GPXMOSS,GPXMOSSUM)
+      vexpr GPXMOSCNT ifelse(GPXTSK,GPXMOSCNT+GPXMOSC,GPXMOSCNT)
+      if { $topo!="USGS" && $topo!="GTOPO30" } {
+         vexpr GPXTSK !fpeel(GPXMOSCNT)
+      }
+   }
+   fstdfile close GPXMOSFILE
+
+   vexpr $Grid ifelse(GPXMOSCNT>0.0,GPXMOSSUM/GPXMOSCNT,$Grid)
+
+   fstdfield free GPXMOSAIC GPXMOSN GPXMOSSUM GPXMOSCNT GPXMOSS GPXMOSC
+   return True
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GeoPhysX::PyramidLevel>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Select the coarsest DEM overview level that still gives enough
+#            samples per grid cell.
+#
+# Parameters :
+#   <Grid>   : Grid on which to generate the fields
+#   <Res>    : DEM database resolution in degrees
+#
+# Return:
+#   <Level>  : Overview level (0 for full resolution)
+#
+# Remarks :
+#    - Overview level L has a pixel size of Res*2^L and is built by GenDEMPyramid.tcl
+#    - Area cells (GenX::Param(Cell)==2) always use the full resolution tiles
+#    - The level is clamped to the deepest level built, tiles missing from that level
+#      are still read at full resolution
+#
+#----------------------------------------------------------------------------
+proc GeoPhysX::PyramidLevel { Grid Res } {
+
+   if { $GenX::Param(PyramidSamples)<=0 || $GenX::Param(Cell)!=1 } {
+      return 0
+   }
+
+   set reso  [GenX::Get_Grid_Reso $Grid]
+   set level 0
+   while { $level<$GenX::Param(PyramidLevels) && pow($reso/($Res*pow(2,$level+1)),2)>=$GenX::Param(PyramidSamples) } {
+      incr level
+   }
+
+   set best $level
+   while { $level && ![file isdirectory $GenX::Param(DBase)/$GenX::Path(Pyramid)/L$level] } {
+      incr level -1
+   }
+   if { $level!=$best } {
+      Log::Print WARNING "DEM overview level $best was not built (see GenDEMPyramid), using level $level"
+   }
+
+   if { $level } {
+      Log::Print INFO "Using DEM overview level $level ([format %.2f [expr $Res*pow(2,$level)*3600.0]] arc-seconds samples)"
+   }
+   return $level
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GeoPhysX::PyramidFile>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Get the overview file of a DEM tile.
+#
+# Parameters :
+#   <File>   : DEM tile path
+#   <Level>  : Overview level
+#
+# Return:
+#   <File>   : Overview file path
+#
+# Remarks :
+#    - The overviews mirror the database tree under $GenX::Path(Pyramid)/L<Level>
+#
+#----------------------------------------------------------------------------
+proc GeoPhysX::PyramidFile { File Level } {
+
+   set dbase [file normalize $GenX::Param(DBase)]
+   set file  [file normalize $File]
+
+   if { [string first $dbase/ $file]==0 } {
+      set file [string range $file [expr [string length $dbase]+1] end]
+   } else {
+      set file [string trimleft $file /]
+   }
+   return $dbase/$GenX::Path(Pyramid)/L$Level/[file rootname $file].tif
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GeoPhysX::TopoPyramidLevel>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Select the DEM overview level to use for topography averaging.
+#
+# Parameters :
+#   <Grid>   : Grid on which to generate the topo
+#   <Res>    : DEM database resolution in degrees
+#
+# Return:
+#   <Level>  : Overview level (0 for full resolution)
+#
+# Remarks :
+#    - Legacy weighting, sub-grid samples, derivatives and the staggered mosaic
+#      need the full resolution tiles
+#
+#----------------------------------------------------------------------------
+proc GeoPhysX::TopoPyramidLevel { Grid Res } {
+   variable Opt
+
+   if { $Opt(LegacyMode) || $Opt(SubSplit) || $Opt(TopoMosaic)!="" } {
+      return 0
+   }
+   if { ($GenX::Param(Sub)=="LEGACY") || ($GenX::Param(Z0Topo)=="LEGACY") } {
+      return 0
+   }
+   return [GeoPhysX::PyramidLevel $Grid $Res]
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GeoPhysX::AverageTopoPyramid>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Accumulate the overview of a DEM tile into the topography.
+#
+# Parameters :
+#   <Grid>   : Grid on which to generate the topo
+#   <File>   : DEM tile path
+#   <Level>  : Overview level
+#
+# Return:
+#   <Ok>     : True if the overview was used, False if it does not exist
+#
+# Remarks :
+#    - Overviews hold the mean, mean-square and sample count, the sums weighted by
+#      the counts are kept in GPXPYSUM, GPXPYSQ and GPXPYCNT for AverageTopoPyramidMerge
+#    - Overview blocks are assigned whole to the cell holding their center, so the mean
+#      and RMS only approximate those of the full resolution tiles along the cell edges
+#    - Cells already covered by a previous database (GPXTSK) are left untouched
+#
+#----------------------------------------------------------------------------
+proc GeoPhysX::AverageTopoPyramid { Grid File Level } {
+
+   if { ![file exists [set file [GeoPhysX::PyramidFile $File $Level]]] } {
+      return False
+   }
+   Log::Print DEBUG "   Processing overview file $file"
+
+   if { ![fstdfield is GPXPYCNT] } {
+      foreach fld { GPXPYSUM GPXPYSQ GPXPYCNT GPXPYTMP } {
+         fstdfield copy $fld $Grid
+         GenX::GridClear $fld 0.0
+      }
+   }
+
+   set bands [gdalfile open GPXPYFILE read $file]
+   gdalband read GPXPYM [list [lindex $bands 0]]
+   gdalband read GPXPYQ [list [lindex $bands 1]]
+   gdalband read GPXPYN [list [lindex $bands 2]]
+   gdalfile close GPXPYFILE
+
+   vexpr GPXPYM GPXPYM*GPXPYN
+   vexpr GPXPYQ GPXPYQ*GPXPYN
+
+   foreach { acc band } { GPXPYSUM GPXPYM GPXPYSQ GPXPYQ GPXPYCNT GPXPYN } {
+      GenX::GridClear GPXPYTMP 0.0
+      fstdfield gridinterp GPXPYTMP $band SUM
+      vexpr $acc ifelse(GPXTSK,$acc+GPXPYTMP,$acc)
+   }
+   gdalband free GPXPYM GPXPYQ GPXPYN
+
+   return True
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GeoPhysX::TopoPyramidCount>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Get the coverage count of an accumulation including the overview samples.
+#
+# Parameters :
+#   <Field>  : Field holding the full resolution counts (after ACCUM)
+#
+# Return:
+#   <Field>  : GPXPYCOV if overviews were used, Field otherwise
+#
+# Remarks :
+#    - Keeps the coverage masks and source resolution of the AverageTopo* procs
+#      aware of the cells filled from overviews
+#    - Field is left untouched since its accumulators are still needed by
+#      AverageTopoPyramidMerge
+#
+#----------------------------------------------------------------------------
+proc GeoPhysX::TopoPyramidCount { Field } {
+
+   if { [fstdfield is GPXPYCNT] } {
+      vexpr GPXPYCOV $Field+GPXPYCNT
+      return GPXPYCOV
+   }
+   return $Field
+}
+
+#----------------------------------------------------------------------------
+# Name     : <GeoPhysX::AverageTopoPyramidMerge>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Finalize the topography and RMS averages with the overview sums.
+#
+# Parameters :
+#
+# Return:
+#
+# Remarks :
+#    - Replaces the final NOP of GPXME and GPXRMS
+#
+#----------------------------------------------------------------------------
+proc GeoPhysX::AverageTopoPyramidMerge { } {
+
+   foreach { fld sum } { GPXME GPXPYSUM GPXRMS GPXPYSQ } {
+      fstdfield gridinterp $fld - ACCUM
+      fstdfield copy GPXPYN0 $fld
+      fstdfield gridinterp $fld - NOP True
+      vexpr $fld ifelse((GPXPYN0+GPXPYCNT)>0.0,($fld*GPXPYN0+$sum)/(GPXPYN0+GPXPYCNT),$fld)
+   }
+   fstdfield free GPXPYN0 GPXPYTMP
+}
+
 #----------------------------------------------------------------------------
 # Name     : <GeoPhysX::AverageTopoUSGS>
 # Creation : June 2006 - J.P. Gauthier - CMC/CMOE
@@ -358,7 +963,7 @@ proc GeoPhysX::AverageTopoUSGS { Grid } {
          Log::Print DEBUG "      Processing field : $field"
          fstdfield read USGSTILE GPXTOPOFILE $field
 
-         if { ![llength [set limits [georef intersect [fstdfield define $Grid -georef] [fstdfield define USGSTILE -georef]]]] } {
+         if { ![llength [set limits [georef intersect [fstdfield define [GeoPhysX::TopoCover $Grid] -georef] [fstdfield define USGSTILE -georef]]]] } {
             continue
          }
 
@@ -373,6 +978,9 @@ proc GeoPhysX::AverageTopoUSGS { Grid } {
             fstdfield free WTOPOTILE WEIGHTTILE
          } else {
             fstdfield gridinterp $Grid USGSTILE AVERAGE False         
+            if { $Opt(TopoMosaic)!="" } {
+               fstdfield gridinterp $Opt(TopoMosaic) USGSTILE AVERAGE False
+            }
          }
 
          if { ($GenX::Param(Sub)=="LEGACY") || ($GenX::Param(Z0Topo)=="LEGACY") } {
@@ -401,7 +1009,8 @@ proc GeoPhysX::AverageTopoUSGS { Grid } {
 
    #----- Create source resolution used in destination
    fstdfield gridinterp GPXRMS - ACCUM
-   vexpr GPXRES ifelse((GPXTSK && GPXRMS),900.0,GPXRES)
+   set cov [GeoPhysX::TopoPyramidCount GPXRMS]
+   vexpr GPXRES ifelse((GPXTSK && $cov),900.0,GPXRES)
 }
 
 #----------------------------------------------------------------------------
@@ -429,7 +1038,7 @@ proc GeoPhysX::AverageTopoGTOPO30 { Grid } {
    foreach file [glob $GenX::Param(DBase)/$GenX::Path(GTOPO30)/*.DEM] {
       Log::Print DEBUG "   Processing GTOPO30 file : $file"
       set bands [gdalfile open GTOPO30FILE read $file]
-      if { [llength [set limits [georef intersect [fstdfield define $Grid -georef] [gdalfile georef GTOPO30FILE]]]] } {
+      if { [llength [set limits [georef intersect [fstdfield define [GeoPhysX::TopoCover $Grid] -georef] [gdalfile georef GTOPO30FILE]]]] } {
          gdalband read GTOPO30TILE $bands
          gdalband stats GTOPO30TILE -celldim $GenX::Param(Cell)
 
@@ -445,6 +1054,9 @@ proc GeoPhysX::AverageTopoGTOPO30 { Grid } {
             fstdfield free WTOPOTILE WEIGHTTILE
          } else {
             fstdfield gridinterp $Grid GTOPO30TILE AVERAGE False         
+            if { $Opt(TopoMosaic)!="" } {
+               fstdfield gridinterp $Opt(TopoMosaic) GTOPO30TILE AVERAGE False
+            }
          }
          if { ($GenX::Param(Sub)=="LEGACY") || ($GenX::Param(Z0Topo)=="LEGACY") } {
             fstdfield gridinterp $Grid GTOPO30TILE SUBLINEAR 11
@@ -464,7 +1076,8 @@ proc GeoPhysX::AverageTopoGTOPO30 { Grid } {
 
    #----- Create source resolution used in destination
    fstdfield gridinterp GPXRMS - ACCUM
-   vexpr GPXRES ifelse((GPXTSK && GPXRMS),900.0,GPXRES)
+   set cov [GeoPhysX::TopoPyramidCount GPXRMS]
+   vexpr GPXRES ifelse((GPXTSK && $cov),900.0,GPXRES)
 }
 
 #----------------------------------------------------------------------------
@@ -488,7 +1101,7 @@ proc GeoPhysX::AverageTopoASTERGDEM { Grid } {
    GenX::Procs ASTERGDEM
    Log::Print INFO "Averaging topography using ATSERGDEM database"
 
-   set limits [georef limit [fstdfield define $Grid -georef]]
+   set limits [georef limit [fstdfield define [GeoPhysX::TopoCover $Grid] -georef]]
    set la0 [lindex $limits 0]
    set lo0 [lindex $limits 1]
    set la1 [lindex $limits 2]
@@ -500,6 +1113,9 @@ proc GeoPhysX::AverageTopoASTERGDEM { Grid } {
       gdalband stats ATSERGDEMTILE -nodata -9999 -celldim $GenX::Param(Cell)
 
       fstdfield gridinterp $Grid ATSERGDEMTILE AVERAGE False
+      if { $Opt(TopoMosaic)!="" } {
+         fstdfield gridinterp $Opt(TopoMosaic) ATSERGDEMTILE AVERAGE False
+      }
       if { ($GenX::Param(Sub)=="LEGACY") || ($GenX::Param(Z0Topo)=="LEGACY") } {
          fstdfield gridinterp $Grid ATSERGDEMTILE SUBLINEAR 11
       }
@@ -517,13 +1133,15 @@ proc GeoPhysX::AverageTopoASTERGDEM { Grid } {
 
    #----- Create source resolution used in destination
    fstdfield gridinterp GPXRMS - ACCUM
-   vexpr GPXRES ifelse((GPXTSK && GPXRMS),25,GPXRES)
+   set cov [GeoPhysX::TopoPyramidCount GPXRMS]
+   vexpr GPXRES ifelse((GPXTSK && $cov),25,GPXRES)
 
    #----- Use accumulator to figure out coverage in destination
    #----- But remove border of coverage since it will not be full
    #----- Apply coverage mask for next resolution
    fstdfield gridinterp $Grid - ACCUM
-   vexpr GPXTSK !fpeel($Grid)
+   set cov [GeoPhysX::TopoPyramidCount $Grid]
+   vexpr GPXTSK !fpeel($cov)
    fstdfield stats $Grid -mask GPXTSK
    fstdfield stats GPXRMS -mask GPXTSK
 }
@@ -548,7 +1166,7 @@ proc GeoPhysX::AverageTopoSRTM { Grid {db SRTM} } {
 
    Log::Print INFO "Averaging topography using $db database"
 
-   set limits [georef limit [fstdfield define $Grid -georef]]
+   set limits [georef limit [fstdfield define [GeoPhysX::TopoCover $Grid] -georef]]
    set la0 [lindex $limits 0]
    set lo0 [lindex $limits 1]
    set la1 [lindex $limits 2]
@@ -564,13 +1182,21 @@ proc GeoPhysX::AverageTopoSRTM { Grid {db SRTM} } {
       GenX::Procs SRTM90
    }
 
+   set level [GeoPhysX::TopoPyramidLevel $Grid [expr $d/(30.0*3600.0)]]
+
    foreach file [GenX::SRTMFindFiles $la0 $lo0 $la1 $lo1] {
+      if { $level && [GeoPhysX::AverageTopoPyramid $Grid $file $level] } {
+         continue
+      }
       Log::Print DEBUG "   Processing SRTM file $file"
       gdalband read SRTMTILE [gdalfile open SRTMFILE read $file]
 
       gdalband stats SRTMTILE -celldim $GenX::Param(Cell)
 
       fstdfield gridinterp $Grid SRTMTILE AVERAGE False
+      if { $Opt(TopoMosaic)!="" } {
+         fstdfield gridinterp $Opt(TopoMosaic) SRTMTILE AVERAGE False
+      }
       if { ($GenX::Param(Sub)=="LEGACY") || ($GenX::Param(Z0Topo)=="LEGACY") } {
          fstdfield gridinterp $Grid SRTMTILE SUBLINEAR 11
       }
@@ -588,13 +1214,15 @@ proc GeoPhysX::AverageTopoSRTM { Grid {db SRTM} } {
 
    #----- Create source resolution used in destination
    fstdfield gridinterp GPXRMS - ACCUM
-   vexpr GPXRES ifelse((GPXTSK && GPXRMS),$d,GPXRES)
+   set cov [GeoPhysX::TopoPyramidCount GPXRMS]
+   vexpr GPXRES ifelse((GPXTSK && $cov),$d,GPXRES)
 
    #----- Use accumulator to figure out coverage in destination
    #----- But remove border of coverage since it will not be full
    #----- Apply coverage mask for next resolution
    fstdfield gridinterp $Grid - ACCUM
-   vexpr GPXTSK !fpeel($Grid)
+   set cov [GeoPhysX::TopoPyramidCount $Grid]
+   vexpr GPXTSK !fpeel($cov)
    fstdfield stats $Grid -mask GPXTSK
    fstdfield stats GPXRMS -mask GPXTSK
 }
@@ -620,7 +1248,7 @@ proc GeoPhysX::AverageTopoCDED { Grid { Res 250 } } {
    GenX::Procs CDED
    Log::Print INFO "Averaging topography using CDED(1:${Res}000) database"
 
-   set limits [georef limit [fstdfield define $Grid -georef]]
+   set limits [georef limit [fstdfield define [GeoPhysX::TopoCover $Grid] -georef]]
    set la0 [lindex $limits 0]
    set lo0 [lindex $limits 1]
    set la1 [lindex $limits 2]
@@ -642,6 +1270,9 @@ proc GeoPhysX::AverageTopoCDED { Grid { Res 250 } } {
       }
 
       fstdfield gridinterp $Grid CDEDTILE AVERAGE False
+      if { $Opt(TopoMosaic)!="" } {
+         fstdfield gridinterp $Opt(TopoMosaic) CDEDTILE AVERAGE False
+      }
       if { ($GenX::Param(Sub)=="LEGACY") || ($GenX::Param(Z0Topo)=="LEGACY") } {
          fstdfield gridinterp $Grid CDEDTILE SUBLINEAR 11
       }
@@ -660,13 +1291,15 @@ proc GeoPhysX::AverageTopoCDED { Grid { Res 250 } } {
 
    #----- Create source resolution used in destination
    fstdfield gridinterp GPXRMS - ACCUM
-   vexpr GPXRES ifelse((GPXTSK && GPXRMS),[expr $Res==250?90:25],GPXRES)
+   set cov [GeoPhysX::TopoPyramidCount GPXRMS]
+   vexpr GPXRES ifelse((GPXTSK && $cov),[expr $Res==250?90:25],GPXRES)
 
    #----- Use accumulator to figure out coverage in destination
    #----- But remove border of coverage since it will not be full
    #----- Apply coverage mask for next resolution
    fstdfield gridinterp $Grid - ACCUM
-   vexpr GPXTSK !fpeel($Grid)
+   set cov [GeoPhysX::TopoPyramidCount $Grid]
+   vexpr GPXTSK !fpeel($cov)
    fstdfield stats $Grid -mask GPXTSK
    fstdfield stats GPXRMS -mask GPXTSK
 }
@@ -692,19 +1325,27 @@ proc GeoPhysX::AverageTopoCDEM { Grid } {
    GenX::Procs CDEM
    Log::Print INFO "Averaging topography using CDEM database"
 
-   set limits [georef limit [fstdfield define $Grid -georef]]
+   set limits [georef limit [fstdfield define [GeoPhysX::TopoCover $Grid] -georef]]
    set la0 [lindex $limits 0]
    set lo0 [lindex $limits 1]
    set la1 [lindex $limits 2]
    set lo1 [lindex $limits 3]
    Log::Print DEBUG "   Grid limits are from ($la0,$lo0) to ($la1,$lo1)"
 
+   set level [GeoPhysX::TopoPyramidLevel $Grid [expr 0.75/3600.0]]
+
    foreach file [GenX::CDEMFindFiles $la0 $lo0 $la1 $lo1] {
+      if { $level && [GeoPhysX::AverageTopoPyramid $Grid $file $level] } {
+         continue
+      }
       Log::Print DEBUG "   Processing CDEM file $file"
       gdalband read CDEMTILE [gdalfile open CDEMFILE read $file]
       gdalband stats CDEMTILE -nodata -32767 -celldim $GenX::Param(Cell)
 
       fstdfield gridinterp $Grid CDEMTILE AVERAGE False
+      if { $Opt(TopoMosaic)!="" } {
+         fstdfield gridinterp $Opt(TopoMosaic) CDEMTILE AVERAGE False
+      }
       if { ($GenX::Param(Sub)=="LEGACY") || ($GenX::Param(Z0Topo)=="LEGACY") } {
          fstdfield gridinterp $Grid CDEMTILE SUBLINEAR 11
       }
@@ -722,13 +1363,15 @@ proc GeoPhysX::AverageTopoCDEM { Grid } {
 
    #----- Create source resolution used in destination
    fstdfield gridinterp GPXRMS - ACCUM
-   vexpr GPXRES ifelse((GPXTSK && GPXRMS),25,GPXRES)
+   set cov [GeoPhysX::TopoPyramidCount GPXRMS]
+   vexpr GPXRES ifelse((GPXTSK && $cov),25,GPXRES)
 
    #----- Use accumulator to figure out coverage in destination
    #----- But remove border of coverage since it will not be full
    #----- Apply coverage mask for next resolution
    fstdfield gridinterp $Grid - ACCUM
-   vexpr GPXTSK !fpeel($Grid)
+   set cov [GeoPhysX::TopoPyramidCount $Grid]
+   vexpr GPXTSK !fpeel($cov)
    fstdfield stats $Grid -mask GPXTSK
    fstdfield stats GPXRMS -mask GPXTSK
 }
@@ -765,7 +1408,7 @@ proc GeoPhysX::AverageTopoGMTED2010 { Grid {Res 30} } {
    #----- Open the file
    gdalfile open GMTEDFILE read $GenX::Param(DBase)/$GenX::Path(GMTED2010)/products/mean/mn${Res}_grd.tif
 
-   if { ![llength [set limits [georef intersect [fstdfield define $Grid -georef] [gdalfile georef GMTEDFILE]]]] } {
+   if { ![llength [set limits [georef intersect [fstdfield define [GeoPhysX::TopoCover $Grid] -georef] [gdalfile georef GMTEDFILE]]]] } {
       Log::Print WARNING "Specified grid does not intersect with GMTED2010 database, topo will not be calculated"
    } else {
       Log::Print INFO "Grid intersection with GMTED2010 database is { $limits }"
@@ -790,6 +1433,9 @@ proc GeoPhysX::AverageTopoGMTED2010 { Grid {Res 30} } {
                fstdfield free WTOPOTILE WEIGHTTILE
             } else {
                fstdfield gridinterp $Grid GMTEDTILE AVERAGE False
+               if { $Opt(TopoMosaic)!="" } {
+                  fstdfield gridinterp $Opt(TopoMosaic) GMTEDTILE AVERAGE False
+               }
             }
             if { ($GenX::Param(Sub)=="LEGACY") || ($GenX::Param(Z0Topo)=="LEGACY") } {
                fstdfield gridinterp $Grid GMTEDTILE SUBLINEAR 11
@@ -815,12 +1461,14 @@ proc GeoPhysX::AverageTopoGMTED2010 { Grid {Res 30} } {
       75 { set d  225.0 }
    }
    fstdfield gridinterp GPXRMS - ACCUM
-   vexpr GPXRES ifelse((GPXTSK && GPXRMS),$d,GPXRES)
+   set cov [GeoPhysX::TopoPyramidCount GPXRMS]
+   vexpr GPXRES ifelse((GPXTSK && $cov),$d,GPXRES)
    #----- Use accumulator to figure out coverage in destination
    #----- But remove border of coverage since it will not be full
    #----- Apply coverage mask for next resolution
    fstdfield gridinterp $Grid - ACCUM
-   vexpr GPXTSK !fpeel($Grid)
+   set cov [GeoPhysX::TopoPyramidCount $Grid]
+   vexpr GPXTSK !fpeel($cov)
    fstdfield stats $Grid -mask GPXTSK
    fstdfield stats GPXRMS -mask GPXTSK
 }
@@ -847,19 +1495,24 @@ proc GeoPhysX::AverageTopoFABDEM { Grid } {
    GenX::Procs FABDEM
    Log::Print INFO "Averaging topography using FABDEM database"
 
-   set limits [georef limit [fstdfield define $Grid -georef]]
+   set limits [georef limit [fstdfield define [GeoPhysX::TopoCover $Grid] -georef]]
    set lat0 [lindex $limits 0]
    set lon0 [lindex $limits 1]
    set lat1 [lindex $limits 2]
    set lon1 [lindex $limits 3]
 
    set dbdir  $GenX::Param(DBase)/$GenX::Path(FABDEM)
-   set files [GenX::FindFiles $dbdir/Index/Index.shp $Grid]
+   set files [GenX::FindFiles $dbdir/Index/Index.shp [GeoPhysX::TopoCover $Grid]]
 
    #----- Loop over files
    if { [set nb [llength $files]] } {
 
+      set level [GeoPhysX::TopoPyramidLevel $Grid [expr 1.0/3600.0]]
+
       foreach file $files {
+         if { $level && [GeoPhysX::AverageTopoPyramid $Grid $dbdir/$file $level] } {
+            continue
+         }
          Log::Print DEBUG "   Processing file ([incr n]/$nb) $dbdir/$file"
 
          gdalband read FABDEMTILE [gdalfile open FABDEMFILE read $dbdir/$file]
@@ -875,6 +1528,9 @@ proc GeoPhysX::AverageTopoFABDEM { Grid } {
             fstdfield free WTOPOTILE WEIGHTTILE
          } else {
             fstdfield gridinterp $Grid FABDEMTILE AVERAGE False
+            if { $Opt(TopoMosaic)!="" } {
+               fstdfield gridinterp $Opt(TopoMosaic) FABDEMTILE AVERAGE False
+            }
          }
 
          if { ($GenX::Param(Sub)=="LEGACY") || ($GenX::Param(Z0Topo)=="LEGACY") } {
@@ -896,13 +1552,15 @@ proc GeoPhysX::AverageTopoFABDEM { Grid } {
 
    #----- Create source resolution used in destination
    fstdfield gridinterp GPXRMS - ACCUM
-   vexpr GPXRES ifelse((GPXTSK && GPXRMS),30,GPXRES)
+   set cov [GeoPhysX::TopoPyramidCount GPXRMS]
+   vexpr GPXRES ifelse((GPXTSK && $cov),30,GPXRES)
 
    #----- Use accumulator to figure out coverage in destination
    #----- But remove border of coverage since it will not be full
    #----- Apply coverage mask for next resolution
    fstdfield gridinterp $Grid - ACCUM
-   vexpr GPXTSK !fpeel($Grid)
+   set cov [GeoPhysX::TopoPyramidCount $Grid]
+   vexpr GPXTSK !fpeel($cov)
    fstdfield stats $Grid -mask GPXTSK
    fstdfield stats GPXRMS -mask GPXTSK
 }
@@ -1046,6 +1704,13 @@ if { ! $Opt(SlopOnly) } {
       set res [expr (30.0/3600.0)]  ;# 30 arc-secondes CDED
    }
 
+   #----- Work at a DEM overview resolution if the grid is coarse enough (SRTM and CDEM overviews)
+   set level 0
+   if { $SRTM || $CDEM } {
+      set level [GeoPhysX::PyramidLevel $Grid $res]
+      set res   [expr $res*pow(2,$level)]
+   }
+
    set dpix [expr $GenX::Param(TileSize)*$res]
    Log::Print DEBUG "   Processing limits  $lat0,$lon0 to $lat1,$lon1 at resolution $res"
 
@@ -1086,7 +1751,11 @@ if { ! $Opt(SlopOnly) } {
          #----- Process STRM first, if asked for
          if { $SRTM && [llength [set srtmfiles [GenX::SRTMFindFiles $la0 $lo0 $la1 $lo1]]] } {
             foreach file $srtmfiles {
-               GenX::CacheGet $file -32768
+               if { $level && [file exists [set pfile [GeoPhysX::PyramidFile $file $level]]] } {
+                  set file [GenX::CacheGet $pfile -32768 1]
+               } else {
+                  GenX::CacheGet $file -32768
+               }
                Log::Print DEBUG "      Processing SRTM DEM file $file"
                gdalband gridinterp DEMTILE2 $file NEAREST
                vexpr DEMTILE  "ifelse(DEMTILE2!=$nodata0,DEMTILE2,DEMTILE)"
@@ -1112,7 +1781,11 @@ if { ! $Opt(SlopOnly) } {
          #----- Process CDEM, if asked for
          if { $CDEM && [llength [set cdemfiles [GenX::CDEMFindFiles $la0 $lo0 $la1 $lo1]]] } {
             foreach file $cdemfiles {
-               GenX::CacheGet $file -32767
+               if { $level && [file exists [set pfile [GeoPhysX::PyramidFile $file $level]]] } {
+                  set file [GenX::CacheGet $pfile -32767 1]
+               } else {
+                  GenX::CacheGet $file -32767
+               }
                Log::Print DEBUG "      Processing CDEM DEM file $file"
                gdalband gridinterp DEMTILE2 $file NEAREST
             }
@@ -1242,8 +1915,8 @@ if { ! $Opt(SlopOnly) } {
 
 # filters out border artifact on lakes and Ocean, when other Topo are mixed with CDED or CDEM
 #
-   if { [llength [set idx [fstdfield find GPXOUTFILE -1 "" -1 -1 -1 "" "MG"]]] } {
-      fstdfield read GPXMG GPXOUTFILE $idx
+   if { [llength [set idx [GenX::FieldFind GPXOUTFILE -1 "" -1 -1 -1 "" "MG"]]] } {
+      GenX::FieldRead GPXMG GPXOUTFILE $idx
       vexpr  GPXSLA  "ifelse(GPXMG==0,0.0,GPXSLA)"
 if { ! $Opt(SlopOnly) } {
       vexpr  GPXFSA  "ifelse(GPXMG==0,-1.0,GPXFSA)"
@@ -1265,7 +1938,7 @@ if { ! $Opt(SlopOnly) } {
 
    #----- Save everything
    fstdfield define GPXSLOP -NOMVAR SLOP -ETIKET $GenX::Param(ETIKET) -IP2 0
-   fstdfield write GPXSLOP GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXSLOP GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 if { ! $Opt(SlopOnly) } {
    fstdfield define GPXFSA  -NOMVAR FSA0 -ETIKET $GenX::Param(ETIKET) -IP2 0
    fstdfield define GPXFSAN -NOMVAR FSA  -ETIKET $GenX::Param(ETIKET) -IP2 0
@@ -1279,17 +1952,17 @@ if { ! $Opt(SlopOnly) } {
    fstdfield define GPXSLAS -NOMVAR SLA  -ETIKET $GenX::Param(ETIKET) -IP2 180
    fstdfield define GPXSLAW -NOMVAR SLA  -ETIKET $GenX::Param(ETIKET) -IP2 270
 
-   fstdfield write GPXFSA  GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-   fstdfield write GPXFSAN GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-   fstdfield write GPXFSAE GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-   fstdfield write GPXFSAS GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-   fstdfield write GPXFSAW GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-
-   fstdfield write GPXSLA  GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-   fstdfield write GPXSLAN GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-   fstdfield write GPXSLAE GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-   fstdfield write GPXSLAS GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-   fstdfield write GPXSLAW GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXFSA  GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXFSAN GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXFSAE GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXFSAS GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXFSAW GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+
+   GenX::FieldWrite GPXSLA  GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXSLAN GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXSLAE GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXSLAS GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXSLAW GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 }
 
    fstdfield free GPXSLA GPXSLAN GPXSLAE GPXSLAS GPXSLAW GPXFSA GPXFSAN GPXFSAE GPXFSAS GPXFSAW GPXSLOP
@@ -1474,7 +2147,7 @@ proc GeoPhysX::AverageMaskUSGS { Grid } {
    fstdfield gridinterp GPXMASK - NOP True
    vexpr GPXMASK ifelse(GPXMASK==-99.0,0.0,GPXMASK/100.0)
    fstdfield define GPXMASK -NOMVAR MG -ETIKET $GenX::Param(ETIKET) -IP1 0 -DATYP $GenX::Param(Datyp)
-   fstdfield write GPXMASK GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXMASK GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
    fstdfield free MASKTILE
 }
 
@@ -1517,7 +2190,7 @@ proc GeoPhysX::AverageMaskUSNavy { Grid } {
    fstdfield gridinterp GPXMASK - NOP True
    vexpr GPXMASK ifelse(GPXMASK==-99.0,0.0,GPXMASK/100.0)
    fstdfield define GPXMASK -NOMVAR MG -ETIKET $GenX::Param(ETIKET) -IP1 0 -DATYP $GenX::Param(Datyp)
-   fstdfield write GPXMASK GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXMASK GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
    fstdfield free MASKTILE
 }
 
@@ -1570,7 +2243,7 @@ proc GeoPhysX::AverageMaskGLOBCOVER { Grid } {
       #----- Save output
       fstdfield gridinterp GPXMASK - NOP True
       fstdfield define GPXMASK -NOMVAR MG -ETIKET $GenX::Param(ETIKET) -IP1 0 -DATYP $GenX::Param(Datyp)
-      fstdfield write GPXMASK GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXMASK GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
       fstdfield free MASKTILE
 
       gdalband free GLOBTILE
@@ -1627,7 +2300,7 @@ proc GeoPhysX::AverageMaskGLC2000 { Grid } {
       #----- Save output
       fstdfield gridinterp GPXMASK - NOP True
       fstdfield define GPXMASK -NOMVAR MG -ETIKET $GenX::Param(ETIKET) -IP1 0 -DATYP $GenX::Param(Datyp)
-      fstdfield write GPXMASK GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXMASK GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
 
       gdalband free GCLTILE
    }
@@ -1661,9 +2334,9 @@ proc GeoPhysX::AverageMaskCANVEC { Grid } {
 #
    set has_fallback [GetFallbackMask $Grid GPXMGFB]
 
-   if { [llength [set idx [fstdfield find GPXAUXFILE -1 "" -1 -1 -1 "" "MGGO"]]] } {
+   if { [llength [set idx [GenX::FieldFind GPXAUXFILE -1 "" -1 -1 -1 "" "MGGO"]]] } {
       Log::Print INFO "Found previous MGGO field, will use it."
-      fstdfield read GPXMASK GPXAUXFILE $idx
+      GenX::FieldRead GPXMASK GPXAUXFILE $idx
    } else {
       Log::Print INFO "Cannot find previous MGGO field, rasterizing it."
 
@@ -1687,7 +2360,7 @@ proc GeoPhysX::AverageMaskCANVEC { Grid } {
 
    #----- Save a geographic mask with a nodata value
    fstdfield define GPXMASK -NOMVAR MGGO -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0 -DATYP $GenX::Param(Datyp)
-   fstdfield write GPXMASK GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXMASK GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
 
    }
    
@@ -1711,7 +2384,7 @@ proc GeoPhysX::AverageMaskCANVEC { Grid } {
    }
 
    fstdfield define GPXMASK -NOMVAR MG -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0 -DATYP $GenX::Param(Datyp)
-   fstdfield write GPXMASK GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXMASK GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
 
    ogrlayer free USLAKES CANVECTILE
 }
@@ -1825,21 +2498,21 @@ proc GeoPhysX::AverageMaskCCI_LC { Grid  dbid } {
       #----- Save output
       fstdfield gridinterp GPXMASK - NOP True
       fstdfield define GPXMASK -NOMVAR MG -ETIKET $GenX::Param(ETIKET) -IP1 0 -DATYP $GenX::Param(Datyp)
-      fstdfield write GPXMASK GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXMASK GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
       fstdfield free GPXMASK
 
       if { $has_mask_VF1 } {
          fstdfield gridinterp GPXVF1MG - NOP True
          fstdfield define GPXVF1MG -NOMVAR VF -ETIKET $GenX::Param(ETIKET) -IP1 1199 -DATYP $GenX::Param(Datyp)
-         fstdfield write GPXVF1MG GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+         GenX::FieldWrite GPXVF1MG GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
          fstdfield free GPXVF1MG
          fstdfield gridinterp GPXVF21MG - NOP True
          fstdfield define GPXVF21MG -NOMVAR VF -ETIKET $GenX::Param(ETIKET) -IP1 1179 -DATYP $GenX::Param(Datyp)
-         fstdfield write GPXVF21MG GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+         GenX::FieldWrite GPXVF21MG GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
          fstdfield free GPXVF21MG
          fstdfield gridinterp GPXVF3MG - NOP True
          fstdfield define GPXVF3MG -NOMVAR VF -ETIKET $GenX::Param(ETIKET) -IP1 1197 -DATYP $GenX::Param(Datyp)
-         fstdfield write GPXVF3MG GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+         GenX::FieldWrite GPXVF3MG GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
          fstdfield free GPXVF3MG
       }
       gdalband free CCITILE
@@ -1896,7 +2569,7 @@ proc GeoPhysX::AverageMaskUSGS_R { Grid } {
       #----- Save output
       fstdfield gridinterp GPXMASK - NOP True
       fstdfield define GPXMASK -NOMVAR MG -ETIKET $GenX::Param(ETIKET) -IP1 0 -DATYP $GenX::Param(Datyp)
-      fstdfield write GPXMASK GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXMASK GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
       fstdfield free MASKTILE
 
       gdalband free USGSTILE
@@ -1985,7 +2658,7 @@ proc GeoPhysX::AverageMaskAAFC { Grid } {
       #----- Save output
       fstdfield gridinterp GPXMASK - NOP True
       fstdfield define GPXMASK -NOMVAR MG -ETIKET $GenX::Param(ETIKET) -IP1 0 -DATYP $GenX::Param(Datyp)
-      fstdfield write GPXMASK GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXMASK GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
       fstdfield free MASKTILE
    } else {
       Log::Print WARNING "The grid is not within AAFC limits"
@@ -2062,7 +2735,7 @@ proc GeoPhysX::AverageMaskNALCMS { Grid } {
       #----- Save output
       fstdfield gridinterp GPXMASK - NOP True
       fstdfield define GPXMASK -NOMVAR MG -ETIKET $GenX::Param(ETIKET) -IP1 0 -DATYP $GenX::Param(Datyp)
-      fstdfield write GPXMASK GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXMASK GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
       fstdfield free MASKTILE
    } else {
       Log::Print WARNING "The grid is not within NALCMS limits"
@@ -2132,7 +2805,7 @@ proc GeoPhysX::AverageMaskOSM { Grid } {
 
    if { $GenX::Param(AddHydroLakesToMask) } {
       if { [catch {
-         fstdfield read GPXLAKEF   GPXAUXFILE -1 "" -1   -1 -1 "" "LACF"
+         GenX::FieldRead GPXLAKEF   GPXAUXFILE -1 "" -1   -1 -1 "" "LACF"
          } ] } {
          Log::Print INFO "LACF field not found, will generate it using HydroLakes"
          fstdfield copy GPXLAKEF $Grid
@@ -2150,15 +2823,15 @@ proc GeoPhysX::AverageMaskOSM { Grid } {
 
    #----- Save output
    fstdfield define GPXMASK -NOMVAR MG -ETIKET $GenX::Param(ETIKET) -IP1 0 -DATYP $GenX::Param(Datyp)
-   fstdfield write GPXMASK GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXMASK GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
    fstdfield free MASKTILE
 
    fstdfield define GPXVF3 -NOMVAR VF -ETIKET $GenX::Param(ETIKET) -IP1 [expr 1200-3] -DATYP $GenX::Param(Datyp)
-   fstdfield write GPXVF3 GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXVF3 GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
    fstdfield free GPXVF3
 
    fstdfield define GPXVF1 -NOMVAR VF -ETIKET $GenX::Param(ETIKET) -IP1 [expr 1200-1] -DATYP $GenX::Param(Datyp)
-   fstdfield write GPXVF1 GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXVF1 GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
    fstdfield free GPXVF1
 }
 
@@ -2219,7 +2892,7 @@ proc GeoPhysX::AverageGeoMaskCANADA { Grid } {
    ogrfile close CANPROVFILE
 
    fstdfield define GPXMASK -NOMVAR MGGO -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0 -DATYP $GenX::Param(Datyp)
-   fstdfield write GPXMASK GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXMASK GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
 
    ogrlayer free CANPROV
 }
@@ -2265,8 +2938,8 @@ proc GeoPhysX::GetFallbackMask { Grid MGFB } {
             set old_maskid $GenX::Param(Mask)
             set GenX::Param(Mask) $GenX::Param(FallbackMask)
             GeoPhysX::AverageMask $Grid
-            if { [llength [set idx [fstdfield find GPXOUTFILE -1 "" -1 -1 -1 "" "MG"]]] } {
-               fstdfield read $MGFB GPXOUTFILE $idx
+            if { [llength [set idx [GenX::FieldFind GPXOUTFILE -1 "" -1 -1 -1 "" "MG"]]] } {
+               GenX::FieldRead $MGFB GPXOUTFILE $idx
                Log::Print INFO "Got a fallback mask field"
                set has_fallback  1
             }
@@ -2369,7 +3042,7 @@ proc GeoPhysX::AverageVege { Grid } {
    #----- Save the 26 Vege types
    fstdfield define GPXVF -NOMVAR VF -ETIKET $GenX::Param(ETIKET) -IP2 0 -DATYP $GenX::Param(Datyp)
    fstdfield stats GPXVF -levels $Param(VegeTypes) -leveltype UNDEFINED
-   fstdfield write GPXVF GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXVF GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
 
    fstdfield free GPXVF
 }
@@ -3229,13 +3902,13 @@ proc GeoPhysX::AverageVCH { Grid {do_z0vh 0} } {
 
    #----- Save output
    fstdfield define GPXVCH -NOMVAR VCH -ETIKET $GenX::Param(ETIKET) -IP1 0
-   fstdfield write GPXVCH GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXVCH GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
 
    if { $do_z0vh } {
       Log::Print INFO "Saving Z0VH to GPXAUXFILE"
       vexpr GPXZ0VH ifelse(GPXLNZ0>-99.0,exp(GPXLNZ0),0.0)
       fstdfield define GPXZ0VH -NOMVAR Z0VH -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-      fstdfield write GPXZ0VH GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXZ0VH GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
       fstdfield free GPXZ0VH
       fstdfield free GPXLNZ0
    }
@@ -3301,7 +3974,7 @@ proc GeoPhysX::AverageGSRS_DBRK { Grid } {
    #----- Save output
    fstdfield gridinterp GPXDBRK - NOP True
    fstdfield define GPXDBRK -NOMVAR DBRK -ETIKET $GenX::Param(ETIKET) -IP1 0
-   fstdfield write GPXDBRK GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXDBRK GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
    fstdfield free GPXDBRK
 }
 
@@ -3520,7 +4193,7 @@ proc GeoPhysX::AverageMaskMCD12Q1 { Grid } {
    #----- Save output
    fstdfield gridinterp GPXMASK - NOP True
    fstdfield define GPXMASK -NOMVAR MG -ETIKET $GenX::Param(ETIKET) -IP1 0 -DATYP $GenX::Param(Datyp)
-   fstdfield write GPXMASK GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXMASK GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
 
    fstdfield free GPXMASK
 }
@@ -3686,7 +4359,7 @@ proc GeoPhysX::AverageSand { Grid } {
       fstdfield stats GPXJ1 -mask ""
       #----- Save output
       fstdfield define GPXJ1 -NOMVAR J1 -ETIKET $GenX::Param(ETIKET) -IP1 [expr 1200-$type] -DATYP $GenX::Param(Datyp)
-      fstdfield write GPXJ1 GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXJ1 GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
    }
    fstdfield free SANDTILE GPXJ1 GPXJ1SK
 }
@@ -3743,7 +4416,7 @@ proc GeoPhysX::AverageSoilJPL { Grid } {
       #----- Save output (Same for all layers)
       foreach type $Param(SandTypes) {
          fstdfield define GPXJ1 -NOMVAR J1 -ETIKET $GenX::Param(ETIKET) -IP1 [expr 1200-$type] -DATYP $GenX::Param(Datyp)
-         fstdfield write GPXJ1 GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+         GenX::FieldWrite GPXJ1 GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
       }
       gdalband free JPLTILE
    }
@@ -3777,7 +4450,7 @@ proc GeoPhysX::AverageSoilJPL { Grid } {
       #----- Save output (Same for all layers)
       foreach type $Param(SandTypes) {
          fstdfield define GPXJ2 -NOMVAR J2 -ETIKET $GenX::Param(ETIKET) -IP1 [expr 1200-$type] -DATYP $GenX::Param(Datyp)
-         fstdfield write GPXJ2 GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+         GenX::FieldWrite GPXJ2 GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
       }
       gdalband free JPLTILE
    }
@@ -3907,11 +4580,11 @@ proc GeoPhysX::AverageSoilHWSD { Grid } {
    fstdfield define GPXBULKT -NOMVAR J4 -ETIKET $GenX::Param(ETIKET) -IP1 1199 -DATYP $GenX::Param(Datyp)
    fstdfield define GPXOCT   -NOMVAR SOC -ETIKET $GenX::Param(ETIKET) -IP1 1199 -DATYP $GenX::Param(Datyp)
 
-   fstdfield write GPXSANDT GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-   fstdfield write GPXCLAYT GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-   fstdfield write GPXGRAVT GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-   fstdfield write GPXBULKT GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-   fstdfield write GPXOCT   GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXSANDT GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXCLAYT GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXGRAVT GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXBULKT GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXOCT   GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    #----- Copy sub-surface data into 4 layers (needed by GEM)
    foreach ip1 { 1198 1197 1196 1195 } {
@@ -3921,11 +4594,11 @@ proc GeoPhysX::AverageSoilHWSD { Grid } {
       fstdfield define GPXBULKS -NOMVAR J4 -ETIKET $GenX::Param(ETIKET) -IP1 $ip1 -DATYP $GenX::Param(Datyp)
       fstdfield define GPXOCS   -NOMVAR SOC -ETIKET $GenX::Param(ETIKET) -IP1 $ip1 -DATYP $GenX::Param(Datyp)
 
-      fstdfield write GPXSANDS GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-      fstdfield write GPXCLAYS GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-      fstdfield write GPXGRAVS GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-      fstdfield write GPXBULKS GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-      fstdfield write GPXOCS   GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXSANDS GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXCLAYS GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXGRAVS GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXBULKS GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXOCS   GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    }
 
    vector free HWSDTABLE
@@ -3969,8 +4642,8 @@ proc GeoPhysX::AverageSoilBNU { Grid } {
    set Param(ClayTypes)    { 1 2 3 4 5 6 7 8 }
 
    #----- Read mask
-   if { [llength [set idx [fstdfield find GPXOUTFILE -1 "" -1 -1 -1 "" "MG"]]] } {
-      fstdfield read GPXMG GPXOUTFILE $idx
+   if { [llength [set idx [GenX::FieldFind GPXOUTFILE -1 "" -1 -1 -1 "" "MG"]]] } {
+      GenX::FieldRead GPXMG GPXOUTFILE $idx
       set has_MG 1
    } else {
       Log::Print WARNING "Could not find mask field MG"
@@ -4037,8 +4710,8 @@ proc GeoPhysX::AverageSoilHydraulic { Grid } {
    fstdfield copy GPXHFLD $Grid
 
    #----- Read mask
-   if { [llength [set idx [fstdfield find GPXOUTFILE -1 "" -1 -1 -1 "" "MG"]]] } {
-      fstdfield read GPXMG GPXOUTFILE $idx
+   if { [llength [set idx [GenX::FieldFind GPXOUTFILE -1 "" -1 -1 -1 "" "MG"]]] } {
+      GenX::FieldRead GPXMG GPXOUTFILE $idx
       set has_MG 1
    } else {
       Log::Print WARNING "Could not find mask field MG"
@@ -4086,14 +4759,14 @@ proc GeoPhysX::AverageSoilCANSIS { Grid } {
    fstdfield copy GPXJ $Grid
 
    #----- Read mask
-   if { [llength [set idx [fstdfield find GPXOUTFILE -1 "" -1 -1 -1 "" "MG"]]] } {
-      fstdfield read GPXMG GPXOUTFILE $idx
+   if { [llength [set idx [GenX::FieldFind GPXOUTFILE -1 "" -1 -1 -1 "" "MG"]]] } {
+      GenX::FieldRead GPXMG GPXOUTFILE $idx
       set has_MG 1
    } else {
       Log::Print WARNING "Could not find mask field MG"
       set has_MG 0
    }
-#   fstdfield read GPXMG   GPXOUTFILE -1 "" -1 -1 -1 "" "MG"
+#   GenX::FieldRead GPXMG   GPXOUTFILE -1 "" -1 -1 -1 "" "MG"
 
    set files  {}
    lappend files $GenX::Param(DBase)/$GenX::Path(CANSIS)/NA_RANDOM_SAND1_1KM.tif
@@ -4105,7 +4778,7 @@ proc GeoPhysX::AverageSoilCANSIS { Grid } {
    set n   [expr [llength $types] + 1]
    for { set type $n } { $type <= $nst } { incr type }  {
       fstdfield define GPXJ -NOMVAR J1 -ETIKET $GenX::Param(ETIKET) -IP1 [expr 1200-$type] -DATYP $GenX::Param(Datyp)
-      fstdfield write GPXJ GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXJ GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
    }
 
    set files  {}
@@ -4118,7 +4791,7 @@ proc GeoPhysX::AverageSoilCANSIS { Grid } {
    set n   [expr [llength $types] + 1]
    for { set type $n } { $type <= $nct } {incr type } {
       fstdfield define GPXJ -NOMVAR J2 -ETIKET $GenX::Param(ETIKET) -IP1 [expr 1200-$type] -DATYP $GenX::Param(Datyp)
-      fstdfield write GPXJ GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXJ GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
    }
 
    set files {}
@@ -4163,8 +4836,8 @@ proc GeoPhysX::AverageSoilGriddedSLC { Grid } {
    set  Param(ClayTypes)    { 1 2 3 4 5 6 }
 
    #----- Read mask
-   if { [llength [set idx [fstdfield find GPXOUTFILE -1 "" -1 -1 -1 "" "MG"]]] } {
-      fstdfield read GPXMG GPXOUTFILE $idx
+   if { [llength [set idx [GenX::FieldFind GPXOUTFILE -1 "" -1 -1 -1 "" "MG"]]] } {
+      GenX::FieldRead GPXMG GPXOUTFILE $idx
       set has_MG 1
    } else {
       Log::Print WARNING "Could not find mask field MG"
@@ -4257,14 +4930,14 @@ proc GeoPhysX::AverageSoilGriddedSLC { Grid } {
       set type  1
       foreach attrib $sands {
          fstdfield define GPXJ1${attrib} -NOMVAR J1 -IP1 [expr 1200-$type] -ETIKET "$etiket"
-         fstdfield write GPXJ1${attrib} GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+         GenX::FieldWrite GPXJ1${attrib} GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
          fstdfield free GPXJ1${attrib}
          incr type
       }
       set type  1
       foreach attrib $clays {
          fstdfield define GPXJ2${attrib} -NOMVAR J2 -IP1 [expr 1200-$type] -ETIKET "$etiket"
-         fstdfield write GPXJ2${attrib} GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+         GenX::FieldWrite GPXJ2${attrib} GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
          fstdfield free GPXJ2${attrib}
          incr type
       }
@@ -4313,8 +4986,8 @@ proc GeoPhysX::AverageSoil_SoilGrids { Grid } {
    set Param(ClayTypes)    { 1 2 3 4 5 6 7 }
 
    #----- Read mask
-   if { [llength [set idx [fstdfield find GPXOUTFILE -1 "" -1 -1 -1 "" "MG"]]] } {
-      fstdfield read GPXMG GPXOUTFILE $idx
+   if { [llength [set idx [GenX::FieldFind GPXOUTFILE -1 "" -1 -1 -1 "" "MG"]]] } {
+      GenX::FieldRead GPXMG GPXOUTFILE $idx
       set has_MG 1
    } else {
       Log::Print WARNING "Could not find mask field MG"
@@ -4395,22 +5068,33 @@ proc GeoPhysX::AverageSoil_SoilGridsV2 { Grid } {
    set Scale(ocd)        "10.0"
 
    #----- Read mask
-   if { [llength [set idx [fstdfield find GPXOUTFILE -1 "" -1 -1 -1 "" "MG"]]] } {
-      fstdfield read GPXMG GPXOUTFILE $idx
+   if { [llength [set idx [GenX::FieldFind GPXOUTFILE -1 "" -1 -1 -1 "" "MG"]]] } {
+      GenX::FieldRead GPXMG GPXOUTFILE $idx
       set has_MG 1
    } else {
       Log::Print WARNING "Could not find mask field MG"
       set has_MG 0
    }
 
+   set all {}
    foreach prefix $Param(SoilGridsV2_Soils) {
-      set files {}
-      set scal $Scale($prefix)
+      set files($prefix) {}
       foreach layer $layers {
          set sgfile "$GenX::Param(DBase)/$GenX::Path(SOILGRIDS2)/${prefix}_${layer}cm_mean.tif"
-         lappend files $sgfile
+         lappend files($prefix) $sgfile
       }
-      GeoPhysX::AverageRastersFiles2rpnGrid GPXJ $files $varname($prefix) $scal -9999 $has_MG  "$GenX::Param(ETIKET)" "$desc($prefix) Percentage"
+      set all [concat $all $files($prefix)]
+   }
+
+   #----- The layers of all properties are co-registered, average them all in a single pass
+   set stack [GeoPhysX::AverageRasterStack GPXJ $all -9999]
+
+   set n 0
+   foreach prefix $Param(SoilGridsV2_Soils) {
+      set scal $Scale($prefix)
+      set flds [lrange $stack $n [expr $n+[llength $layers]-1]]
+      GeoPhysX::AverageRastersFiles2rpnGrid GPXJ $files($prefix) $varname($prefix) $scal -9999 $has_MG  "$GenX::Param(ETIKET)" "$desc($prefix) Percentage" 1 "" $flds
+      incr n [llength $layers]
    }
 
    fstdfield free GPXMG GPXJ
@@ -4481,22 +5165,22 @@ proc GeoPhysX::AverageTreeCover { Grid } {
       }
       vexpr  GPXCCG  "GPXCCG * 0.01"
       fstdfield define GPXCCG -NOMVAR $nomvar -ETIKET $GenX::Param(ETIKET) -IP1 0 -DATYP $GenX::Param(Datyp)
-      fstdfield write GPXCCG GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXCCG GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    }
 
    #----- check for needed fields
    foreach type {4 5 6 7 8 9 25 26} {
-      if { ![catch { fstdfield read GPXVF GPXAUXFILE -1 "" [expr 1200-$type] -1 -1 "" "VF" }] } {
+      if { ![catch { GenX::FieldRead GPXVF GPXAUXFILE -1 "" [expr 1200-$type] -1 -1 "" "VF" }] } {
          vexpr GPXVFH  GPXVFH+GPXVF
       } else {
          Log::Print WARNING "Could not find VF($type) field while processing High Vegetation field"
       }
    }
 
-   fstdfield read GPXVF1   GPXAUXFILE -1 ""  1199  -1 -1 "" "VF"
-   fstdfield read GPXVF2   GPXAUXFILE -1 ""  1198  -1 -1 "" "VF"
-   fstdfield read GPXVF3   GPXAUXFILE -1 ""  1197  -1 -1 "" "VF"
-   fstdfield read GPXVF21  GPXAUXFILE -1 ""  1179  -1 -1 "" "VF"
+   GenX::FieldRead GPXVF1   GPXAUXFILE -1 ""  1199  -1 -1 "" "VF"
+   GenX::FieldRead GPXVF2   GPXAUXFILE -1 ""  1198  -1 -1 "" "VF"
+   GenX::FieldRead GPXVF3   GPXAUXFILE -1 ""  1197  -1 -1 "" "VF"
+   GenX::FieldRead GPXVF21  GPXAUXFILE -1 ""  1179  -1 -1 "" "VF"
 
    vexpr GPXVFNT  "GPXVF1+GPXVF3+GPXVF2+GPXVF21"
 
@@ -4504,12 +5188,12 @@ proc GeoPhysX::AverageTreeCover { Grid } {
    vexpr GPXCCL  "ifelse(GPXVFH>0.0,GPXCCL,0.0)"
 
    fstdfield define GPXCCL -NOMVAR CCL -ETIKET $GenX::Param(ETIKET) -IP1 0 -DATYP $GenX::Param(Datyp)
-   fstdfield write GPXCCL GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXCCL GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    fstdfield define GPXVFNT -NOMVAR VFNT -ETIKET $GenX::Param(ETIKET) -IP1 0 -DATYP $GenX::Param(Datyp)
-   fstdfield write GPXVFNT GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXVFNT GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    fstdfield define GPXVFH -NOMVAR VFH -ETIKET $GenX::Param(ETIKET) -IP1 0 -DATYP $GenX::Param(Datyp)
-   fstdfield write GPXVFH GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXVFH GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    fstdfield free GPXCCL GPXCCG GPXCCNW GPXVFNT GPXVFH GPXVF1 GPXVF2 GPXVF3 GPXVF21
 
 }
@@ -4554,7 +5238,7 @@ proc GeoPhysX::AverageGeoidHeight { Grid } {
    GeoPhysX::AverageIndexedBands  GPXGH  $GenX::Param(EGMGH) "$GenX::Param(DBase)/$GenX::Path(EGMGH)/data"
 
    fstdfield define GPXGH -NOMVAR GH -ETIKET $GenX::Param(ETIKET) -IP1 0 -DATYP $GenX::Param(Datyp)
-   fstdfield write GPXGH GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXGH GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    fstdfield free GPXGH
 }
 
@@ -4589,14 +5273,14 @@ proc GeoPhysX::AverageBathymetry { Grid } {
    #----- check for needed fields
    set Has_TOPO 1
    if { [catch {
-      fstdfield read GPXTOPO   GPXOUTFILE -1 "" -1   -1 -1 "" "MENF"
+      GenX::FieldRead GPXTOPO   GPXOUTFILE -1 "" -1   -1 -1 "" "MENF"
       } ] } {
       Log::Print WARNING "Missing topo field"
       set Has_TOPO 0
    }
    set Has_MG 1
    if { [catch {
-      fstdfield read GPXMG   GPXOUTFILE -1 "" -1   -1 -1 "" "MG"
+      GenX::FieldRead GPXMG   GPXOUTFILE -1 "" -1   -1 -1 "" "MG"
       } ] } {
       set Has_MG 0
    }
@@ -4612,8 +5296,8 @@ proc GeoPhysX::AverageBathymetry { Grid } {
 
    set Has_HL 1
    if { [catch {
-      fstdfield read GPXLAKED   GPXAUXFILE -1 "" -1   -1 -1 "" "LACD"
-      fstdfield read GPXLAKEF   GPXAUXFILE -1 "" -1   -1 -1 "" "LACF"
+      GenX::FieldRead GPXLAKED   GPXAUXFILE -1 "" -1   -1 -1 "" "LACD"
+      GenX::FieldRead GPXLAKEF   GPXAUXFILE -1 "" -1   -1 -1 "" "LACF"
       Log::Print INFO "Will use existing LAKED and LAKEF"
       } ] } {
       set Has_HL 0
@@ -4630,13 +5314,13 @@ proc GeoPhysX::AverageBathymetry { Grid } {
          HydroX::HydroLakesDepth $Grid GPXLAKEF GPXLAKED GPXLAKES GPXLAKEG
    
          fstdfield define GPXLAKED -NOMVAR LACD -IP1 1200 -DATYP $GenX::Param(Datyp) -ETIKET $GenX::Param(ETIKET)
-         fstdfield write GPXLAKED GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+         GenX::FieldWrite GPXLAKED GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
          fstdfield define GPXLAKEF -NOMVAR LACF -IP1 1200 -DATYP $GenX::Param(Datyp) -ETIKET $GenX::Param(ETIKET)
-         fstdfield write GPXLAKEF GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+         GenX::FieldWrite GPXLAKEF GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
          fstdfield define GPXLAKES -NOMVAR LACS -IP1 1200 -DATYP $GenX::Param(Datyp) -ETIKET $GenX::Param(ETIKET)
-         fstdfield write GPXLAKES GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+         GenX::FieldWrite GPXLAKES GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
          fstdfield define GPXLAKEG -NOMVAR LACG -IP1 1200 -DATYP $GenX::Param(Datyp) -ETIKET $GenX::Param(ETIKET)
-         fstdfield write GPXLAKEG GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+         GenX::FieldWrite GPXLAKEG GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    
          fstdfield free GPXLAKEA GPXLAKES GPXLAKEG
          set Has_HL  1
@@ -4700,10 +5384,10 @@ proc GeoPhysX::AverageBathymetry { Grid } {
    }
 
    fstdfield define GPXBATHY -NOMVAR BMSL -IP1 1200 -DATYP $GenX::Param(Datyp) -ETIKET $GenX::Param(ETIKET)
-   fstdfield write GPXBATHY GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXBATHY GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    fstdfield define GPXDEPTH -NOMVAR DEEP -IP1 1200 -DATYP $GenX::Param(Datyp) -ETIKET $GenX::Param(ETIKET)
-   fstdfield write GPXDEPTH GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXDEPTH GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    #----- Save output
 
@@ -4884,6 +5568,73 @@ proc GeoPhysX::AverageIndexedBands { Grid dbname basedir {CALLPROCFLD ""} {nodat
    }
 }
 
+#----------------------------------------------------------------------------
+# Name     : <GeoPhysX::AverageRasterStack>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Average every band of a set of co-registered raster files
+#            in a single pass over the rasters
+#
+# Parameters :
+#   <Grid>   : Grid on which to generate the fields
+#   <files>  : Raster files, all on the same pixel grid
+#   <nodata> : Nodata value of the bands that do not define one
+#
+# Return:
+#   <fields> : Averaged fields, one per band in file order, or an empty list
+#              if the stack could not be averaged in a single pass
+#
+# Remarks :
+#    - The pixels are mapped to the grid cells once per tile for all bands instead
+#      of once per band, which is what dominates the per band gridinterp loop
+#    - Only point cells (-celldim 1) are supported, the callers fall back to
+#      gridinterp otherwise
+#----------------------------------------------------------------------------
+proc GeoPhysX::AverageRasterStack { Grid files nodata } {
+   variable Param
+
+   if { $GenX::Param(Cell)!=1 || ![llength $files] } {
+      return {}
+   }
+
+   #----- Check the intersection and band count on the first file, the kernel checks the co-registration
+   set nb 0
+   foreach file $files {
+      if { [catch { set bands [gdalfile open BFRFILE read $file] }] } {
+         return {}
+      }
+      if { !$nb } {
+         set limits [georef intersect [fstdfield define $Grid -georef] [gdalfile georef BFRFILE]]
+      }
+      incr nb [llength $bands]
+      gdalfile close BFRFILE
+   }
+
+   #----- Sums, counts and output fields take 16 bytes per band and grid point
+   set mem [expr 16.0*$nb*[fstdfield define $Grid -NI]*[fstdfield define $Grid -NJ]/1048576.0]
+   if { $mem>$Param(RasterStackMem) } {
+      Log::Print DEBUG "Raster stack of $nb bands needs [format %.0f $mem] MB, over the $Param(RasterStackMem) MB budget"
+      return {}
+   }
+
+   set fields {}
+   for { set b 0 } { $b<$nb } { incr b } {
+      fstdfield copy GPXRAS$b $Grid
+      lappend fields GPXRAS$b
+   }
+   GenX::GridClear $fields 0.0
+
+   if { [llength $limits] } {
+      Log::Print INFO "Averaging $nb bands in a single pass over { $limits }"
+      if { [catch { geophy rasteraverage $fields $files $nodata $limits $GenX::Param(TileSize) } msg] } {
+         Log::Print WARNING "Single pass raster averaging failed, using per band averaging ($msg)"
+         eval fstdfield free $fields
+         return {}
+      }
+   }
+   return $fields
+}
+
 #----------------------------------------------------------------------------
 # Name     : <GeoPhysX::AverageRastersFiles2rpnGrid>
 # Creation : June 2014 
@@ -4893,13 +5644,15 @@ proc GeoPhysX::AverageIndexedBands { Grid dbname basedir {CALLPROCFLD ""} {nodat
 #
 # Parameters :
 #   <Grid>   : Grid on which to generate the fields
+#   <stack>  : Fields already averaged by GeoPhysX::AverageRasterStack (optional)
 #
 # Return:
 #
 # Remarks :
+#    - Without a callback, the bands are averaged in a single pass if possible
 #
 #----------------------------------------------------------------------------
-proc GeoPhysX::AverageRastersFiles2rpnGrid { Grid files varname scal nodata has_MG etiket description {write_fld 1} {CALLPROCFLD ""} } {
+proc GeoPhysX::AverageRastersFiles2rpnGrid { Grid files varname scal nodata has_MG etiket description {write_fld 1} {CALLPROCFLD ""} {stack ""} } {
 
    set types {}
 
@@ -4912,6 +5665,33 @@ proc GeoPhysX::AverageRastersFiles2rpnGrid { Grid files varname scal nodata has_
       }
    }
 
+   if { !$has_CallProc && ![llength $stack] } {
+      set stack [GeoPhysX::AverageRasterStack $Grid $files $nodata]
+   }
+
+   #----- Bands already averaged, only mask, scale and save them
+   if { [llength $stack] } {
+      set type 1
+      foreach fld $stack {
+         Log::Print INFO "Averaging $varname ($description) layer $type"
+         fstdfield copy $Grid $fld
+         fstdfield free $fld
+
+         if { $has_MG } {
+            vexpr  $Grid "ifelse(GPXMG>0.0, $Grid, 0.0)"
+         }
+         vexpr  $Grid "$Grid * $scal"
+
+         lappend types $type
+         if { $write_fld } {
+            fstdfield define $Grid -NOMVAR $varname -IP1 [expr 1200-$type] -ETIKET "$etiket"
+            GenX::FieldWrite $Grid GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+         }
+         incr type
+      }
+      return $types
+   }
+
    #----- Open the files
    set fntype  1
    foreach file $files {
@@ -4967,7 +5747,7 @@ proc GeoPhysX::AverageRastersFiles2rpnGrid { Grid files varname scal nodata has_
          lappend types $type
 	 if { $write_fld } {
             fstdfield define $Grid -NOMVAR $varname -IP1 [expr 1200-$type] -ETIKET "$etiket"
-            fstdfield write $Grid GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+            GenX::FieldWrite $Grid GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
          }
          gdalband free BFRTILE
 
@@ -5058,7 +5838,7 @@ proc GeoPhysX::AverageClay { Grid } {
       fstdfield stats GPXJ2 -mask ""
       #----- Save output
       fstdfield define GPXJ2 -NOMVAR J2 -ETIKET $GenX::Param(ETIKET) -IP1 [expr 1200-$type] -DATYP $GenX::Param(Datyp)
-      fstdfield write GPXJ2 GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXJ2 GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
    }
    fstdfield free CLAYTILE GPXJ2 GPXJ2SK
 }
@@ -5109,13 +5889,13 @@ proc GeoPhysX::AverageTopoLow { Grid } {
    fstdfield gridinterp GPXLOW - NOP True
    vexpr GPXLOW ifelse(GPXLOW==-99.0,0.0,GPXLOW)
    fstdfield define GPXLOW -NOMVAR MEL -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0 -DATYP $GenX::Param(Datyp)
-   fstdfield write GPXLOW GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXLOW GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
 
    #----- save <Hhr^2>ij
    fstdfield gridinterp GPXLRMS - NOP True
    vexpr GPXLRMS ifelse(GPXLRMS>0.0,GPXLRMS^0.5,0.0)
    fstdfield define GPXLRMS -NOMVAR LRMS -ETIKET $GenX::Param(ETIKET) -IP1 0 -DATYP $GenX::Param(Datyp)
-   fstdfield write GPXLRMS GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXLRMS GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
 
    fstdfield free LOWTILE LOWTILE2 GPXLRMS
 }
@@ -5177,15 +5957,15 @@ proc GeoPhysX::AverageGradient { Grid } {
    #----- Save output
    fstdfield gridinterp GPXGXX - NOP True
    fstdfield define GPXGXX -NOMVAR GXX -ETIKET $GenX::Param(ETIKET) -IP1 0
-   fstdfield write GPXGXX GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXGXX GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    fstdfield gridinterp GPXGYY - NOP True
    fstdfield define GPXGYY -NOMVAR GYY -ETIKET $GenX::Param(ETIKET) -IP1 0
-   fstdfield write GPXGYY GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXGYY GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    fstdfield gridinterp GPXGXY - NOP True
    fstdfield define GPXGXY -NOMVAR GXY -ETIKET $GenX::Param(ETIKET) -IP1 0
-   fstdfield write GPXGXY GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXGXY GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    fstdfield free GXYTILE GXYTILE1 GXYTILE2 GXYTILE1X GXYTILE2Y GPXGXX GPXGYY GPXGXY
 }
@@ -5235,8 +6015,8 @@ proc GeoPhysX::SubCorrectionFactor { } {
    variable Const
 
    GenX::Procs
-   fstdfield read GPXMG GPXOUTFILE -1 "" -1 -1 -1 "" "MG"
-   fstdfield read GPXMRES GPXAUXFILE -1 "" -1 -1 -1 "" "MRES"
+   GenX::FieldRead GPXMG GPXOUTFILE -1 "" -1 -1 -1 "" "MG"
+   GenX::FieldRead GPXMRES GPXAUXFILE -1 "" -1 -1 -1 "" "MRES"
 
    #----- For low-res and hi-res
    Log::Print INFO "Computing low and high res fields"
@@ -5248,9 +6028,9 @@ proc GeoPhysX::SubCorrectionFactor { } {
    GeoPhysX::SubCorrectionFilter GPXFHR GPXDX GPXDY GPXMRES $Const(smallc0) $Const(smallc1)
 
    fstdfield define GPXFLR -NOMVAR FLR -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0 -DATYP $GenX::Param(Datyp)
-   fstdfield write GPXFLR GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXFLR GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
    fstdfield define GPXFHR -NOMVAR FHR -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0 -DATYP $GenX::Param(Datyp)
-   fstdfield write GPXFHR GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXFHR GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
 
    #----- For low-res and hi-res (over land only)
    Log::Print INFO "Computing low and high res fields over land only"
@@ -5262,9 +6042,9 @@ proc GeoPhysX::SubCorrectionFactor { } {
    GeoPhysX::SubCorrectionFilter GPXFHR GPXDX GPXDY GPXMRES $Const(smallc0) $Const(smallc1)
 
    fstdfield define GPXFLR -NOMVAR FLRP -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0 -DATYP $GenX::Param(Datyp)
-   fstdfield write GPXFLR GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXFLR GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
    fstdfield define GPXFHR -NOMVAR FHRP -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0 -DATYP $GenX::Param(Datyp)
-   fstdfield write GPXFHR GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXFHR GPXAUXFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
 
    fstdfield free GPXMG GPXDX GPXDY GPXFLR GPXFHR
 }
@@ -5286,7 +6066,7 @@ proc GeoPhysX::SubTopoFilter { } {
 
    GenX::Procs
    
-   fstdfield read GPXMF GPXOUTFILE -1 "" -1 -1 -1 "" "MENF"
+   GenX::FieldRead GPXMF GPXOUTFILE -1 "" -1 -1 -1 "" "MENF"
 
    Log::Print INFO "Filtering ME"
 
@@ -5301,7 +6081,7 @@ proc GeoPhysX::SubTopoFilter { } {
    }
 
    fstdfield define GPXMF -NOMVAR ME -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-   fstdfield write GPXMF GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXMF GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    fstdfield free GPXMF
 }
@@ -5322,7 +6102,7 @@ proc GeoPhysX::SubTopoFilter { } {
 proc GeoPhysX::LowPassFilter { Grid } {
 
    if { $GenX::Settings(LPASSFLT_MASK_OPERATOR) != 0 } {
-      if { [catch { fstdfield read GPXSSS GPXOUTFILE -1 "" -1 -1 -1 "" "SSS" } ] } {
+      if { [catch { GenX::FieldRead GPXSSS GPXOUTFILE -1 "" -1 -1 -1 "" "SSS" } ] } {
          Log::Print WARNING "   Missing SSS field, using LPass filter without mask"
          geophy lpass_filter $Grid GenX::Settings
       } else {
@@ -5367,7 +6147,7 @@ proc GeoPhysX::LegacySub { Grid } {
    } else {
       set  varname VG
    }
-   if { [catch { fstdfield read GPXZVG $infile -1 "" -1 -1 -1 "" $varname } ] } {
+   if { [catch { GenX::FieldRead GPXZVG $infile -1 "" -1 -1 -1 "" $varname } ] } {
       Log::Print WARNING "Missing field: $varname, will not calculate legacy sub grid fields"
       return
    }
@@ -5375,7 +6155,7 @@ proc GeoPhysX::LegacySub { Grid } {
    #----- if MG is used to set water roughness
    if { $GenX::Settings(TOPO_RUGV_ZVG2) } {
       if { $GenX::Settings(TOPO_RUGV_MG) } {
-         if { [catch { fstdfield read GPXMG GPXOUTFILE -1 "" -1 -1 -1 "" MG } ] } {
+         if { [catch { GenX::FieldRead GPXMG GPXOUTFILE -1 "" -1 -1 -1 "" MG } ] } {
             Log::Print WARNING "Missing field: MG, will not calculate legacy sub grid fields"
             return
          }
@@ -5438,8 +6218,8 @@ proc GeoPhysX::LegacySub { Grid } {
 
       fstdfield define GPXZ0 -NOMVAR Z0 -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
       fstdfield define GPXZP -NOMVAR ZP -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-      fstdfield write GPXZ0 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-      fstdfield write GPXZP GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXZ0 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXZP GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    }
    if { $GenX::Param(Sub)=="LEGACY" } {
       Log::Print INFO "Saving legacy sub grid fields LH DH Y7 Y8 Y9"
@@ -5449,14 +6229,15 @@ proc GeoPhysX::LegacySub { Grid } {
       fstdfield define GPXY8 -NOMVAR Y8 -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
       fstdfield define GPXY9 -NOMVAR Y9 -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
 
-      fstdfield write GPXLH GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-      fstdfield write GPXDH GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-      fstdfield write GPXY7 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-      fstdfield write GPXY8 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
-      fstdfield write GPXY9 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXLH GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXDH GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXY7 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXY8 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXY9 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    }
 
    fstdfield free GPXVG GPXZVG2 GPXZ0 GPXZP GPXLH GPXDH GPXY7 GPXY8 GPXY9
+   geophy subgrid_free GPXME
 }
 
 #----------------------------------------------------------------------------
@@ -5477,10 +6258,10 @@ proc GeoPhysX::SubLaunchingHeight { } {
 
    GenX::Procs
    if { [catch {
-      fstdfield read GPXMEL  GPXAUXFILE -1 "" -1 -1 -1 "" "MEL"
-      fstdfield read GPXLRMS GPXAUXFILE -1 "" -1 -1 -1 "" "LRMS"
-      fstdfield read GPXFLR  GPXAUXFILE -1 "" -1 -1 -1 "" "FLR"
-      fstdfield read GPXMG   GPXOUTFILE -1 "" -1 -1 -1 "" "MG" } ] } {
+      GenX::FieldRead GPXMEL  GPXAUXFILE -1 "" -1 -1 -1 "" "MEL"
+      GenX::FieldRead GPXLRMS GPXAUXFILE -1 "" -1 -1 -1 "" "LRMS"
+      GenX::FieldRead GPXFLR  GPXAUXFILE -1 "" -1 -1 -1 "" "FLR"
+      GenX::FieldRead GPXMG   GPXOUTFILE -1 "" -1 -1 -1 "" "MG" } ] } {
     
       Log::Print WARNING "Missing fields, will not calculate launching height"
       return
@@ -5494,7 +6275,7 @@ proc GeoPhysX::SubLaunchingHeight { } {
    vexpr GPXLH 2.0*GPXMG*((GPXLRMS^2 - GPXMEL^2)^0.5)
    vexpr GPXLH ifelse(GPXLH>=$Const(lhmin),GPXLH,0.0)
    fstdfield define GPXLH -NOMVAR LH -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-   fstdfield write GPXLH GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXLH GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    fstdfield free GPXLH GPXMEL GPXLRMS GPXMG GPXFLR
 }
@@ -5518,9 +6299,9 @@ proc GeoPhysX::SubLaunchingHeightSplit { } {
    GenX::Procs
 
    if { [catch {
-      fstdfield read GPXMRMS GPXAUXFILE -1 "" -1 -1 -1 "" "MRMS"
-      fstdfield read GPXMRES GPXAUXFILE -1 "" -1 -1 -1 "" "MRES"
-      fstdfield read GPXMG   GPXOUTFILE -1 "" -1 -1 -1 "" "MG" } ] } {
+      GenX::FieldRead GPXMRMS GPXAUXFILE -1 "" -1 -1 -1 "" "MRMS"
+      GenX::FieldRead GPXMRES GPXAUXFILE -1 "" -1 -1 -1 "" "MRES"
+      GenX::FieldRead GPXMG   GPXOUTFILE -1 "" -1 -1 -1 "" "MG" } ] } {
     
       Log::Print WARNING "Missing fields, will not separate subgrid variance"
       return
@@ -5548,9 +6329,9 @@ proc GeoPhysX::SubLaunchingHeightSplit { } {
 
    #----- Write results to output files
    fstdfield define GPXSSS -NOMVAR SSS -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-   fstdfield write GPXSSS GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXSSS GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    fstdfield define GPXLHL -NOMVAR LH -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-   fstdfield write GPXLHL GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXLHL GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    #----- Garbage collection
    fstdfield free GPX1_WMB GPXVARL GPXVARS GPXWMS GPXWMB GPXDD GPXDX GPXDY
@@ -5578,12 +6359,12 @@ proc GeoPhysX::SubY789 { } {
 
    #----- check for needed fields
    if { [catch {
-      fstdfield read GPXGXX  GPXAUXFILE -1 "" -1 -1 -1 "" "GXX"
-      fstdfield read GPXGYY  GPXAUXFILE -1 "" -1 -1 -1 "" "GYY"
-      fstdfield read GPXGXY  GPXAUXFILE -1 "" -1 -1 -1 "" "GXY"
-      fstdfield read GPXFLR  GPXAUXFILE -1 "" -1 -1 -1 "" "FLR"
-      fstdfield read GPXMG   GPXOUTFILE -1 "" -1 -1 -1 "" "MG"
-      fstdfield read GPXLH   GPXOUTFILE -1 "" -1 -1 -1 "" "LH" } ] } {
+      GenX::FieldRead GPXGXX  GPXAUXFILE -1 "" -1 -1 -1 "" "GXX"
+      GenX::FieldRead GPXGYY  GPXAUXFILE -1 "" -1 -1 -1 "" "GYY"
+      GenX::FieldRead GPXGXY  GPXAUXFILE -1 "" -1 -1 -1 "" "GXY"
+      GenX::FieldRead GPXFLR  GPXAUXFILE -1 "" -1 -1 -1 "" "FLR"
+      GenX::FieldRead GPXMG   GPXOUTFILE -1 "" -1 -1 -1 "" "MG"
+      GenX::FieldRead GPXLH   GPXOUTFILE -1 "" -1 -1 -1 "" "LH" } ] } {
     
       Log::Print WARNING "Missing fields, will not calculate Y789 fields"
       return
@@ -5603,19 +6384,19 @@ proc GeoPhysX::SubY789 { } {
    vexpr GPXY789 GPXMG*(GPXGXX*(GPXCOSA^2) + GPXGYY*(GPXSINA^2) - 2.0*GPXGXY*GPXSINA*GPXCOSA)
    vexpr GPXY789 ifelse(GPXLH>$Const(lhmin),GPXY789,0.0)
    fstdfield define GPXY789 -NOMVAR Y7 -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-   fstdfield write GPXY789 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXY789 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    Log::Print INFO "Computing Y8"
    vexpr GPXY789 GPXMG*(GPXGXX*(GPXSINA^2) + GPXGYY*(GPXCOSA^2) + 2.0*GPXGXY*GPXSINA*GPXCOSA)
    vexpr GPXY789 ifelse(GPXLH>$Const(lhmin),GPXY789,0.0)
    fstdfield define GPXY789 -NOMVAR Y8 -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-   fstdfield write GPXY789 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXY789 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    Log::Print INFO "Computing Y9"
    vexpr GPXY789 GPXMG*((GPXGXX-GPXGYY)*GPXSINA*GPXCOSA + GPXGXY*(GPXCOSA^2-GPXSINA^2))
    vexpr GPXY789 ifelse(GPXLH>$Const(lhmin),GPXY789,0.0)
    fstdfield define GPXY789 -NOMVAR Y9 -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-   fstdfield write GPXY789 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXY789 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    fstdfield free GPXGXX GPXGYY GPXGXY GPXMG GPXFLR GPXALP GPXCOSA GPXSINA GPXMG GPXLH GPXY789
 }
@@ -5640,12 +6421,12 @@ proc GeoPhysX::SubY789Split { } {
 
    #----- check for needed fields
    if { [catch {
-      fstdfield read GPXGXX  GPXAUXFILE -1 "" -1 -1 -1 "" "GXX"
-      fstdfield read GPXGYY  GPXAUXFILE -1 "" -1 -1 -1 "" "GYY"
-      fstdfield read GPXGXY  GPXAUXFILE -1 "" -1 -1 -1 "" "GXY"
-      fstdfield read GPXMG   GPXOUTFILE -1 "" -1 -1 -1 "" "MG"
-      fstdfield read GPXMRES GPXAUXFILE -1 "" -1 -1 -1 "" "MRES"
-      fstdfield read GPXLH   GPXOUTFILE -1 "" -1 -1 -1 "" "LH" } ] } {
+      GenX::FieldRead GPXGXX  GPXAUXFILE -1 "" -1 -1 -1 "" "GXX"
+      GenX::FieldRead GPXGYY  GPXAUXFILE -1 "" -1 -1 -1 "" "GYY"
+      GenX::FieldRead GPXGXY  GPXAUXFILE -1 "" -1 -1 -1 "" "GXY"
+      GenX::FieldRead GPXMG   GPXOUTFILE -1 "" -1 -1 -1 "" "MG"
+      GenX::FieldRead GPXMRES GPXAUXFILE -1 "" -1 -1 -1 "" "MRES"
+      GenX::FieldRead GPXLH   GPXOUTFILE -1 "" -1 -1 -1 "" "LH" } ] } {
     
       Log::Print WARNING "Missing fields, will not calculate Y789 fields"
       return
@@ -5665,25 +6446,25 @@ proc GeoPhysX::SubY789Split { } {
    vexpr GPXR GPXRNUM / GPXRDENOM
 
    fstdfield define GPXR -NOMVAR R -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-   fstdfield write GPXR GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXR GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    Log::Print INFO "Computing Y7"
    vexpr GPXY789 GPXR*GPXMG*(GPXGXX*(GPXCOSA^2) + GPXGYY*(GPXSINA^2) - 2.0*GPXGXY*GPXSINA*GPXCOSA)
    vexpr GPXY789 ifelse(GPXLH>$Const(lhmin),GPXY789,0.0)
    fstdfield define GPXY789 -NOMVAR Y7 -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-   fstdfield write GPXY789 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXY789 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    Log::Print INFO "Computing Y8"
    vexpr GPXY789 GPXR*GPXMG*(GPXGXX*(GPXSINA^2) + GPXGYY*(GPXCOSA^2) + 2.0*GPXGXY*GPXSINA*GPXCOSA)
    vexpr GPXY789 ifelse(GPXLH>$Const(lhmin),GPXY789,0.0)
    fstdfield define GPXY789 -NOMVAR Y8 -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-   fstdfield write GPXY789 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXY789 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    Log::Print INFO "Computing Y9"
    vexpr GPXY789 GPXR*GPXMG*((GPXGXX-GPXGYY)*GPXSINA*GPXCOSA + GPXGXY*(GPXCOSA^2-GPXSINA^2))
    vexpr GPXY789 ifelse(GPXLH>$Const(lhmin),GPXY789,0.0)
    fstdfield define GPXY789 -NOMVAR Y9 -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-   fstdfield write GPXY789 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXY789 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    fstdfield free GPXGXX GPXGYY GPXGXY GPXMG GPXFLR GPXALP GPXCOSA GPXSINA GPXMG GPXLH GPXY789
 }
@@ -5710,18 +6491,18 @@ proc GeoPhysX::SubRoughnessLength { } {
 
    #----- check for needed fields
    if { [catch {
-      fstdfield read GPXMG   GPXOUTFILE -1 "" -1   -1 -1 "" "MG"
-      fstdfield read GPXMRMS GPXAUXFILE -1 "" -1   -1 -1 "" "MRMS"
-      fstdfield read GPXMF   GPXOUTFILE -1 "" -1   -1 -1 "" "MENF"
+      GenX::FieldRead GPXMG   GPXOUTFILE -1 "" -1   -1 -1 "" "MG"
+      GenX::FieldRead GPXMRMS GPXAUXFILE -1 "" -1   -1 -1 "" "MRMS"
+      GenX::FieldRead GPXMF   GPXOUTFILE -1 "" -1   -1 -1 "" "MENF"
       if { $Opt(SubSplit) } {
-         fstdfield read GPXSSS GPXOUTFILE -1 "" -1   -1 -1 "" "SSS"
+         GenX::FieldRead GPXSSS GPXOUTFILE -1 "" -1   -1 -1 "" "SSS"
       } else {
-         fstdfield read GPXMEL  GPXAUXFILE -1 "" -1   -1 -1 "" "MEL"
-         fstdfield read GPXLRMS GPXAUXFILE -1 "" -1   -1 -1 "" "LRMS"
-         fstdfield read GPXFHR  GPXAUXFILE -1 "" -1   -1 -1 "" "FHR"
-         fstdfield read GPXFLR  GPXAUXFILE -1 "" -1   -1 -1 "" "FLR"
+         GenX::FieldRead GPXMEL  GPXAUXFILE -1 "" -1   -1 -1 "" "MEL"
+         GenX::FieldRead GPXLRMS GPXAUXFILE -1 "" -1   -1 -1 "" "LRMS"
+         GenX::FieldRead GPXFHR  GPXAUXFILE -1 "" -1   -1 -1 "" "FHR"
+         GenX::FieldRead GPXFLR  GPXAUXFILE -1 "" -1   -1 -1 "" "FLR"
       }
-      fstdfield read GPXZ0V1 GPXOUTFILE -1 "" 1199 -1 -1 "" "VF" } ] } {
+      GenX::FieldRead GPXZ0V1 GPXOUTFILE -1 "" 1199 -1 -1 "" "VF" } ] } {
     
       Log::Print WARNING "Missing fields, will not calculate roughness length"
       return
@@ -5737,7 +6518,7 @@ proc GeoPhysX::SubRoughnessLength { } {
       vexpr GPXSSS ifelse(GPXSSS>0.0,GPXSSS^0.5,0.0)
       vexpr GPXSSS ifelse(GPXMG>$Const(mgmin),GPXSSS,0.0)
       fstdfield define GPXSSS -NOMVAR SSS -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-      fstdfield write GPXSSS GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXSSS GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    }
 
    vexpr GPXHCOEF (1.5 - 0.5*(GPXSSS-20.0)/680.0)
@@ -5748,7 +6529,7 @@ proc GeoPhysX::SubRoughnessLength { } {
    vexpr GPXZREF ifelse(GPXZREF>1500.0,1500.0,GPXZREF)
     
    fstdfield define GPXZREF -NOMVAR ZREF -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-   fstdfield write GPXZREF GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXZREF GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
     
    vexpr GPXSLP (GPXHCOEF*GPXHCOEF*GPXSSS/$Const(lres))
     
@@ -5756,28 +6537,28 @@ proc GeoPhysX::SubRoughnessLength { } {
    vexpr GPXZTP ifelse(GPXSLP>$Const(slpmin) || GPXZREF>$Const(zrefmin),1.0+GPXZREF*exp(-$Const(karman)/sqrt(0.5*$Const(drgcoef)*GPXSLP)),0.0)
    vexpr GPXZTP ifelse(GPXSSS<=$Const(sssmin),0.1*GPXSSS,GPXZTP)
    fstdfield define GPXZTP -NOMVAR ZTOP -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-   fstdfield write GPXZTP GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXZTP GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    #----- Local (vegetation) roughness length
-   fstdfield read GPXZ0V1 GPXOUTFILE -1 "" 1199 -1 -1 "" "VF"
+   GenX::FieldRead GPXZ0V1 GPXOUTFILE -1 "" 1199 -1 -1 "" "VF"
    fstdfield copy GPXZ0V2 GPXZ0V1
    GenX::GridClear { GPXZ0V1 GPXZ0V2 } 0.0
 
    foreach element $Param(VegeTypes) zzov $Param(VegeZ0vTypes) {
       set ip1 [expr 1200-$element]
-      fstdfield read GPXVF GPXOUTFILE -1 "" $ip1 -1 -1 "" "VF"
+      GenX::FieldRead GPXVF GPXOUTFILE -1 "" $ip1 -1 -1 "" "VF"
 
       vexpr GPXZ0V1 (GPXZ0V1+GPXVF*$zzov)
       vexpr GPXZ0V2 (GPXZ0V2+GPXVF)
    }
    vexpr GPXZ0V1 ifelse(GPXZ0V2>0.001,GPXZ0V1/GPXZ0V2,0.0)
    fstdfield define GPXZ0V1 -NOMVAR ZVG1 -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-   fstdfield write GPXZ0V1 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXZ0V1 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    GenX::GridClear { GPXZ0V1 GPXZ0V2 } 0.0
    foreach element [lrange $Param(VegeTypes) 3 end] zzov [lrange $Param(VegeZ0vTypes) 3 end] {
       set ip1 [expr 1200-$element]
-      fstdfield read GPXVF GPXOUTFILE -1 "" $ip1 -1 -1 "" "VF"
+      GenX::FieldRead GPXVF GPXOUTFILE -1 "" $ip1 -1 -1 "" "VF"
       vexpr GPXZ0V1 (GPXZ0V1+GPXVF*$zzov)
       vexpr GPXZ0V2 (GPXZ0V2+GPXVF)
    }
@@ -5785,17 +6566,17 @@ proc GeoPhysX::SubRoughnessLength { } {
    Log::Print INFO "Computing Z0V1 (save as ZVG2) using Lookup Table VegeZ0vTypes : $Param(VegeZ0vTypes)"
    vexpr GPXZ0V1 ifelse(GPXZ0V2>0.001,GPXZ0V1/GPXZ0V2,0.0)
    fstdfield define GPXZ0V1 -NOMVAR ZVG2 -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-   fstdfield write GPXZ0V1 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXZ0V1 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    #----- Local (vegetation) roughness length from canopy height  
    if { $GenX::Param(Z0NoTopo) == "CANOPY" } {
-      if { [catch { fstdfield read GPXVCH  GPXAUXFILE -1 "" -1 -1 -1 "" "VCH" }] } {
+      if { [catch { GenX::FieldRead GPXVCH  GPXAUXFILE -1 "" -1 -1 -1 "" "VCH" }] } {
          Log::Print WARNING "Missing fields, will not calculate roughness length from canopy height"
          return
       }
       vexpr GPXZ0VG ifelse(GPXMG>0.0,max(GPXVCH*0.1,$Const(z0minUr)),0.0)
       fstdfield define GPXZ0VG -NOMVAR Z0VG -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-      fstdfield write GPXZ0VG GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXZ0VG GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
       #------ roughness length without topographic contribution and Z0VG
       Log::Print INFO "Generating Z0 without topographic contribution from canopy height"
@@ -5812,7 +6593,7 @@ proc GeoPhysX::SubRoughnessLength { } {
          foreach element $Param(VegeTypes) zzov $Param(VegeZ0vTypes)  {
             set ip1 [expr 1200-$element]
             if { [lsearch $Param(VegeCrops) $element]!=-1 } {
-               fstdfield read GPXVF GPXOUTFILE -1 "" $ip1 -1 -1 "" "VF"
+               GenX::FieldRead GPXVF GPXOUTFILE -1 "" $ip1 -1 -1 "" "VF"
                vexpr GPXZ0CROP (GPXZ0CROP+GPXVF*$zzov)
                vexpr GPXVFCROP (GPXVFCROP+GPXVF)
             }
@@ -5824,14 +6605,14 @@ proc GeoPhysX::SubRoughnessLength { } {
          vexpr GPXZ0  "max(GPXZ0VG,$Const(waz0))"
       }
       fstdfield define GPXZ0 -NOMVAR Z0 -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-      fstdfield write GPXZ0 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXZ0 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    	 
       vexpr GPXZP  ifelse(GPXZ0>$Const(z0def),ln(GPXZ0),$Const(zpdef))
       fstdfield define GPXZP -NOMVAR ZP -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-      fstdfield write GPXZP GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXZP GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    } elseif { ($GenX::Param(Z0NoTopo) == "CANOPY_LT") || ($GenX::Param(TOPO_ZVG2_TYPE) == "CANOPY_LT") } {
       Log::Print INFO "Computing Local Vegetation Roughness"
-      if { [catch { fstdfield read GPXZ0VH  GPXAUXFILE -1 "" -1 -1 -1 "" "Z0VH" }] } {
+      if { [catch { GenX::FieldRead GPXZ0VH  GPXAUXFILE -1 "" -1 -1 -1 "" "Z0VH" }] } {
          Log::Print WARNING "Missing fields, will not calculate local roughness length from canopy height"
          return
       }
@@ -5857,7 +6638,7 @@ proc GeoPhysX::SubRoughnessLength { } {
       foreach element $Param(VegeTypes) zomv $Z0M_VegeZ0  {
          Log::Print DEBUG "  Processing LN(Z0) with VF $element"
          set ip1 [expr 1200-$element]
-         fstdfield read GPXVF GPXOUTFILE -1 "" $ip1 -1 -1 "" "VF"
+         GenX::FieldRead GPXVF GPXOUTFILE -1 "" $ip1 -1 -1 "" "VF"
          if { [lsearch $VegeTree $element]!=-1 } {
             # remplace LN(Z0) from VF and LUT with Z0VH if available
             Log::Print DEBUG "Using Tree Height for VF=$element"
@@ -5878,28 +6659,28 @@ proc GeoPhysX::SubRoughnessLength { } {
       vexpr GPXZ0V1 ifelse(GPXVFT>0.0,GPXZ0V1/GPXVFT,ln($Const(waz0)))
 
       fstdfield define GPXZ0V1 -NOMVAR ZPVG -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-      fstdfield write GPXZ0V1 GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXZ0V1 GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
       vexpr GPXZ0V1   exp(GPXZ0V1)
       fstdfield define GPXZ0V1 -NOMVAR Z0VG -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-      fstdfield write GPXZ0V1 GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXZ0V1 GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
       # z0v3 is used for Z0 for all surface types ... VF=1,26 -- No need to divide by Vfs as sum=1.0
 
       fstdfield define GPXZ0V3 -NOMVAR ZPLC -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-      fstdfield write GPXZ0V3 GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXZ0V3 GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
       vexpr GPXZ0V3   exp(GPXZ0V3)
       fstdfield define GPXZ0V3 -NOMVAR Z0LC -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-      fstdfield write GPXZ0V3 GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXZ0V3 GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    } elseif { $GenX::Param(Z0NoTopo) == "STD" } {
       Log::Print INFO "Generating Z0 without topographic contribution from vegetation type"
       vexpr GPXZ0  "max(GPXZ0V1,$Const(waz0))"
       fstdfield define GPXZ0 -NOMVAR Z0 -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-      fstdfield write GPXZ0 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXZ0 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
       vexpr GPXZP ifelse(GPXZ0>$Const(z0def),ln(GPXZ0),$Const(zpdef))
       fstdfield define GPXZP -NOMVAR ZP -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-      fstdfield write GPXZP GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXZP GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    } 
 
    if { ($GenX::Param(Z0NoTopo) == "") && ($GenX::Param(Z0Topo) == "STD") } {
@@ -5907,7 +6688,7 @@ proc GeoPhysX::SubRoughnessLength { } {
        #------ Filter roughness length
 
        #----- Roughness length over soil
-       fstdfield read GPXGA GPXOUTFILE -1 "" 1198 -1 -1 "" "VF"
+       GenX::FieldRead GPXGA GPXOUTFILE -1 "" 1198 -1 -1 "" "VF"
        
        vexpr GPXW1  ifelse(GPXZTP >0.0 && GPXZREF>GPXZTP     , (1.0/ln(GPXZREF/GPXZTP ))^2.0        , 0.0)
        vexpr GPXW2  ifelse(GPXZ0V1>0.0 && GPXZREF>GPXZ0V1    , (1.0/ln(GPXZREF/GPXZ0V1))^2.0        , 0.0)
@@ -5916,11 +6697,11 @@ proc GeoPhysX::SubRoughnessLength { } {
        vexpr GPXZ0S ifelse(GPXZ0S<$Const(z0def)              , $Const(z0def)                        , GPXZ0S)
        vexpr GPXZ0S ifelse(GPXGA>=(1.0-$Const(gamin))        , $Const(z0def)                        , GPXZ0S)
        fstdfield define GPXZ0S -NOMVAR Z0S -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-       fstdfield write GPXZ0S GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+       GenX::FieldWrite GPXZ0S GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
        
        vexpr GPXZPS ifelse(GPXZ0S>0.0,ln(GPXZ0S),$Const(zpdef))
        fstdfield define GPXZPS -NOMVAR ZPS -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-       fstdfield write GPXZPS GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+       GenX::FieldWrite GPXZPS GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
        
        #----- Roughness length over glaciers
        vexpr GPXW1  ifelse(GPXZTP>0.0 && GPXZREF>GPXZTP, (1.0/ln(GPXZREF/GPXZTP      ))^2.0 , 0.0)
@@ -5930,11 +6711,11 @@ proc GeoPhysX::SubRoughnessLength { } {
        vexpr GPXZ0G ifelse(GPXZ0G<$Const(z0def)        , $Const(z0def)                      , GPXZ0G)
        vexpr GPXZ0G ifelse(GPXGA<=$Const(gamin)        , $Const(z0def)                      , GPXZ0G)
        fstdfield define GPXZ0G -NOMVAR Z0G -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-       fstdfield write GPXZ0G GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+       GenX::FieldWrite GPXZ0G GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
        vexpr GPXZPG ifelse(GPXZ0G>0.0,ln(GPXZ0G),$Const(zpdef) )
        fstdfield define GPXZPG -NOMVAR ZPG -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-       fstdfield write GPXZPG GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+       GenX::FieldWrite GPXZPG GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
        #----- Roughness length over water
        vexpr GPXW1  ifelse(GPXZTP>0.0 && GPXZREF>GPXZTP, (1.0/ln(GPXZREF/GPXZTP      ))^2.0 , 0.0)
@@ -5944,30 +6725,30 @@ proc GeoPhysX::SubRoughnessLength { } {
        vexpr GPXZ0W ifelse(GPXZ0W<$Const(z0def)        , $Const(z0def)                      , GPXZ0W)
        vexpr GPXZ0W ifelse((1.0-GPXMG)<=$Const(mgmin)  , $Const(z0def)                      , GPXZ0W)
        fstdfield define GPXZ0W -NOMVAR Z0W -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-       fstdfield write GPXZ0W GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+       GenX::FieldWrite GPXZ0W GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
        vexpr GPXZPW ifelse(GPXZ0W>0.0,ln(GPXZ0W),$Const(zpdef) )
        fstdfield define GPXZPW -NOMVAR ZPW -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-       fstdfield write GPXZPW GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+       GenX::FieldWrite GPXZPW GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
        #----- Fill some gaps
        vexpr GPXZ0S ifelse(GPXMG>$Const(mgmin) && GPXZTP<$Const(z0min) && GPXZ0V1<$Const(z0min) && GPXZ0G<$Const(z0min),$Const(z0def),GPXZ0S)
        fstdfield define GPXZ0S -NOMVAR Z0S -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-       fstdfield write GPXZ0S GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+       GenX::FieldWrite GPXZ0S GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
        vexpr GPXZPS ifelse(GPXZ0S>0.0,ln(GPXZ0S),$Const(zpdef) )
        fstdfield define GPXZPS -NOMVAR ZPS -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-       fstdfield write GPXZPS GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+       GenX::FieldWrite GPXZPS GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
        #----- Total roughness length
        GeoPhysX::Compute_GA GPXGA GPXGA
        vexpr GPXZP GPXMG*((1.0-GPXGA)*GPXZPS+GPXGA*GPXZPG)+(1.0-GPXMG)*GPXZPW
 
        fstdfield define GPXZP -NOMVAR ZP0 -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-       fstdfield write GPXZP GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+       GenX::FieldWrite GPXZP GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
        vexpr GPXZ0 exp(GPXZP)
        fstdfield define GPXZ0 -NOMVAR Z00 -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-       fstdfield write GPXZ0 GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+       GenX::FieldWrite GPXZ0 GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
        Log::Print INFO "Generating Z0 with topographic contribution"
        if { $GenX::Param(Z0Filter) } {
@@ -5976,11 +6757,11 @@ proc GeoPhysX::SubRoughnessLength { } {
        }
        vexpr GPXZ0 ifelse(GPXZ0>$Const(z0def),GPXZ0,$Const(z0def) )
        fstdfield define GPXZ0 -NOMVAR Z0 -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-       fstdfield write GPXZ0 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+       GenX::FieldWrite GPXZ0 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    
        vexpr GPXZP ifelse(GPXZ0>$Const(z0def),ln(GPXZ0),$Const(zpdef))
        fstdfield define GPXZP -NOMVAR ZP -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0
-       fstdfield write GPXZP GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+       GenX::FieldWrite GPXZP GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    } elseif { ($GenX::Param(Z0NoTopo) == "") && ($GenX::Param(Z0Topo) == "LEGACY") } {
        # nothing to do here, Z0 will be calculated in GeoPhysX::LegacySub
    } elseif { $GenX::Param(Z0NoTopo) == "CANOPY_LT" } {
@@ -6013,8 +6794,8 @@ proc GeoPhysX::CheckMaskVegeConsistency {} {
    Log::Print INFO "Applying Mask versus Vege consistency checks"
 
    #----- Read mask
-   if { [llength [set idx [fstdfield find GPXOUTFILE -1 "" -1 -1 -1 "" "MG"]]] } {
-      fstdfield read GRDMG GPXOUTFILE $idx
+   if { [llength [set idx [GenX::FieldFind GPXOUTFILE -1 "" -1 -1 -1 "" "MG"]]] } {
+      GenX::FieldRead GRDMG GPXOUTFILE $idx
       set has_MG  1
    } else {
       Log::Print INFO "Could not find mask field MG, will create it using VF1 and VF3"
@@ -6022,33 +6803,33 @@ proc GeoPhysX::CheckMaskVegeConsistency {} {
    }
 
    #----- Read Urban VF(21)
-   if { [llength [set idx [fstdfield find GPXOUTFILE -1 "" 1179 -1 -1 "" "VF"]]] } {
-      fstdfield read GRDVF21 GPXOUTFILE $idx
-   } elseif { [llength [set idx [fstdfield find GPXAUXFILE -1 "" 1179 -1 -1 "" "VF"]]] } {
-      fstdfield read GRDVF21 GPXAUXFILE $idx
+   if { [llength [set idx [GenX::FieldFind GPXOUTFILE -1 "" 1179 -1 -1 "" "VF"]]] } {
+      GenX::FieldRead GRDVF21 GPXOUTFILE $idx
+   } elseif { [llength [set idx [GenX::FieldFind GPXAUXFILE -1 "" 1179 -1 -1 "" "VF"]]] } {
+      GenX::FieldRead GRDVF21 GPXAUXFILE $idx
    } else {
       Log::Print WARNING "Could not find water field VF(21)"
       return
    }
 
    #----- Read water coverage VF(3)
-   if { [llength [set idx [fstdfield find GPXOUTFILE -1 "" 1197 -1 -1 "" "VF"]]] } {
+   if { [llength [set idx [GenX::FieldFind GPXOUTFILE -1 "" 1197 -1 -1 "" "VF"]]] } {
       Log::Print INFO "Reading VF3 from GPXOUTFILE"
-      fstdfield read GRDVF3 GPXOUTFILE $idx
-   } elseif { [llength [set idx [fstdfield find GPXAUXFILE -1 "" 1197 -1 -1 "" "VF"]]] } {
+      GenX::FieldRead GRDVF3 GPXOUTFILE $idx
+   } elseif { [llength [set idx [GenX::FieldFind GPXAUXFILE -1 "" 1197 -1 -1 "" "VF"]]] } {
       Log::Print INFO "Reading VF3 from GPXAUXFILE"
-      fstdfield read GRDVF3 GPXAUXFILE $idx
+      GenX::FieldRead GRDVF3 GPXAUXFILE $idx
    } else {
       Log::Print WARNING "Could not find water field VF(3)"
       return
    }
 
-   if { [llength [set idx [fstdfield find GPXOUTFILE -1 "" 1199 -1 -1 "" "VF"]]] } {
+   if { [llength [set idx [GenX::FieldFind GPXOUTFILE -1 "" 1199 -1 -1 "" "VF"]]] } {
       Log::Print INFO "Reading VF1 from GPXOUTFILE"
-      fstdfield read GRDVF1 GPXOUTFILE $idx
-   } elseif { [llength [set idx [fstdfield find GPXAUXFILE -1 "" 1199 -1 -1 "" "VF"]]] } {
+      GenX::FieldRead GRDVF1 GPXOUTFILE $idx
+   } elseif { [llength [set idx [GenX::FieldFind GPXAUXFILE -1 "" 1199 -1 -1 "" "VF"]]] } {
       Log::Print INFO "Reading VF1 from GPXAUXFILE"
-      fstdfield read GRDVF1 GPXAUXFILE $idx
+      GenX::FieldRead GRDVF1 GPXAUXFILE $idx
    } else {
       Log::Print WARNING "Could not find water field VF(1)"
       return
@@ -6072,7 +6853,7 @@ proc GeoPhysX::CheckMaskVegeConsistency {} {
    } else {
       vexpr GRDMG "1.0-GRDVF3-GRDVF1"
       fstdfield define GRDMG -NOMVAR MG -ETIKET $GenX::Param(ETIKET) -IP1 0 -DATYP $GenX::Param(Datyp)
-      fstdfield write GRDMG GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GRDMG GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
       Log::Print INFO "Since MG is created from VF1 and VF3, no need to rebalance VF fields"
       fstdfield free GRDVF3 GRDVF1 GRDMG WATER
       return
@@ -6099,7 +6880,7 @@ proc GeoPhysX::CheckMaskVegeConsistency {} {
    set kks    { 2 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 22 23 24 25 26 }
    foreach  kk  $kks {
       set  ip1  [expr 1200-$kk]
-      fstdfield read VF${kk}FLD   GPXAUXFILE   -1 "" $ip1 -1 -1 "" "VF"
+      GenX::FieldRead VF${kk}FLD   GPXAUXFILE   -1 "" $ip1 -1 -1 "" "VF"
       vexpr GPXVG ifelse(GPXTP>=VF${kk}FLD,GPXVG,$kk)
       vexpr GPXTP ifelse(GPXTP>=VF${kk}FLD,GPXTP,VF${kk}FLD)
       vexpr  SUM_VF  "SUM_VF + VF${kk}FLD"
@@ -6150,26 +6931,26 @@ proc GeoPhysX::CheckMaskVegeConsistency {} {
       vexpr SUM_VF2  "SUM_VF2 + PPVF"
       Log::Print INFO "Overwriting VF$kk"
       fstdfield define PPVF -IP1 [expr 1200-$kk] -NOMVAR VF
-      fstdfield write PPVF  GPXAUXFILE -32 True
+      GenX::FieldWrite PPVF  GPXAUXFILE -32 True
       fstdfield free VF${kk}FLD
    }
 
    fstdfield define SUM_VF2 -NOMVAR SMVF -IP1 0
-   fstdfield write SUM_VF2  GPXAUXFILE -32 True
+   GenX::FieldWrite SUM_VF2  GPXAUXFILE -32 True
 
    fstdfield define GRDVF21 -NOMVAR VF -IP1 1179
-   fstdfield write GRDVF21  GPXAUXFILE -32 True
+   GenX::FieldWrite GRDVF21  GPXAUXFILE -32 True
 
    Log::Print INFO "Overwriting VF3"
    fstdfield define GRDVF3 -NOMVAR VF -IP1 1197
-   fstdfield write GRDVF3  GPXAUXFILE -32 True
+   GenX::FieldWrite GRDVF3  GPXAUXFILE -32 True
 
    Log::Print INFO "Overwriting VF1"
    fstdfield define GRDVF1 -NOMVAR VF -IP1 1199
-   fstdfield write GRDVF1  GPXAUXFILE -32 True
+   GenX::FieldWrite GRDVF1  GPXAUXFILE -32 True
 
    fstdfield define GRDMG -NOMVAR MG -IP1 0
-   fstdfield write GRDMG  GPXAUXFILE -32 True
+   GenX::FieldWrite GRDMG  GPXAUXFILE -32 True
 
    fstdfield free GRDVF3 GRDVF1 GRDMG GPXVF GPXVGI
    fstdfield free SUM_VF SUM_VF2 VFA VFT WATER
@@ -6195,29 +6976,29 @@ proc GeoPhysX::CheckConsistencyStandard { } {
    Log::Print INFO "Applying consistency checks"
 
    #----- Read mask
-   if { [llength [set idx [fstdfield find GPXOUTFILE -1 "" -1 -1 -1 "" "MG"]]] } {
-      fstdfield read GPXMG GPXOUTFILE $idx
+   if { [llength [set idx [GenX::FieldFind GPXOUTFILE -1 "" -1 -1 -1 "" "MG"]]] } {
+      GenX::FieldRead GPXMG GPXOUTFILE $idx
    } else {
       Log::Print WARNING "Could not find mask field MG"
    }
 
    #----- Read ice coverage VF(2)
-   if { [llength [set idx [fstdfield find GPXAUXFILE -1 "" 1198 -1 -1 "" "VF"]]] } {
-      fstdfield read GPXVF2 GPXAUXFILE $idx
+   if { [llength [set idx [GenX::FieldFind GPXAUXFILE -1 "" 1198 -1 -1 "" "VF"]]] } {
+      GenX::FieldRead GPXVF2 GPXAUXFILE $idx
    } else {
       Log::Print WARNING "Could not find ice field VF(2)"
    }
 
    #----- Read water coverage VF(3)
-   if { [llength [set idx [fstdfield find GPXAUXFILE -1 "" 1197 -1 -1 "" "VF"]]] } {
-      fstdfield read GPXVF3 GPXAUXFILE $idx
+   if { [llength [set idx [GenX::FieldFind GPXAUXFILE -1 "" 1197 -1 -1 "" "VF"]]] } {
+      GenX::FieldRead GPXVF3 GPXAUXFILE $idx
    } else {
       Log::Print WARNING "Could not find water field VF(3)"
    }
 
    #----- Check consistency for VF
    foreach type $Param(VegeTypes) {
-      if { ![catch { fstdfield read GPXVF GPXAUXFILE -1 "" [expr 1200-$type] -1 -1 "" "VF" }] } {
+      if { ![catch { GenX::FieldRead GPXVF GPXAUXFILE -1 "" [expr 1200-$type] -1 -1 "" "VF" }] } {
          if { [fstdfield is GPXVF3] && [fstdfield is GPXMG] } {
             if { $type==1 } {
                vexpr GPXVF ifelse(GPXMG==0.0 && GPXVF3==0.0,1.0,GPXVF)
@@ -6229,7 +7010,7 @@ proc GeoPhysX::CheckConsistencyStandard { } {
             break
          }
          fstdfield define GPXVF -NOMVAR VF -ETIKET $GenX::Param(ETIKET) -IP1 [expr 1200-$type] -DATYP $GenX::Param(Datyp)
-         fstdfield write GPXVF GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+         GenX::FieldWrite GPXVF GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
       } else {
          Log::Print WARNING "Could not find VF($type) field while checking VF"
          break
@@ -6239,7 +7020,7 @@ proc GeoPhysX::CheckConsistencyStandard { } {
    if { [fstdfield is GPXVF2] } {
       GeoPhysX::Compute_GA GPXGA GPXVF2
       fstdfield define GPXGA -NOMVAR GA -ETIKET $GenX::Param(ETIKET) -IP1 0 -DATYP $GenX::Param(Datyp)
-      fstdfield write GPXGA GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXGA GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
 
       #----- Calculate Dominant type and save
       GeoPhysX::DominantVege GPXVF2
@@ -6249,7 +7030,7 @@ proc GeoPhysX::CheckConsistencyStandard { } {
 
    #----- Check consistency for J1 and J2
    foreach type $Param(SandTypes) {
-      if { ![catch { fstdfield read GPXJ1 GPXAUXFILE -1 "" [expr 1200-$type] -1 -1 "" "J1" }] } {
+      if { ![catch { GenX::FieldRead GPXJ1 GPXAUXFILE -1 "" [expr 1200-$type] -1 -1 "" "J1" }] } {
          if { [fstdfield is GPXVF2] } {
             vexpr GPXJ1 ifelse(GPXVF2==1.0,43.0,GPXJ1)
          } else {
@@ -6262,14 +7043,14 @@ proc GeoPhysX::CheckConsistencyStandard { } {
             Log::Print WARNING "Could not find MG field, will not do the consistency check between MG and J1"
          }
          fstdfield define GPXJ1 -NOMVAR J1 -ETIKET $GenX::Param(ETIKET) -IP1 [expr 1200-$type] -DATYP $GenX::Param(Datyp)
-         fstdfield write GPXJ1 GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+         GenX::FieldWrite GPXJ1 GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
       } else {
          Log::Print WARNING "Could not find J1($type) field, will not do the consistency check on J1($type)"
       }
    }
 
    foreach type $Param(ClayTypes) {
-      if { ![catch { fstdfield read GPXJ2 GPXAUXFILE -1 "" [expr 1200-$type] -1 -1 "" "J2" }] } {
+      if { ![catch { GenX::FieldRead GPXJ2 GPXAUXFILE -1 "" [expr 1200-$type] -1 -1 "" "J2" }] } {
          if { [fstdfield is GPXVF2] } {
             vexpr GPXJ2 ifelse(GPXVF2==1.0,19.0,GPXJ2)
          } else {
@@ -6283,7 +7064,7 @@ proc GeoPhysX::CheckConsistencyStandard { } {
             break
          }
          fstdfield define GPXJ2 -NOMVAR J2 -ETIKET $GenX::Param(ETIKET) -IP1 [expr 1200-$type] -DATYP $GenX::Param(Datyp)
-         fstdfield write GPXJ2 GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+         GenX::FieldWrite GPXJ2 GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
       } else {
          Log::Print WARNING "Could not find J2($type) field, will not do the consistency check on J2($type)"
       }
@@ -6316,8 +7097,8 @@ proc GeoPhysX::CheckLegacyVG { } {
    #----- Check consistency for ME
    #----- Read ME
    if { [catch {
-      fstdfield read GPXMG   GPXOUTFILE -1 "" -1 -1 -1 "" "MG"
-      fstdfield read GPXVG   GPXOUTFILE -1 "" -1 -1 -1 "" "VG" } ] } {
+      GenX::FieldRead GPXMG   GPXOUTFILE -1 "" -1 -1 -1 "" "MG"
+      GenX::FieldRead GPXVG   GPXOUTFILE -1 "" -1 -1 -1 "" "VG" } ] } {
       Log::Print WARNING "Missing fields, will not check ME consistency with MG"
       return
    }
@@ -6358,7 +7139,7 @@ proc GeoPhysX::CheckLegacyVG { } {
    }
 
 #   rewrite VG
-   fstdfield write GPXVG GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXVG GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
 
    fstdfield free GPXVG GPXMG
 }
@@ -6463,7 +7244,7 @@ proc GeoPhysX::Compute_GA  { GPXGA VF2 } {
    GenX::GridClear SUMVF4_26 0.0
 
    foreach type [lrange $Param(VegeTypes) 3 end] {
-      if { ![catch { fstdfield read GPXVF GPXOUTFILE -1 "" [expr 1200-$type] -1 -1 "" "VF" }] } {
+      if { ![catch { GenX::FieldRead GPXVF GPXOUTFILE -1 "" [expr 1200-$type] -1 -1 "" "VF" }] } {
          vexpr SUMVF4_26  SUMVF4_26+GPXVF
       } else {
          Log::Print WARNING "Could not find VF($type) field while processing VG"
@@ -6501,7 +7282,7 @@ proc GeoPhysX::DominantVege { Grid } {
 
    #----- Generate VG field (Dominant type per cell)
    foreach type $Param(VegeTypes) {
-      if { ![catch { fstdfield read GPXVF GPXOUTFILE -1 "" [expr 1200-$type] -1 -1 "" "VF" }] } {
+      if { ![catch { GenX::FieldRead GPXVF GPXOUTFILE -1 "" [expr 1200-$type] -1 -1 "" "VF" }] } {
          vexpr GPXVG ifelse(GPXTP>=GPXVF,GPXVG,$type)
          vexpr GPXTP ifelse(GPXTP>=GPXVF,GPXTP,GPXVF)
       } else {
@@ -6509,7 +7290,7 @@ proc GeoPhysX::DominantVege { Grid } {
       }
    }
    fstdfield define GPXVG -NOMVAR VG -ETIKET $GenX::Param(ETIKET) -IP1 0 -IP2 0 -DATYP $GenX::Param(Datyp)
-   fstdfield write GPXVG GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXVG GPXOUTFILE -$GenX::Param(CappedNBits) True $GenX::Param(Compress)
 
    fstdfield free GPXVF GPXVG GPXTP
 }
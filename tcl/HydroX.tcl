@@ -15,6 +15,7 @@
 # Functions :
 #
 #   HydroX::DrainDensity { Grid }
+#   HydroX::DrainAccumulate { Rivers Lakes la0 lo0 la1 lo1 { Max False } }
 #
 #============================================================================
 
@@ -24,6 +25,7 @@ namespace eval HydroX { } {
    global env
 
    set Param(Version)   0.1
+   set Param(Threads)   0       ;# Number of threads for drainage accumulation (0: all processors)
 }
 
 #----------------------------------------------------------------------------
@@ -66,8 +68,8 @@ proc HydroX::DrainDensity { Grid } {
    }
 
    #----- Read mask
-   if { [llength [set idx [fstdfield find GPXOUTFILE -1 "" -1 -1 -1 "" "MG"]]] } {
-      fstdfield read GPXMG GPXOUTFILE $idx
+   if { [llength [set idx [GenX::FieldFind GPXOUTFILE -1 "" -1 -1 -1 "" "MG"]]] } {
+      GenX::FieldRead GPXMG GPXOUTFILE $idx
    } else {
       Log::Print WARNING "Could not find mask field MG"
    }
@@ -108,17 +110,7 @@ proc HydroX::DrainDensity { Grid } {
 
 # compute DCW values separately and take the maximum with HSRN
    if { $DCW } {
-      fstdfield copy GPXRIVERSUM2 $Grid
-      fstdfield copy GPXLAKESUM2  $Grid
-      fstdfield copy GPXLAKEAREA2 $Grid
-
       HydroX::DrainDensityDCW $Grid $la0 $lo0 $la1 $lo1 $clipped_dcw
-
-      vexpr GPXRIVERSUM  max(GPXRIVERSUM2,GPXRIVERSUM)
-      vexpr GPXLAKESUM   max(GPXLAKESUM2,GPXLAKESUM)
-      vexpr GPXLAKEAREA  max(GPXLAKEAREA2,GPXLAKEAREA)
-
-      fstdfield free GPXRIVERSUM2 GPXLAKESUM2 GPXLAKEAREA2
    }
 
    if { $NHN } {
@@ -143,21 +135,66 @@ proc HydroX::DrainDensity { Grid } {
    #----- Sauvagerdons le tout
 
    fstdfield define $Grid -NOMVAR DRND -IP1 1200
-   fstdfield write $Grid GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite $Grid GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    fstdfield define GPXRIVERSUM -NOMVAR RSUM -IP1 1200
-   fstdfield write GPXRIVERSUM GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXRIVERSUM GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 #   fstdfield define GPXLAKESUM -NOMVAR LSUM -IP1 1200
-#   fstdfield write GPXLAKESUM GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+#   GenX::FieldWrite GPXLAKESUM GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    if { ![fstdfield is GPXMG] } {
       fstdfield define GPXLAKEAREA -NOMVAR LARE -IP1 1200
-      fstdfield write GPXLAKEAREA GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXLAKEAREA GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    }
 
    fstdfield free GPXRIVERSUM GPXLAKESUM GPXLAKEAREA GPXMG
 }
 
+#----------------------------------------------------------------------------
+# Name     : <HydroX::DrainAccumulate>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Accumulate river lengths, lake perimeters and lake areas of a
+#            database into GPXRIVERSUM, GPXLAKESUM and GPXLAKEAREA
+#
+# Parameters :
+#   <Rivers> : River files
+#   <Lakes>  : Lake files
+#   <la0>    : Grid lower latitude
+#   <lo0>    : Grid lower longitude
+#   <la1>    : Grid upper latitude
+#   <lo1>    : Grid upper longitude
+#   <Max>    : Keep the maximum with the current values instead of adding
+#
+# Return:
+#
+# Remarks :
+#   - Features are clipped to the grid cells natively and in parallel
+#     (see Param(Threads)), in a single call per database
+#
+#----------------------------------------------------------------------------
+proc HydroX::DrainAccumulate { Rivers Lakes la0 lo0 la1 lo1 { Max False } } {
+   variable Param
+
+# we dont need lake area if we use MG
+   set lakearea GPXLAKEAREA
+   if { [fstdfield is GPXMG] } {
+      set lakearea ""
+   }
+
+   set options [list -limits [list $la0 $lo0 $la1 $lo1] -threads $Param(Threads)]
+   if { $Max } {
+      lappend options -max
+   }
+
+   set res [eval [list geophy draindensity GPXRIVERSUM GPXLAKESUM $lakearea $Rivers $Lakes] $options]
+   Log::Print DEBUG "   Accumulated [lindex $res 0] features from [llength $Rivers] river and [llength $Lakes] lake files"
+
+   if { [lindex $res 1] } {
+      Log::Print WARNING "   Skipped [lindex $res 1] segments crossing the grid seam, their lengths are not accounted for"
+   }
+}
+
 #----------------------------------------------------------------------------
 # Name     : <HydroX::DrainDensityNHN>
 # Creation : August 2011 - J.P. Gauthier - CMC/CMOE
@@ -183,48 +220,32 @@ proc HydroX::DrainDensityNHN { Grid la0 lo0 la1 lo1 } {
    GenX::Procs NHN
    #----- Lire les donnees des rivieres Canadiennes de NHN
 
-   set n 0
-   set files [GenX::NHNFindFiles $la0 $lo0 $la1 $lo1]
+   set n      0
+   set files  [GenX::NHNFindFiles $la0 $lo0 $la1 $lo1]
+   set rivers {}
+   set lakes  {}
 
    foreach path $files {
       Log::Print DEBUG "   Processing NHN path $path ([incr n]/[llength $files])"
 
       #----- Lire la donnee des rivieres
-      if { [catch "glob ${path}_?_?_HD_COURSDEAU_1.shp" rivers] } {
-         if { [catch "glob ${path}_?_?_RH_FILAMENT_1.shp" rivers] } {
-            set rivers {}
+      if { [catch "glob ${path}_?_?_HD_COURSDEAU_1.shp" found] } {
+         if { [catch "glob ${path}_?_?_RH_FILAMENT_1.shp" found] } {
+            set found {}
             Log::Print DEBUG "  Cannot find river file for path $path"
          }
       }
-      foreach file $rivers {
-         set layers [ogrfile open FILERIVER read ${file}]
-         ogrlayer read LINES FILERIVER 0
-
-         fstdfield gridinterp GPXRIVERSUM LINES LENGTH_CONSERVATIVE FEATURE_LENGTH_METER
-
-         ogrfile close FILERIVER
-      }
+      set rivers [concat $rivers $found]
 
       #----- Lire la donnee des lacs
-      if { [catch "glob ${path}_?_?_HD_REGIONHYDRO_2.shp" lakes] } {
-         set lakes {}
+      if { [catch "glob ${path}_?_?_HD_REGIONHYDRO_2.shp" found] } {
+         set found {}
          Log::Print DEBUG "  Cannot find lakes file for path $path"
       }
-      foreach file $lakes {
-         set layers [ogrfile open FILELAKE read ${file}]
-         ogrlayer read AREAS FILELAKE 0
-
-         fstdfield gridinterp GPXLAKESUM  AREAS LENGTH_CONSERVATIVE FEATURE_LENGTH_METER
-
-# we dont need lake area if we use MG
-         if {  ![fstdfield is GPXMG] } {
-            fstdfield gridinterp GPXLAKEAREA AREAS CONSERVATIVE FEATURE_AREA_METER
-         }
-
-         ogrfile close  FILELAKE
-      }
+      set lakes [concat $lakes $found]
    }
 
+   HydroX::DrainAccumulate $rivers $lakes $la0 $lo0 $la1 $lo1
 }
 
 #----------------------------------------------------------------------------
@@ -251,20 +272,10 @@ proc HydroX::DrainDensityNHD { Grid la0 lo0 la1 lo1 } {
 
    GenX::Procs NHD
    #----- Lire les donnees des rivieres USA de NHD
-   set n 0
    set files  [GenX::NHDFindFiles $la0 $lo0 $la1 $lo1]
 
-   set cnt  [llength $files]
-   foreach file $files {
-      Log::Print DEBUG "   Processing NHD file $file ([incr n]/$cnt)" False
-
-      set layers [ogrfile open FILERIVER read ${file}]
-      ogrlayer read LINES FILERIVER 0
-      fstdfield gridinterp GPXRIVERSUM LINES LENGTH_CONSERVATIVE FEATURE_LENGTH_METER
-      ogrfile close FILERIVER
-   }
-
-   ogrlayer free LINES AREAS
+   Log::Print DEBUG "   Processing [llength $files] NHD files"
+   HydroX::DrainAccumulate $files {} $la0 $lo0 $la1 $lo1
 }
 
 #----------------------------------------------------------------------------
@@ -299,16 +310,13 @@ proc HydroX::DrainDensityHSRN { Grid la0 lo0 la1 lo1 clipped } {
       set regions [GenX::FindFiles $usgsdir/Index/index_usgs_rn.shp $Grid]
    }
    
-   set  n        0
-   set  cnt      [llength $regions]
+   set rivers {}
    foreach file $regions {
-      Log::Print DEBUG "   Processing USGS HydroSHEDS file $file ([incr n]/$cnt)" False
-
-      set layers [ogrfile open FILERIVER read ${usgsdir}${file}]
-      ogrlayer read LINES FILERIVER 0
-      fstdfield gridinterp GPXRIVERSUM LINES LENGTH_CONSERVATIVE FEATURE_LENGTH_METER
-      ogrfile close FILERIVER
+      lappend rivers ${usgsdir}${file}
    }
+
+   Log::Print DEBUG "   Processing [llength $rivers] USGS HydroSHEDS files"
+   HydroX::DrainAccumulate $rivers {} $la0 $lo0 $la1 $lo1
 }
 
 #----------------------------------------------------------------------------
@@ -343,13 +351,9 @@ proc HydroX::DrainDensityDCW { Grid la0 lo0 la1 lo1 clipped } {
    } else {
       set cells [GenX::FindFiles $dcwdir/Index/index_dcw_rivers.shp $Grid]
    }
+   set rivers {}
    foreach cfile $cells {
-      set file  "$dcwdir/rivers/$cfile"
-      Log::Print INFO "Processing : $file"
-      ogrfile open RIVERFILE read $file
-      ogrlayer read LINES RIVERFILE 0
-      fstdfield gridinterp GPXRIVERSUM2 LINES  LENGTH_CONSERVATIVE FEATURE_LENGTH_METER
-      ogrfile close RIVERFILE
+      lappend rivers "$dcwdir/rivers/$cfile"
    }
 
    if { $clipped } {
@@ -357,18 +361,14 @@ proc HydroX::DrainDensityDCW { Grid la0 lo0 la1 lo1 clipped } {
    } else {
       set cells [GenX::FindFiles $dcwdir/Index/index_dcw_lakes.shp $Grid]
    }
+   set lakes {}
    foreach cfile $cells {
-      set file  "$dcwdir/lakes/$cfile"
-      Log::Print INFO "Processing : $file"
-      ogrfile open LAKEFILE read $file
-      ogrlayer read AREAS LAKEFILE 0
-      fstdfield gridinterp GPXLAKESUM2 AREAS  LENGTH_CONSERVATIVE FEATURE_LENGTH_METER
-# we dont need lake area if we use MG
-      if {  ![fstdfield is GPXMG] } {
-         fstdfield gridinterp GPXLAKEAREA2 AREAS CONSERVATIVE FEATURE_AREA_METER
-      }
-      ogrfile close LAKEFILE
+      lappend lakes "$dcwdir/lakes/$cfile"
    }
+
+# DCW values are computed separately and the maximum is kept with current values
+   Log::Print INFO "Processing [llength $rivers] DCW river and [llength $lakes] lake files"
+   HydroX::DrainAccumulate $rivers $lakes $la0 $lo0 $la1 $lo1 True
 }
 
 #----------------------------------------------------------------------------
@@ -148,11 +148,11 @@ proc UrbanPhysX::Cover { Grid } {
    GenX::GridClear { GPXSUM GPXZ0 GPXAGG } 0.0
 
    #----- Read urban classification
-   fstdfield read GPXUF GPXOUTFILE -1 "" -1 -1 -1 "" "UF"
+   GenX::FieldRead GPXUF GPXOUTFILE -1 "" -1 -1 -1 "" "UF"
    fstdfield readcube GPXUF
 
    #----- Read vege classification
-   fstdfield read GPXVF GPXOUTFILE -1 "" -1 -1 -1 "" "VF"
+   GenX::FieldRead GPXVF GPXOUTFILE -1 "" -1 -1 -1 "" "VF"
    fstdfield readcube GPXVF
 
    #----- Calculation of urban fraction and built-up fraction
@@ -162,7 +162,7 @@ proc UrbanPhysX::Cover { Grid } {
    }
    #----- Save urban UR field
    fstdfield define GPXSUM -NOMVAR UR -IP1 0
-   fstdfield write GPXSUM GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite GPXSUM GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    #----- Remove urban class (21)
    vexpr GPXVF GPXVF()()(20) = 0.0
@@ -187,7 +187,7 @@ proc UrbanPhysX::Cover { Grid } {
    }
 
    #----- Save urban adjusted vege
-   fstdfield write GPXVF GPXAUXFILE -$GenX::Param(NBits) False $GenX::Param(Compress)
+   GenX::FieldWrite GPXVF GPXAUXFILE -$GenX::Param(NBits) False $GenX::Param(Compress)
 
    #----- Parse each urban characteristic
    foreach type $Param(Types) var $Param(Vars) ip1 $Param(IP1s) {
@@ -207,7 +207,7 @@ proc UrbanPhysX::Cover { Grid } {
 
       #----- Save urban fields
       fstdfield define GPXAGG -NOMVAR $var -IP1 $ip1
-      fstdfield write GPXAGG GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXAGG GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    }
 
 #   #----- Dynamical roughness calculation for vegetation and soils
@@ -220,7 +220,7 @@ proc UrbanPhysX::Cover { Grid } {
 #   vexpr GPXZ0 exp(GPXZ0)
 
 #   fstdfield define GPXZ0 -NOMVAR Z0TO
-#   fstdfield write GPXZ0 GPXOUTFILE -$GenX::Param(NBits) False  $GenX::Param(Compress)
+#   GenX::FieldWrite GPXZ0 GPXOUTFILE -$GenX::Param(NBits) False  $GenX::Param(Compress)
 
    fstdfield free GPXSUM GPXAGG GPXVF GPXUF GPXZ0
 }
\ No newline at end of file
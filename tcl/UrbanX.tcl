@@ -54,6 +54,9 @@ namespace eval UrbanX { } {
    set Param(OMP_Threads)         0     ;# No threads By default
    set Param(NbThreads)           0     ;# No threads By default
    set Param(NPROCS)              0     ;# No threads By default
+   set Param(SandwichOps)        32     ;# Maximum number of rasterizations per CanVec layer (threaded sandwich ranks)
+   set Param(RCULUC)         RCULUC     ;# Name of the CULUC raster of the sheet processed by a TEB task
+   set Param(IJCULUC)        IJCULUC    ;# Name of the grid index raster of the sheet processed by a TEB task
    set err [catch { exec nproc --all } Param(NPROCS)]
    array set  Threads            {}     ;# empty array
    # Optional TEB parameters - they are not computed by default in order to reduce processing time
@@ -464,6 +467,7 @@ proc UrbanX::AreaDefine { Coverage Grid } {
 # Return: output genphysx_sandwich.tif
 #
 # Remarks :
+#    - When threads are enabled, layers are rasterized in parallel (see UrbanX::SandwichThreads)
 #
 #----------------------------------------------------------------------------
 proc UrbanX::Sandwich { indexCouverture } {
@@ -477,414 +481,635 @@ proc UrbanX::Sandwich { indexCouverture } {
    gdalband define RSANDWICH -georef $Param(SheetGeoRef)
 
    #----- Rasterization of CanVec layers
+   if { $Param(NbThreads) > 0 } {
+      UrbanX::SandwichThreads $indexCouverture
+   } else {
+      foreach file $Param(Files) {
+         UrbanX::SandwichLayer RSANDWICH $file -1 $indexCouverture
+      }
+   }
+
+   file delete -force $GenX::Param(TMPDIR)/$Param(NTSSheet)_sandwich.tif
+   gdalfile open FILEOUT write $GenX::Param(TMPDIR)/$Param(NTSSheet)_sandwich.tif GeoTiff
+   gdalband write RSANDWICH FILEOUT
+   gdalfile close FILEOUT
+   Log::Print INFO "The file $GenX::Param(TMPDIR)/$Param(NTSSheet)_sandwich.tif has been generated"
+
+   gdalband free RSANDWICH
+}
+
+#----------------------------------------------------------------------------
+# Name     : <UrbanX::SandwichThreads>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Rasterize the CanVec layers in parallel into per thread partial
+#            rasters and merge them into RSANDWICH
+#
+# Parameters :
+#   <Coverage> : Coverage being processed
+#
+# Return:
+#
+# Remarks :
+#    - Partial rasters hold the rank of the last rasterization (file order times
+#      Param(SandwichOps) plus the rasterization order within the file) instead
+#      of the priority value. Since each thread processes its files in increasing
+#      order, a max reduction of the ranks gives back, for each pixel, the last
+#      rasterization of the sequential procedure and the rank is then converted
+#      to its priority value, matching the sequential result exactly
+#
+#----------------------------------------------------------------------------
+proc UrbanX::SandwichThreads { Coverage } {
+   variable Param
+   variable Threads
+   global   sandwich_done
+
+   UrbanX::Initialize_Threads
+
+   #----- Use the smallest type able to hold every rank
+   if { [expr ([llength $Param(Files)]+1)*$Param(SandwichOps)]<65535 } {
+      set type UInt16
+   } else {
+      set type UInt32
+   }
+
+   set idle {}
+   foreach i [array names Threads] {
+      gdalband create RSANDWICH.$Threads($i) $Param(Width) $Param(Height) 1 $type
+      gdalband define RSANDWICH.$Threads($i) -georef $Param(SheetGeoRef)
+      lappend idle $Threads($i)
+   }
+
+   set update_params {NTSSheet Width Height SheetGeoRef Deg2M}
+   set update_values "\"$Param(NTSSheet)\" $Param(Width) $Param(Height) \"$Param(SheetGeoRef)\" $Param(Deg2M)"
+
+   #----- Dispatch files in order to the first idle thread, stop dispatching on the first error
+   set ranks  { 0 0 }
+   set seq    0
+   set nbusy  0
+   set errors {}
    foreach file $Param(Files) {
-      # Adjusting variables lenght if the layer contains the additionnal _QC_ identifier
-      if { [lsearch $file "*_QC_*"] !=-1 } {
-         # Case of a _QC_ layer
-         # entity contains an element of the form QC_AA_9999999_9
-         set entity [string range [file tail $file] 11 25] ;# strip full file path to keep layer name only
-         # filename contains an element of the form 999a99_9_9_QC_AA_9999999_9
-         set filename [string range [file tail $file] 0 25] ;# required by ogrlayer sqlselect
-      } else {
-         # entity contains an element of the form AA_9999999_9
-         set entity [string range [file tail $file] 11 22] ;# strip full file path to keep layer name only
-         # filename contains an element of the form 999a99_9_9_AA_9999999_9
-         set filename [string range [file tail $file] 0 22] ;# required by ogrlayer sqlselect
+      if { ![llength $idle] } {
+         vwait sandwich_done
+         lappend idle [lindex $sandwich_done 0]
+         set ranks [concat $ranks [lindex $sandwich_done 1]]
+         if { [lindex $sandwich_done 2]!="" } {
+            lappend errors [lindex $sandwich_done 2]
+         }
+         incr nbusy -1
       }
-      set priority [lindex $Param(Priorities) [lsearch -exact $Param(Entities) $entity]]
-      Log::Print DEBUG "Processing entity: $entity, priority: $priority, filename: $filename, file: $file"
+      if { [llength $errors] } {
+         break
+      }
+      set tid  [lindex $idle 0]
+      set idle [lrange $idle 1 end]
+      Log::Print DEBUG "Send $file to thread : $tid"
+      thread::send -async $tid "UrbanX::SandwichTask $tid \"$file\" $seq \"$Coverage\" {$update_params} {$update_values}" sandwich_done
+      incr seq
+      incr nbusy
+   }
 
-      # Value contains the nth element of the list Param(Priorities), where n is the index of layer in the list Param(Entities)
-      ogrfile open SHAPE read $file
+   #----- Wait for the remaining threads
+   while { $nbusy } {
+      vwait sandwich_done
+      set ranks [concat $ranks [lindex $sandwich_done 1]]
+      if { [lindex $sandwich_done 2]!="" } {
+         lappend errors [lindex $sandwich_done 2]
+      }
+      incr nbusy -1
+   }
 
-      # The following if/else evaluates if the layer requires some post-processing prior to rasterization or if it is rasterized with the generic procedure
-      if { [lsearch -exact $Param(LayersPostPro) $entity] !=-1 } {
+   #----- Errors of the threads are raised in the main interpreter
+   if { [llength $errors] } {
+      foreach i [array names Threads] {
+         gdalband free RSANDWICH.$Threads($i)
+      }
+      error "Sandwich rasterization failed: [join $errors {; }]"
+   }
 
-         switch $entity {
-            BS_1370009_2 {
-            # Residential areas
-            # Lors de la procdure sandwich, l'entit prend entirement les valeurs suivantes : PRI = 218 ; TEB = 210 ; SMO = 1
-            # Lors de la procdure PopDens2Builtup, l'entit est dcoupe selon des seuils de densit de population
-               Log::Print DEBUG "Post-processing for Residential area, area"
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\""
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity as FEATURES with priority value 218"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 218
-            }
-            BS_2010009_0 {
-               # entity : Building, points
-               Log::Print DEBUG "Post-processing for buildings, points buffered to 12m"
-
-               set types { "arena" "armoury" "city hall" "coast guard station" "community center" "courthouse" "custom post" "electric power station" "fire station" "highway service center" \
-                           "hospital" "medical center" "municipal hall" "gas and oil facilities building" "parliament building" "police station" "railway station" "satellite-tracking station" \
-                           "sportsplex" "industrial building" "religious building" "penal building" "educational building" }
-               set funcs {  1  2  5  6  7  8  9 11 12 16 17 19 20 23 25 26 27 29 32 37 38 39 41 }
-               set vals  { 32 31 30 29 28 27 26 25 24 23 22 21 20 19 18 17 16 15 14 13 12 11 10 }
-
-               foreach type $types func $funcs val $vals {
-                  ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (function = $func)"
-                  ogrlayer stats FEATURES -buffer [expr $Param(Deg2M)*6] 8 ;# 6m x 2 : effectue un buffer autour du point, d'un rayon de 6 mtres.  Le point occupera donc au minimum 3 pixels X 3 pixels
-                  Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity ($type) as FEATURES with priority value $val"
-                  gdalband gridinterp RSANDWICH FEATURES $Param(Mode) $val
-               }
+   #----- Max reduction of ranks then convert back to priority values
+   Log::Print DEBUG "Merging [array size Threads] partial rasters"
+   set bands [lsort [array names Threads]]
+   gdalband copy RSANDWICHRANK RSANDWICH.$Threads([lindex $bands 0])
+   foreach i [lrange $bands 1 end] {
+      vexpr RSANDWICHRANK max(RSANDWICHRANK,RSANDWICH.$Threads($i))
+   }
+   foreach i $bands {
+      gdalband free RSANDWICH.$Threads($i)
+   }
 
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE function NOT IN ([join $funcs ,])"
-               ogrlayer stats FEATURES -buffer [expr $Param(Deg2M)*6] 8 ;# 6m x 2 : effectue un buffer autour du point, d'un rayon de 6 mtres.  Le point occupera donc au minimum 3 pixels X 3 pixels
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (general) as FEATURES with priority value 33"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 33
-            }
-            BS_2010009_2 {
-               Log::Print DEBUG "Post-processing for buildings, areas"
-               set types { "arena" "armoury" "city hall" "coast guard station" "community center" "courthouse" "custom post" "electric power station" "fire station" "highway service center" \
-                           "hospital" "medical center" "municipal hall" "gas and oil facilities building" "parliament building" "police station" "railway station" "satellite-tracking station" \
-                           "sportsplex" "industrial building" "religious building" "penal building" "educational building" }
-               set funcs {   1   2   5   6  7  8  9 11 12 16 17 19 20 23 25 26 27 29 32 37 38 39 41 }
-               set vals  { 103 102 101 100 99 98 97 96 95 94 93 92 91 90 89 88 87 86 85 84 83 82 81 }
-
-               foreach type $types func $funcs val $vals {
-                  ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE FUNCTION = $func"
-                  Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity ($type) as FEATURES with priority value $val"
-                  gdalband gridinterp RSANDWICH FEATURES $Param(Mode) $val
-               }
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE function NOT IN ([join $funcs ,])"
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (general) as FEATURES with priority value 104"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 104
+   set from {}
+   set to   {}
+   foreach { rank value } $ranks {
+      lappend from $rank
+      lappend to   $value
+   }
+   vector create FROMRANK $from
+   vector create TOPRIORITY $to
+   vexpr (UInt16)RSANDWICH lut(RSANDWICHRANK,FROMRANK,TOPRIORITY)
+   gdalband define RSANDWICH -georef $Param(SheetGeoRef)
+
+   gdalband free RSANDWICHRANK
+   vector free FROMRANK TOPRIORITY
+}
+
+#----------------------------------------------------------------------------
+# Name     : <UrbanX::SandwichTask>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Thread task rasterizing a CanVec file in the thread's partial raster
+#
+# Parameters :
+#   <Tid>      : Thread id
+#   <File>     : CanVec file
+#   <Seq>      : File order
+#   <Coverage> : Coverage being processed
+#   <Params>   : UrbanX parameters to update in the thread
+#   <Values>   : Values of the parameters
+#
+# Return:
+#   <Result>   : Thread id, list of rank/priority value pairs used and error message
+#
+# Remarks :
+#    - Errors are returned instead of raised since an asynchronous send would
+#      drop them
+#
+#----------------------------------------------------------------------------
+proc UrbanX::SandwichTask { Tid File Seq Coverage Params Values } {
+   variable Param
+
+   foreach name $Params value $Values {
+      set UrbanX::Param($name) $value
+   }
+   if { [catch { set ranks [UrbanX::SandwichLayer RSANDWICH.$Tid $File $Seq $Coverage] } msg] } {
+      return [list $Tid {} "$File: $msg"]
+   }
+   return [list $Tid $ranks ""]
+}
+
+#----------------------------------------------------------------------------
+# Name     : <UrbanX::SandwichRasterize>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Rasterize features with a priority value, or with their rank
+#            when building a partial raster
+#
+# Parameters :
+#   <Band>     : Raster to rasterize into
+#   <Features> : Features to rasterize
+#   <Seq>      : File order (-1 for direct priority rasterization)
+#   <Op>       : Rasterization order within the file
+#   <Value>    : Priority value
+#
+# Return:
+#
+# Remarks :
+#
+#----------------------------------------------------------------------------
+proc UrbanX::SandwichRasterize { Band Features Seq Op Value } {
+   variable Param
+
+   if { $Seq<0 } {
+      gdalband gridinterp $Band $Features $Param(Mode) $Value
+   } else {
+      #----- A rank past the file range would overlap the next file's ranks and break priorities
+      if { $Op>=$Param(SandwichOps) } {
+         error "Too many rasterizations for a single layer ($Op), increase Param(SandwichOps)"
+      }
+      set rank [expr $Seq*$Param(SandwichOps)+$Op]
+      lappend Param(SandwichRanks) $rank $Value
+      gdalband gridinterp $Band $Features $Param(Mode) $rank
+   }
+}
+
+#----------------------------------------------------------------------------
+# Name     : <UrbanX::SandwichLayer>
+# Creation : date? - Alexandre Leroux - CMC/CMOE
+# Revision : July 2010 - Lucie Boucher - CMC/AQMAS
+#
+# Goal     : Rasterize a CanVec layer, either with a general procedure or
+#            with some post-processing
+#
+# Parameters :
+#   <Band>     : Raster to rasterize into
+#   <File>     : CanVec file
+#   <Seq>      : File order (-1 for direct priority rasterization)
+#   <Coverage> : Coverage being processed
+#
+# Return:
+#   <Ranks>    : List of rank/priority value pairs used
+#
+# Remarks :
+#
+#----------------------------------------------------------------------------
+proc UrbanX::SandwichLayer { Band File Seq Coverage } {
+   variable Param
+
+   set shape    SHAPE$Band
+   set features FEATURES$Band
+   set op       0
+   set Param(SandwichRanks) {}
+
+   # Adjusting variables lenght if the layer contains the additionnal _QC_ identifier
+   if { [lsearch $File "*_QC_*"] !=-1 } {
+      # Case of a _QC_ layer
+      # entity contains an element of the form QC_AA_9999999_9
+      set entity [string range [file tail $File] 11 25] ;# strip full file path to keep layer name only
+      # filename contains an element of the form 999a99_9_9_QC_AA_9999999_9
+      set filename [string range [file tail $File] 0 25] ;# required by ogrlayer sqlselect
+   } else {
+      # entity contains an element of the form AA_9999999_9
+      set entity [string range [file tail $File] 11 22] ;# strip full file path to keep layer name only
+      # filename contains an element of the form 999a99_9_9_AA_9999999_9
+      set filename [string range [file tail $File] 0 22] ;# required by ogrlayer sqlselect
+   }
+   set priority [lindex $Param(Priorities) [lsearch -exact $Param(Entities) $entity]]
+   Log::Print DEBUG "Processing entity: $entity, priority: $priority, filename: $filename, file: $File"
+
+   # Value contains the nth element of the list Param(Priorities), where n is the index of layer in the list Param(Entities)
+   ogrfile open $shape read $File
+
+   # The following if/else evaluates if the layer requires some post-processing prior to rasterization or if it is rasterized with the generic procedure
+   if { [lsearch -exact $Param(LayersPostPro) $entity] !=-1 } {
+
+      switch $entity {
+         BS_1370009_2 {
+         # Residential areas
+         # Lors de la procdure sandwich, l'entit prend entirement les valeurs suivantes : PRI = 218 ; TEB = 210 ; SMO = 1
+         # Lors de la procdure PopDens2Builtup, l'entit est dcoupe selon des seuils de densit de population
+            Log::Print DEBUG "Post-processing for Residential area, area"
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\""
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity as FEATURES with priority value 218"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] 218
+         }
+         BS_2010009_0 {
+            # entity : Building, points
+            Log::Print DEBUG "Post-processing for buildings, points buffered to 12m"
+
+            set types { "arena" "armoury" "city hall" "coast guard station" "community center" "courthouse" "custom post" "electric power station" "fire station" "highway service center" \
+                        "hospital" "medical center" "municipal hall" "gas and oil facilities building" "parliament building" "police station" "railway station" "satellite-tracking station" \
+                        "sportsplex" "industrial building" "religious building" "penal building" "educational building" }
+            set funcs {  1  2  5  6  7  8  9 11 12 16 17 19 20 23 25 26 27 29 32 37 38 39 41 }
+            set vals  { 32 31 30 29 28 27 26 25 24 23 22 21 20 19 18 17 16 15 14 13 12 11 10 }
+
+            foreach type $types func $funcs val $vals {
+               ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (function = $func)"
+               ogrlayer stats $features -buffer [expr $Param(Deg2M)*6] 8 ;# 6m x 2 : effectue un buffer autour du point, d'un rayon de 6 mtres.  Le point occupera donc au minimum 3 pixels X 3 pixels
+               Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity ($type) as FEATURES with priority value $val"
+               UrbanX::SandwichRasterize $Band $features $Seq [incr op] $val
             }
-            BS_2060009_0 {
-               #entity : Chimney, points
-               Log::Print DEBUG "Post-processing for Chimneys, points"
-               set types { "Chimneys - burners" "Chimneys - industrial" "Chimneys - flare stack" }
-               set funcs { 1 2 3 }
-               set vals  { 5 4 3 }
-
-               foreach type $types func $funcs val $vals {
-                  ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (type = $func)"
-                  Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity ($type) as FEATURES with priority value $val"
-                  gdalband gridinterp RSANDWICH FEATURES $Param(Mode) $val
-               }
 
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE type NOT IN ([join $funcs ,])"
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (general) as FEATURES with priority value 6"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 6
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE function NOT IN ([join $funcs ,])"
+            ogrlayer stats $features -buffer [expr $Param(Deg2M)*6] 8 ;# 6m x 2 : effectue un buffer autour du point, d'un rayon de 6 mtres.  Le point occupera donc au minimum 3 pixels X 3 pixels
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (general) as FEATURES with priority value 33"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] 33
+         }
+         BS_2010009_2 {
+            Log::Print DEBUG "Post-processing for buildings, areas"
+            set types { "arena" "armoury" "city hall" "coast guard station" "community center" "courthouse" "custom post" "electric power station" "fire station" "highway service center" \
+                        "hospital" "medical center" "municipal hall" "gas and oil facilities building" "parliament building" "police station" "railway station" "satellite-tracking station" \
+                        "sportsplex" "industrial building" "religious building" "penal building" "educational building" }
+            set funcs {   1   2   5   6  7  8  9 11 12 16 17 19 20 23 25 26 27 29 32 37 38 39 41 }
+            set vals  { 103 102 101 100 99 98 97 96 95 94 93 92 91 90 89 88 87 86 85 84 83 82 81 }
+
+            foreach type $types func $funcs val $vals {
+               ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE FUNCTION = $func"
+               Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity ($type) as FEATURES with priority value $val"
+               UrbanX::SandwichRasterize $Band $features $Seq [incr op] $val
             }
-            BS_2240009_1 {
-               # Entity: Wall/fence, line
-               Log::Print DEBUG "Post-processing for Wall / fences, lines"
-               set types { "Wall / fence - fences" "Wall / fence - fences" }
-               set funcs {   1   2 }
-               set vals  { 114 113 }
-
-               foreach type $types func $funcs val $vals {
-                  ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (type = $func)"
-                  Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity ($type) as FEATURES with priority value $val"
-                  gdalband gridinterp RSANDWICH FEATURES $Param(Mode) $val
-               }
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE function NOT IN ([join $funcs ,])"
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (general) as FEATURES with priority value 104"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] 104
+         }
+         BS_2060009_0 {
+            #entity : Chimney, points
+            Log::Print DEBUG "Post-processing for Chimneys, points"
+            set types { "Chimneys - burners" "Chimneys - industrial" "Chimneys - flare stack" }
+            set funcs { 1 2 3 }
+            set vals  { 5 4 3 }
+
+            foreach type $types func $funcs val $vals {
+               ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (type = $func)"
+               Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity ($type) as FEATURES with priority value $val"
+               UrbanX::SandwichRasterize $Band $features $Seq [incr op] $val
             }
-            BS_2310009_1 {
-               # Entity: Pipeline (Sewage / liquid waste), line
-               Log::Print DEBUG "Post-processing for Pipelines (sewage / liquid waste), lines"
-               #if relation2ground != 1 (aboveground), exclus; else, valeur gnrale
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (type = 1)"
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (aboveground sewage pipeline entity) as FEATURES with priority value $priority"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) $priority
+
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE type NOT IN ([join $funcs ,])"
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (general) as FEATURES with priority value 6"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] 6
+         }
+         BS_2240009_1 {
+            # Entity: Wall/fence, line
+            Log::Print DEBUG "Post-processing for Wall / fences, lines"
+            set types { "Wall / fence - fences" "Wall / fence - fences" }
+            set funcs {   1   2 }
+            set vals  { 114 113 }
+
+            foreach type $types func $funcs val $vals {
+               ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (type = $func)"
+               Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity ($type) as FEATURES with priority value $val"
+               UrbanX::SandwichRasterize $Band $features $Seq [incr op] $val
             }
-            EN_1180009_1 {
-               # Entity: Pipeline, line
-               Log::Print DEBUG "Post-processing for Pipelines, lines"
-               #if relation2ground != 1 (aboveground), exclus; else, valeur gnrale
+         }
+         BS_2310009_1 {
+            # Entity: Pipeline (Sewage / liquid waste), line
+            Log::Print DEBUG "Post-processing for Pipelines (sewage / liquid waste), lines"
+            #if relation2ground != 1 (aboveground), exclus; else, valeur gnrale
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (type = 1)"
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (aboveground sewage pipeline entity) as FEATURES with priority value $priority"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] $priority
+         }
+         EN_1180009_1 {
+            # Entity: Pipeline, line
+            Log::Print DEBUG "Post-processing for Pipelines, lines"
+            #if relation2ground != 1 (aboveground), exclus; else, valeur gnrale
 	       # attribute name is relground, not type
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (relground = 1)"
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (aboveground pipeline entity) as FEATURES with priority value $priority"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) $priority
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (relground = 1)"
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (aboveground pipeline entity) as FEATURES with priority value $priority"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] $priority
+         }
+         HD_1450009_0 {
+            # Entity: Manmade hydrographic entity [Geobase], point
+            Log::Print DEBUG "Post-processing for Manmade hydrographic entities, points"
+            set types { "dam" "dock" "wharf" "breakwater" "dike/levee" "lock gate" "boat ramp" "fish ladder" "slip" "breakwater in the ocean" }
+            set funcs {  1  2  3  4  5  6  7  8  9  104 }
+            set vals  { 43 42 41 44 45 37 40 38 39   46 }
+
+            foreach type $types func $funcs val $vals {
+               ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (type = $func)"
+               Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity ($type) as FEATURES with priority value $val"
+               UrbanX::SandwichRasterize $Band $features $Seq [incr op] $val
             }
-            HD_1450009_0 {
-               # Entity: Manmade hydrographic entity [Geobase], point
-               Log::Print DEBUG "Post-processing for Manmade hydrographic entities, points"
-               set types { "dam" "dock" "wharf" "breakwater" "dike/levee" "lock gate" "boat ramp" "fish ladder" "slip" "breakwater in the ocean" }
-               set funcs {  1  2  3  4  5  6  7  8  9  104 }
-               set vals  { 43 42 41 44 45 37 40 38 39   46 }
-
-               foreach type $types func $funcs val $vals {
-                  ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (type = $func)"
-                  Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity ($type) as FEATURES with priority value $val"
-                  gdalband gridinterp RSANDWICH FEATURES $Param(Mode) $val
-               }
 
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE type NOT IN ([join $funcs ,])"
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (general) as FEATURES with priority value 47"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 47
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE type NOT IN ([join $funcs ,])"
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (general) as FEATURES with priority value 47"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] 47
+         }
+         HD_1450009_1 {
+            # Entity: Manmade hydrographic entity [Geobase], line
+            Log::Print DEBUG "Post-processing for Manmade hydrographic entities, lines"
+            set types { "dam" "dock" "wharf" "breakwater" "dike/levee" "lock gate" "boat ramp" "fish ladder" "slip" "breakwater in the ocean" }
+            set funcs {   1   2   3   4   5   6   7   8   9 104 }
+            set vals  { 124 123 122 125 126 118 121 119 120 127 }
+
+            foreach type $types func $funcs val $vals {
+               ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (type = $func)"
+               Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity ($type) as FEATURES with priority value $val"
+               UrbanX::SandwichRasterize $Band $features $Seq [incr op] $val
             }
-            HD_1450009_1 {
-               # Entity: Manmade hydrographic entity [Geobase], line
-               Log::Print DEBUG "Post-processing for Manmade hydrographic entities, lines"
-               set types { "dam" "dock" "wharf" "breakwater" "dike/levee" "lock gate" "boat ramp" "fish ladder" "slip" "breakwater in the ocean" }
-               set funcs {   1   2   3   4   5   6   7   8   9 104 }
-               set vals  { 124 123 122 125 126 118 121 119 120 127 }
-
-               foreach type $types func $funcs val $vals {
-                  ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (type = $func)"
-                  Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity ($type) as FEATURES with priority value $val"
-                  gdalband gridinterp RSANDWICH FEATURES $Param(Mode) $val
-               }
 
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE type NOT IN ([join $funcs ,])"
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (general) as FEATURES with priority value 128"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 128
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE type NOT IN ([join $funcs ,])"
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (general) as FEATURES with priority value 128"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] 128
+         }
+         HD_1450009_2 {
+            # Entity: Manmade hydrographic entity [Geobase], area
+            Log::Print DEBUG "Post-processing for Manmade hydrographic entities, area"
+            set types { "dam" "dock" "wharf" "breakwater" "dike/levee" "lock gate" "boat ramp" "fish ladder" "slip" "breakwater in the ocean" }
+            set funcs {   1   2   3   4   5   6   7   8   9 104 }
+            set vals  { 154 153 152 155 156 148 151 149 150 157 }
+
+            foreach type $types func $funcs val $vals {
+               ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (type = $func)"
+               Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity ($type) as FEATURES with priority value $val"
+               UrbanX::SandwichRasterize $Band $features $Seq [incr op] $val
             }
-            HD_1450009_2 {
-               # Entity: Manmade hydrographic entity [Geobase], area
-               Log::Print DEBUG "Post-processing for Manmade hydrographic entities, area"
-               set types { "dam" "dock" "wharf" "breakwater" "dike/levee" "lock gate" "boat ramp" "fish ladder" "slip" "breakwater in the ocean" }
-               set funcs {   1   2   3   4   5   6   7   8   9 104 }
-               set vals  { 154 153 152 155 156 148 151 149 150 157 }
-
-               foreach type $types func $funcs val $vals {
-                  ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (type = $func)"
-                  Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity ($type) as FEATURES with priority value $val"
-                  gdalband gridinterp RSANDWICH FEATURES $Param(Mode) $val
-               }
 
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE type NOT IN ([join $funcs ,])"
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (general) as FEATURES with priority value 128"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 158
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE type NOT IN ([join $funcs ,])"
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (general) as FEATURES with priority value 128"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] 158
+         }
+         HD_1460009_0 {
+            # entity: Hydrographic obstacle entity [Geobase], point
+            Log::Print DEBUG "Post-processing for Hydrographic obstacle entities, points"
+            set types { "fall" "rapids" "reef" "rocks" "disappearing stream" "exposed shipwreck" "ford" "reef in the ocean" "rocks in the ocean" "exposed shipwreck in the ocean" }
+            set funcs {  1  2  3  4  5  6  7 103 104 106 }
+            set vals  { 56 57 53 52 48 50 49  55  54  51 }
+
+            foreach type $types func $funcs val $vals {
+               ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (type = $func)"
+               Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity ($type) as FEATURES with priority value $val"
+               UrbanX::SandwichRasterize $Band $features $Seq [incr op] $val
             }
-            HD_1460009_0 {
-               # entity: Hydrographic obstacle entity [Geobase], point
-               Log::Print DEBUG "Post-processing for Hydrographic obstacle entities, points"
-               set types { "fall" "rapids" "reef" "rocks" "disappearing stream" "exposed shipwreck" "ford" "reef in the ocean" "rocks in the ocean" "exposed shipwreck in the ocean" }
-               set funcs {  1  2  3  4  5  6  7 103 104 106 }
-               set vals  { 56 57 53 52 48 50 49  55  54  51 }
-
-               foreach type $types func $funcs val $vals {
-                  ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (type = $func)"
-                  Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity ($type) as FEATURES with priority value $val"
-                  gdalband gridinterp RSANDWICH FEATURES $Param(Mode) $val
-               }
 
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE type NOT IN ([join $funcs ,])"
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (general) as FEATURES with priority value 58"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 58
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE type NOT IN ([join $funcs ,])"
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (general) as FEATURES with priority value 58"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] 58
+         }
+         HD_1460009_1 {
+            # entity: Hydrographic obstacle entity [Geobase], line
+            Log::Print DEBUG "Post-processing for Hydrographic obstacle entities, lines"
+            set types { "fall" "rapids" "reef" "rocks" "disappearing stream" "exposed shipwreck" "ford" "reef in the ocean" "rocks in the ocean" "exposed shipwreck in the ocean" }
+            set funcs {   1   2   3   4   5   6   7 103 104 106 }
+            set vals  { 137 138 134 133 129 131 130 136 135 132 }
+
+            foreach type $types func $funcs val $vals {
+               ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (type = $func)"
+               Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity ($type) as FEATURES with priority value $val"
+               UrbanX::SandwichRasterize $Band $features $Seq [incr op] $val
             }
-            HD_1460009_1 {
-               # entity: Hydrographic obstacle entity [Geobase], line
-               Log::Print DEBUG "Post-processing for Hydrographic obstacle entities, lines"
-               set types { "fall" "rapids" "reef" "rocks" "disappearing stream" "exposed shipwreck" "ford" "reef in the ocean" "rocks in the ocean" "exposed shipwreck in the ocean" }
-               set funcs {   1   2   3   4   5   6   7 103 104 106 }
-               set vals  { 137 138 134 133 129 131 130 136 135 132 }
-
-               foreach type $types func $funcs val $vals {
-                  ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (type = $func)"
-                  Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity ($type) as FEATURES with priority value $val"
-                  gdalband gridinterp RSANDWICH FEATURES $Param(Mode) $val
-               }
 
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE type NOT IN ([join $funcs ,])"
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (general) as FEATURES with priority value 58"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 139
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE type NOT IN ([join $funcs ,])"
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (general) as FEATURES with priority value 58"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] 139
+         }
+         HD_1460009_2 {
+            # entity: Hydrographic obstacle entity [Geobase], area
+            Log::Print DEBUG "Post-processing for Hydrographic obstacle entities, areas"
+            set types { "fall" "rapids" "reef" "rocks" "disappearing stream" "exposed shipwreck" "ford" "reef in the ocean" "rocks in the ocean" "exposed shipwreck in the ocean" }
+            set funcs {   1   2   3   4   5   6   7 103 104 106 }
+            set vals  { 167 168 164 163 159 161 160 166 165 162 }
+
+            foreach type $types func $funcs val $vals {
+               ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (type = $func)"
+               Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity ($type) as FEATURES with priority value $val"
+               UrbanX::SandwichRasterize $Band $features $Seq [incr op] $val
             }
-            HD_1460009_2 {
-               # entity: Hydrographic obstacle entity [Geobase], area
-               Log::Print DEBUG "Post-processing for Hydrographic obstacle entities, areas"
-               set types { "fall" "rapids" "reef" "rocks" "disappearing stream" "exposed shipwreck" "ford" "reef in the ocean" "rocks in the ocean" "exposed shipwreck in the ocean" }
-               set funcs {   1   2   3   4   5   6   7 103 104 106 }
-               set vals  { 167 168 164 163 159 161 160 166 165 162 }
-
-               foreach type $types func $funcs val $vals {
-                  ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (type = $func)"
-                  Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity ($type) as FEATURES with priority value $val"
-                  gdalband gridinterp RSANDWICH FEATURES $Param(Mode) $val
-               }
 
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE type NOT IN ([join $funcs ,])"
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (general) as FEATURES with priority value 169"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 169
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE type NOT IN ([join $funcs ,])"
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (general) as FEATURES with priority value 169"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] 169
+         }
+         HD_1470009_1 {
+            # Entity: Single line watercourse [Geobase], line
+            Log::Print DEBUG "Post-processing for Single line watercourse, line"
+            set types { "canal" "conduit" "ditch" "watercourse" "tidal river" }
+            set funcs {   1   2   3   6   7 }
+            set vals  { 142 141 140 144 143 }
+
+            foreach type $types func $funcs val $vals {
+               ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (definition = $func)"
+               Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity ($type) as FEATURES with priority value $val"
+               UrbanX::SandwichRasterize $Band $features $Seq [incr op] $val
             }
-            HD_1470009_1 {
-               # Entity: Single line watercourse [Geobase], line
-               Log::Print DEBUG "Post-processing for Single line watercourse, line"
-               set types { "canal" "conduit" "ditch" "watercourse" "tidal river" }
-               set funcs {   1   2   3   6   7 }
-               set vals  { 142 141 140 144 143 }
-
-               foreach type $types func $funcs val $vals {
-                  ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (definition = $func)"
-                  Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity ($type) as FEATURES with priority value $val"
-                  gdalband gridinterp RSANDWICH FEATURES $Param(Mode) $val
-               }
 
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE definition NOT IN ([join $funcs ,])"
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (general) as FEATURES with priority value 145"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 145
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE definition NOT IN ([join $funcs ,])"
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (general) as FEATURES with priority value 145"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] 145
+         }
+         HD_1480009_2 {
+           # Entity: Waterbody [Geobase], polygon
+            Log::Print DEBUG "Post-processing for Waterbody, polygon"
+            set types { "canal" "ditch" "lake" "reservoir" "watercourse" "tidal river" "liquid waste" "pond" "side channel" "ocean" }
+            set funcs {   1   3   4   5   6   7   8   9  10 100 }
+            set vals  { 172 171 178 179 175 173 176 177 173 180 }
+
+            foreach type $types func $funcs val $vals {
+               ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (definition = $func)"
+               Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity ($type) as FEATURES with priority value $val"
+               UrbanX::SandwichRasterize $Band $features $Seq [incr op] $val
             }
-            HD_1480009_2 {
-              # Entity: Waterbody [Geobase], polygon
-               Log::Print DEBUG "Post-processing for Waterbody, polygon"
-               set types { "canal" "ditch" "lake" "reservoir" "watercourse" "tidal river" "liquid waste" "pond" "side channel" "ocean" }
-               set funcs {   1   3   4   5   6   7   8   9  10 100 }
-               set vals  { 172 171 178 179 175 173 176 177 173 180 }
-
-               foreach type $types func $funcs val $vals {
-                  ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (definition = $func)"
-                  Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity ($type) as FEATURES with priority value $val"
-                  gdalband gridinterp RSANDWICH FEATURES $Param(Mode) $val
-               }
 
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE definition NOT IN ([join $funcs ,])"
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (general) as FEATURES with priority value 181"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 181
-            }
-            IC_2600009_0 {
-               # Entity: Mining area, point
-               Log::Print DEBUG "Post-processing for Mining area, point"
-               # status = 1 : mines oprationnelles
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (status = 1)"
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (operational mines) as FEATURES with priority value 65"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 65
-               # status != 1 : mines non oprationnelles
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (status != 1)"
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (non operational mines) as FEATURES with priority value 66"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 66
-            }
-            TR_1020009_1 {
-               # Entity: Railway, line
-               Log::Print DEBUG "Post-processing for Railway, line"
-               # support = 3: bridge
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (support = 3)"
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (bridge railway) as FEATURES with priority value 2"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 2
-               # support != 3 ou 4: not bridge, not tunnel
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE support NOT IN (3,4)"
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (bridge railway) as FEATURES with priority value 111"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 111
-            }
-            TR_1190009_0 {
-               # Entity: Runway, point
-               Log::Print DEBUG "Post-processing for Runway, point"
-               #type = 1 : airport
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (type = 1 )"
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (airport runway) as FEATURES with priority value 62"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 62
-               # type = 2 ou 3: heliport, hospital heliport
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE type IN (2,3)"
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (heliport or hospital heliport runway) as FEATURES with priority value 7"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 7
-               # type = 4: water aerodrome
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (type = 4 )"
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (water aerodrome runway) as FEATURES with priority value 61"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 61
-            }
-            TR_1190009_2 {
-               # Entity: Runway, area
-               Log::Print DEBUG "Post-processing for Runway, areas"
-               # type = 1: airport
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (type = 1 )"
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (airport runway) as FEATURES with priority value 201"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 201
-               # type = 2 ou 3: heliport, hospital heliport
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE type IN (2,3)"
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (heliport or hospital heliport runway) as FEATURES with priority value 80"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 80
-               # type = 4 : water aerodrome
-               ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (type = 4 )"
-               Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (water aerodrome runway) as FEATURES with priority value 147"
-               gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 147
-            }
-            TR_1760009_1 {
-               if { $indexCouverture=="MONTREAL" || $indexCouverture=="QUEBEC" || $indexCouverture=="QC"} {
-                  Log::Print DEBUG "Ignoring the TR_1760009_1 layer for $indexCouverture to avoid duplicated roads with QC_TR_1760009_1"
-               } else {
-                  # Entity: Road segment [Geobase], line
-                  Log::Print DEBUG "Post-processing for Road segment, lines"
-
-                  # exclusions des structype 5 (tunnel) et 6 (snowshed), association de la valeur gnrale  tout le reste des routes paves
-                  ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (pavstatus != 2) AND structype NOT IN (5,6)"
-                  ogrlayer stats FEATURES -buffer [expr $Param(Deg2M)*6] 8 ;# 6m x 2
-                  Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (general road segments) as FEATURES with priority value 109"
-                  Log::Print INFO "Buffering general road segments to 12m"
-                  gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 109
-
-                  # pavstatus = 2: unpaved: routes non paves n'tant pas des tunnels ou des snowsheds
-                  ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (pavstatus = 2) AND structype NOT IN (5,6)"
-                  Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (unpaved road segments) as FEATURES with priority value 110"
-                  # pas de buffer sur les routes non paves
-                  gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 110
-
-                  # roadclass in (1,2): freeway, expressway/highway n'tant pas des tunnels ou des snowsheds
-                  ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE roadclass in (1,2) AND structype NOT IN (5,6)"
-                  ogrlayer stats FEATURES -buffer [expr $Param(Deg2M)*11] 8 ;# 11m x 2
-                  Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (highways road segments) as FEATURES with priority value 108"
-                  Log::Print INFO "Buffering highway road segments to 22m"
-                  gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 108
-
-                  # structype in (1,2,3,4) : bridge (tous les types de ponts)
-                  ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE structype IN (1,2,3,4)"
-                  ogrlayer stats FEATURES -buffer [expr $Param(Deg2M)*11] 8 ;# 11m x 2
-                  Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (bridge road segments) as FEATURES with priority value 1"
-                  Log::Print INFO "Buffering bridge road segments to 22m"
-                  gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 1
-               }
-            }
-            QC_TR_1760009_1 {
-               # This has been added to support CanVec-R7's new QC_TR layers, it may need revision for R8 (May 2011) or R9
-               if { $indexCouverture=="OTTAWA"} {
-                  Log::Print DEBUG "Ignoring the QC_TR_1760009_1 layer for Ottawa to avoid duplicated roads with TR_1760009_1"
-               } else {
-                  # Thus for MONTREAL, QUEBEC and QC (IndustrX)
-                  Log::Print DEBUG "Rasterizing QC_TR_1760009_1 for $indexCouverture"
-                  # entity : Road segment [Geobase], line
-                  Log::Print DEBUG "Post-processing for Road segment, lines"
-
-                  # exclusions des structype 5 (tunnel) et 6 (snowshed), association de la valeur gnrale  tout le reste des routes paves
-                  ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (pavstatus != 2) AND structype NOT IN (5,6)"
-                  ogrlayer stats FEATURES -buffer [expr $Param(Deg2M)*6] 8 ;# 6m x 2
-                  Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (general road segments) as FEATURES with priority value 109"
-                  Log::Print INFO "Buffering general road segments to 12m"
-                  gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 109
-
-                  # pavstatus = 2: unpaved : routes non paves n'tant pas des tunnels ou des snowsheds
-                  ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE (pavstatus = 2) AND structype NOT IN (5,6)"
-                  Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (unpaved road segments) as FEATURES with priority value 110"
-                  # pas de buffer sur les routes non paves
-                  gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 110
-
-                  # roadclass in (1,2): freeway, expressway/highway n'tant pas des tunnels ou des snowsheds
-                  ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE roadclass in (1,2) AND structype NOT IN (5,6)"
-                  ogrlayer stats FEATURES -buffer [expr $Param(Deg2M)*11] 8 ;# 11m x 2
-                  Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (highways road segments) as FEATURES with priority value 108"
-                  Log::Print INFO "Buffering highway road segments to 22m"
-                  gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 108
-
-                  # structype in (1,2,3,4) : bridge (tous les types de ponts)
-                  ogrlayer sqlselect FEATURES SHAPE "SELECT * FROM \"$filename\" WHERE structype IN (1,2,3,4)"
-                  ogrlayer stats FEATURES -buffer [expr $Param(Deg2M)*11] 8 ;# 11m x 2
-                  Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from layer $entity (bridge road segments) as FEATURES with priority value 1"
-                  Log::Print INFO "Buffering bridge road segments to 22m"
-                  gdalband gridinterp RSANDWICH FEATURES $Param(Mode) 1
-               }
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE definition NOT IN ([join $funcs ,])"
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (general) as FEATURES with priority value 181"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] 181
+         }
+         IC_2600009_0 {
+            # Entity: Mining area, point
+            Log::Print DEBUG "Post-processing for Mining area, point"
+            # status = 1 : mines oprationnelles
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (status = 1)"
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (operational mines) as FEATURES with priority value 65"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] 65
+            # status != 1 : mines non oprationnelles
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (status != 1)"
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (non operational mines) as FEATURES with priority value 66"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] 66
+         }
+         TR_1020009_1 {
+            # Entity: Railway, line
+            Log::Print DEBUG "Post-processing for Railway, line"
+            # support = 3: bridge
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (support = 3)"
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (bridge railway) as FEATURES with priority value 2"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] 2
+            # support != 3 ou 4: not bridge, not tunnel
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE support NOT IN (3,4)"
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (bridge railway) as FEATURES with priority value 111"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] 111
+         }
+         TR_1190009_0 {
+            # Entity: Runway, point
+            Log::Print DEBUG "Post-processing for Runway, point"
+            #type = 1 : airport
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (type = 1 )"
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (airport runway) as FEATURES with priority value 62"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] 62
+            # type = 2 ou 3: heliport, hospital heliport
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE type IN (2,3)"
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (heliport or hospital heliport runway) as FEATURES with priority value 7"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] 7
+            # type = 4: water aerodrome
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (type = 4 )"
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (water aerodrome runway) as FEATURES with priority value 61"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] 61
+         }
+         TR_1190009_2 {
+            # Entity: Runway, area
+            Log::Print DEBUG "Post-processing for Runway, areas"
+            # type = 1: airport
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (type = 1 )"
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (airport runway) as FEATURES with priority value 201"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] 201
+            # type = 2 ou 3: heliport, hospital heliport
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE type IN (2,3)"
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (heliport or hospital heliport runway) as FEATURES with priority value 80"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] 80
+            # type = 4 : water aerodrome
+            ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (type = 4 )"
+            Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (water aerodrome runway) as FEATURES with priority value 147"
+            UrbanX::SandwichRasterize $Band $features $Seq [incr op] 147
+         }
+         TR_1760009_1 {
+            if { $Coverage=="MONTREAL" || $Coverage=="QUEBEC" || $Coverage=="QC"} {
+               Log::Print DEBUG "Ignoring the TR_1760009_1 layer for $Coverage to avoid duplicated roads with QC_TR_1760009_1"
+            } else {
+               # Entity: Road segment [Geobase], line
+               Log::Print DEBUG "Post-processing for Road segment, lines"
+
+               # exclusions des structype 5 (tunnel) et 6 (snowshed), association de la valeur gnrale  tout le reste des routes paves
+               ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (pavstatus != 2) AND structype NOT IN (5,6)"
+               ogrlayer stats $features -buffer [expr $Param(Deg2M)*6] 8 ;# 6m x 2
+               Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (general road segments) as FEATURES with priority value 109"
+               Log::Print INFO "Buffering general road segments to 12m"
+               UrbanX::SandwichRasterize $Band $features $Seq [incr op] 109
+
+               # pavstatus = 2: unpaved: routes non paves n'tant pas des tunnels ou des snowsheds
+               ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (pavstatus = 2) AND structype NOT IN (5,6)"
+               Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (unpaved road segments) as FEATURES with priority value 110"
+               # pas de buffer sur les routes non paves
+               UrbanX::SandwichRasterize $Band $features $Seq [incr op] 110
+
+               # roadclass in (1,2): freeway, expressway/highway n'tant pas des tunnels ou des snowsheds
+               ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE roadclass in (1,2) AND structype NOT IN (5,6)"
+               ogrlayer stats $features -buffer [expr $Param(Deg2M)*11] 8 ;# 11m x 2
+               Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (highways road segments) as FEATURES with priority value 108"
+               Log::Print INFO "Buffering highway road segments to 22m"
+               UrbanX::SandwichRasterize $Band $features $Seq [incr op] 108
+
+               # structype in (1,2,3,4) : bridge (tous les types de ponts)
+               ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE structype IN (1,2,3,4)"
+               ogrlayer stats $features -buffer [expr $Param(Deg2M)*11] 8 ;# 11m x 2
+               Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (bridge road segments) as FEATURES with priority value 1"
+               Log::Print INFO "Buffering bridge road segments to 22m"
+               UrbanX::SandwichRasterize $Band $features $Seq [incr op] 1
             }
-            default {
-               # The layer is part of Param(LayersPostPro) but no case has been defined for it
-               Log::Print WARNING "Post-processing for $file not found. The layer has not been rasterized"
+         }
+         QC_TR_1760009_1 {
+            # This has been added to support CanVec-R7's new QC_TR layers, it may need revision for R8 (May 2011) or R9
+            if { $Coverage=="OTTAWA"} {
+               Log::Print DEBUG "Ignoring the QC_TR_1760009_1 layer for Ottawa to avoid duplicated roads with TR_1760009_1"
+            } else {
+               # Thus for MONTREAL, QUEBEC and QC (IndustrX)
+               Log::Print DEBUG "Rasterizing QC_TR_1760009_1 for $Coverage"
+               # entity : Road segment [Geobase], line
+               Log::Print DEBUG "Post-processing for Road segment, lines"
+
+               # exclusions des structype 5 (tunnel) et 6 (snowshed), association de la valeur gnrale  tout le reste des routes paves
+               ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (pavstatus != 2) AND structype NOT IN (5,6)"
+               ogrlayer stats $features -buffer [expr $Param(Deg2M)*6] 8 ;# 6m x 2
+               Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (general road segments) as FEATURES with priority value 109"
+               Log::Print INFO "Buffering general road segments to 12m"
+               UrbanX::SandwichRasterize $Band $features $Seq [incr op] 109
+
+               # pavstatus = 2: unpaved : routes non paves n'tant pas des tunnels ou des snowsheds
+               ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE (pavstatus = 2) AND structype NOT IN (5,6)"
+               Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (unpaved road segments) as FEATURES with priority value 110"
+               # pas de buffer sur les routes non paves
+               UrbanX::SandwichRasterize $Band $features $Seq [incr op] 110
+
+               # roadclass in (1,2): freeway, expressway/highway n'tant pas des tunnels ou des snowsheds
+               ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE roadclass in (1,2) AND structype NOT IN (5,6)"
+               ogrlayer stats $features -buffer [expr $Param(Deg2M)*11] 8 ;# 11m x 2
+               Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (highways road segments) as FEATURES with priority value 108"
+               Log::Print INFO "Buffering highway road segments to 22m"
+               UrbanX::SandwichRasterize $Band $features $Seq [incr op] 108
+
+               # structype in (1,2,3,4) : bridge (tous les types de ponts)
+               ogrlayer sqlselect $features $shape "SELECT * FROM \"$filename\" WHERE structype IN (1,2,3,4)"
+               ogrlayer stats $features -buffer [expr $Param(Deg2M)*11] 8 ;# 11m x 2
+               Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from layer $entity (bridge road segments) as FEATURES with priority value 1"
+               Log::Print INFO "Buffering bridge road segments to 22m"
+               UrbanX::SandwichRasterize $Band $features $Seq [incr op] 1
             }
          }
-      } else {
-
-         # Generic rasterization: entities that are not part of Param(LayersPostPro)
-         eval ogrlayer read FEATURES SHAPE 0
-         Log::Print DEBUG "Rasterizing [ogrlayer define FEATURES -nb] features from file $file as FEATURES with priority value $priority, general procedure"
-         gdalband gridinterp RSANDWICH FEATURES $Param(Mode) $priority
+         default {
+            # The layer is part of Param(LayersPostPro) but no case has been defined for it
+            Log::Print WARNING "Post-processing for $File not found. The layer has not been rasterized"
+         }
       }
+   } else {
 
-      ogrlayer free FEATURES
-      ogrfile close SHAPE
+      # Generic rasterization: entities that are not part of Param(LayersPostPro)
+      eval ogrlayer read $features $shape 0
+      Log::Print DEBUG "Rasterizing [ogrlayer define $features -nb] features from file $File as FEATURES with priority value $priority, general procedure"
+      UrbanX::SandwichRasterize $Band $features $Seq [incr op] $priority
    }
 
-   file delete -force $GenX::Param(TMPDIR)/$Param(NTSSheet)_sandwich.tif
-   gdalfile open FILEOUT write $GenX::Param(TMPDIR)/$Param(NTSSheet)_sandwich.tif GeoTiff
-   gdalband write RSANDWICH FILEOUT
-   gdalfile close FILEOUT
-   Log::Print INFO "The file $GenX::Param(TMPDIR)/$Param(NTSSheet)_sandwich.tif has been generated"
+   ogrlayer free $features
+   ogrfile close $shape
 
-   gdalband free RSANDWICH
+   return $Param(SandwichRanks)
 }
 
 #----------------------------------------------------------------------------
@@ -1659,45 +1884,50 @@ proc UrbanX::Process_BLDH { tid Grid nomvar } {
    if { $nomvar != "BLDH" } {
       return
    }
+
+   # Objects names need to be thread safe since sheets are processed concurrently
+   set rbld   RHAUTEURBLD$tid
+   set fbld   FHAUTEURBLD$tid
+
    if { $Param(BuildingsHgtShpDir) !="" } {
       Log::Print INFO "Looking for Buildings Height Shapefiles in: $Param(BuildingsHgtShpDir)"
-      set shpfiles  [GetBldHgtShpfile RCULUC $Param(BuildingsHgtShpDir)]
-      BuildingHeights2Raster  $shpfiles
+      set shpfiles  [GetBldHgtShpfile $Param(RCULUC) $Param(BuildingsHgtShpDir)]
+      BuildingHeights2Raster  $shpfiles $tid
    } elseif { $Param(BuildingsShapefile) != "" } {
-      BuildingHeights2Raster  $Param(BuildingsShapefile)
+      BuildingHeights2Raster  $Param(BuildingsShapefile) $tid
    }
 
-   if { ! [gdalband is RHAUTEURBLD] } {
+   if { ! [gdalband is $rbld] } {
       set bld_height_file "$Param(BLDH_PATH)/$Param(NTSSheet)_Building-heights.tif"
       if { [file exist $bld_height_file] } {
-         gdalfile close FHAUTEURBLD
-         gdalband read RHAUTEURBLD0 [gdalfile open FHAUTEURBLD read $bld_height_file]
-         vexpr RHAUTEURBLD "ifelse(RHAUTEURBLD0<0,0,RHAUTEURBLD0)"
+         gdalfile close $fbld
+         gdalband read ${rbld}0 [gdalfile open $fbld read $bld_height_file]
+         vexpr $rbld "ifelse(${rbld}0<0,0,${rbld}0)"
       }
    }
-   if { [gdalband is RHAUTEURBLD] } {
+   if { [gdalband is $rbld] } {
       Log::Print INFO "Adjusting BLDH with Buildings Height Raster"
-      gdalband stats RHAUTEURBLD -nodata 0;# memory fault if this comes after the gdalband write
-      vexpr RHAUTEURBLD "ifelse(RHAUTEURBLD>0 && RHAUTEURBLD < 4.5,4.5,RHAUTEURBLD)"
+      gdalband stats $rbld -nodata 0;# memory fault if this comes after the gdalband write
+      vexpr $rbld "ifelse($rbld>0 && $rbld < 4.5,4.5,$rbld)"
 
-      fstdfield fromband $Grid.B3DH RHAUTEURBLD IJCULUC AVERAGE
-      gdalband free RHAUTEURBLD
+      fstdfield fromband $Grid.B3DH $rbld $Param(IJCULUC) AVERAGE
+      gdalband free $rbld
    } else {
       Log::Print WARNING "Buildings Height Raster not found for $Param(NTSSheet)"
    }
    if { $Param(OptionalTEBParams) } {
       #----- Building height min computation
       Log::Print INFO "Computing Building Height Minimum HMIN (IP1=0) values over $Param(NTSSheet)"
-      fstdfield fromband $Grid.HMIN RHAUTEURBLD IJCULUC MINIMUM
+      fstdfield fromband $Grid.HMIN $rbld $Param(IJCULUC) MINIMUM
 
       #----- Building height max computation
       Log::Print INFO "Computing Building Height Maximum HMAX (IP1=0) values over $Param(NTSSheet)"
-      fstdfield fromband $Grid.HMAX RHAUTEURBLD IJCULUC MAXIMUM
+      fstdfield fromband $Grid.HMAX $rbld $Param(IJCULUC) MAXIMUM
    }
 
    # now we can safely free RHAUTEURBLD and close FHAUTEURBLD
-   gdalband free RHAUTEURBLD RHAUTEURBLD0
-   gdalfile close FHAUTEURBLD
+   gdalband free $rbld ${rbld}0
+   gdalfile close $fbld
 }
 
 proc  UrbanX::Process_TEBParam { tid Grid tebparam nomvar params values } {
@@ -1710,36 +1940,47 @@ proc  UrbanX::Process_TEBParam { tid Grid tebparam nomvar params values } {
    }
 
    Log::Print DEBUG "Thread $tid Process_TEBParam $tebparam for $UrbanX::Param(NTSSheet)"
-
-   if { $nomvar == "BLDH" } {
-      UrbanX::Process_BLDH $tid $Grid $nomvar
-   } else { 
-      Log::Print DEBUG "Copying the $tebparam values to the 5m raster with LUT over $UrbanX::Param(NTSSheet)"
-      # Name of RTEBPARAM need to be thread safe
-      set  RTEBPARAM  "RTEBPARAM.$tebparam"
-      vexpr (Float32)$RTEBPARAM lut(RCULUC,CSVTEBPARAMS.CULUC_Class,CSVTEBPARAMS.$tebparam)
-      gdalband stats $RTEBPARAM -nodata -9999 ;# memory fault if this comes after the gdalband write
-      fstdfield fromband $Grid.$tebparam $RTEBPARAM IJCULUC AVERAGE
-      gdalband free $RTEBPARAM
+   set start [clock milliseconds]
+
+# errors are returned instead of raised since an asynchronous send would store the message as the result
+   if { [catch {
+      if { $nomvar == "BLDH" } {
+         UrbanX::Process_BLDH $tid $Grid $nomvar
+      } else { 
+         Log::Print DEBUG "Copying the $tebparam values to the 5m raster with LUT over $UrbanX::Param(NTSSheet)"
+         # Name of RTEBPARAM need to be thread safe, a thread may process the same parameter as another one on a different sheet
+         set  RTEBPARAM  "RTEBPARAM$tid"
+         vexpr (Float32)$RTEBPARAM lut($Param(RCULUC),CSVTEBPARAMS.CULUC_Class,CSVTEBPARAMS.$tebparam)
+         gdalband stats $RTEBPARAM -nodata -9999 ;# memory fault if this comes after the gdalband write
+         fstdfield fromband $Grid.$tebparam $RTEBPARAM $Param(IJCULUC) AVERAGE
+         gdalband free $RTEBPARAM
+      }
+   } msg] } {
+      return [list $tid [expr [clock milliseconds]-$start] "$tebparam of $UrbanX::Param(NTSSheet): $msg"]
    }
    Log::Print DEBUG "Thread $tid has completed $tebparam for $UrbanX::Param(NTSSheet)"
-   return $tid
+   return [list $tid [expr [clock milliseconds]-$start] ""]
 }
 
 proc UrbanX::Initialize_Threads {} {
    variable Param
    variable Threads
 
+   #----- Threads are shared by the sandwich and TEB processing, create them only once
+   if { [array size Threads] } {
+      return
+   }
+
    GenX::Procs
-   Log::Print INFO "Initializing $Param(NbThreads) Threads to generate TEB parameters"
+   Log::Print INFO "Initializing $Param(NbThreads) Threads"
 
 # make a copy of only necessary context into thread's interp as needed to run
    set procsdef ""
-   foreach  procname {Process_BLDH Process_TEBParam GetBldHgtShpfile BuildingHeights2Raster} {
+   foreach  procname {Process_BLDH Process_TEBParam GetBldHgtShpfile BuildingHeights2Raster SandwichTask SandwichLayer SandwichRasterize} {
       append  procsdef "proc UrbanX::$procname {[info args $procname]} {\n[info body $procname]\n}\n"
    }
 
-   set  UrbanX_Param {BuildingsHgtShpDir BuildingsShapefile OptionalTEBParams Mode BuildingsHgtField BLDH_PATH SAVE_BLDH_RASTER}
+   set  UrbanX_Param {BuildingsHgtShpDir BuildingsShapefile OptionalTEBParams Mode BuildingsHgtField BLDH_PATH SAVE_BLDH_RASTER LayersPostPro Entities Priorities SandwichOps}
    foreach n  $UrbanX_Param {
       eval "set value  \$Param($n)"
       append  procsdef "set  UrbanX::Param($n) {$value}\n"
@@ -1782,6 +2023,99 @@ proc UrbanX::Initialize_Threads {} {
    }
 }
 
+#----------------------------------------------------------------------------
+# Name     : <UrbanX::TEBTaskDone>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Wait for a TEB task to complete and release its sheet objects
+#            when it was the last task of the sheet
+#
+# Parameters :
+#
+# Return:
+#   <tid>  : Thread which is now idle
+#
+# Remarks :
+#    - Works on the task bookkeeping arrays of the caller (UrbanX::TEB2FSTD)
+#    - Task errors are appended to the caller's errors list, to be raised
+#      once all threads are drained
+#
+#----------------------------------------------------------------------------
+proc UrbanX::TEBTaskDone { } {
+   global available_thread
+   upvar 1 working_threads working_threads sheet_tasks sheet_tasks thread_busy thread_busy thread_tasks thread_tasks errors errors
+
+   vwait available_thread
+   set tid   [lindex $available_thread 0]
+   set sheet $working_threads($tid)
+   unset working_threads($tid)
+
+   incr thread_busy($tid) [lindex $available_thread 1]
+   incr thread_tasks($tid)
+   if { [lindex $available_thread 2]!="" } {
+      Log::Print ERROR "Thread ($tid) failed: [lindex $available_thread 2]"
+      lappend errors [lindex $available_thread 2]
+   } else {
+      Log::Print DEBUG "Thread ($tid) has finish"
+   }
+
+   if { ![incr sheet_tasks($sheet) -1] } {
+      Log::Print DEBUG "All tasks completed for sheet $sheet, releasing it"
+      gdalband free RCULUC$sheet IJCULUC$sheet
+      gdalfile close FCULUC$sheet
+   }
+   return $tid
+}
+
+#----------------------------------------------------------------------------
+# Name     : <UrbanX::TEBReduce>
+# Creation : Octobre 2026 - CMC/CMDS
+#
+# Goal     : Reduce the per thread partial accumulations of a TEB parameter
+#
+# Parameters :
+#   <Field>    : Field receiving the result
+#   <Partials> : Partial accumulation fields (freed)
+#   <Mode>     : Accumulation mode (AVERAGE, MINIMUM or MAXIMUM)
+#
+# Return:
+#
+# Remarks :
+#    - Averages are weighted by the accumulation counts of each partial so the
+#      result is the same as a single accumulation over all sheets
+#    - Cells without any accumulation keep the value of the unaccumulated field
+#
+#----------------------------------------------------------------------------
+proc UrbanX::TEBReduce { Field Partials Mode } {
+
+   fstdfield copy TEBCOUNT $Field
+   fstdfield copy TEBVALUE $Field
+   GenX::GridClear [list TEBCOUNT TEBVALUE] 0.0
+   fstdfield gridinterp $Field - NOP True
+
+   foreach part $Partials {
+      #----- Get the accumulation counts before concluding the partial
+      fstdfield gridinterp $part - ACCUM
+      vexpr TEBACCUM $part
+      fstdfield gridinterp $part - NOP True
+
+      switch $Mode {
+         AVERAGE { vexpr TEBVALUE TEBVALUE+$part*TEBACCUM }
+         MINIMUM { vexpr TEBVALUE ifelse(TEBACCUM>0,ifelse(TEBCOUNT>0,min(TEBVALUE,$part),$part),TEBVALUE) }
+         MAXIMUM { vexpr TEBVALUE ifelse(TEBACCUM>0,ifelse(TEBCOUNT>0,max(TEBVALUE,$part),$part),TEBVALUE) }
+      }
+      vexpr TEBCOUNT TEBCOUNT+TEBACCUM
+      fstdfield free $part TEBACCUM
+   }
+
+   if { $Mode=="AVERAGE" } {
+      vexpr $Field ifelse(TEBCOUNT>0,TEBVALUE/TEBCOUNT,$Field)
+   } else {
+      vexpr $Field ifelse(TEBCOUNT>0,TEBVALUE,$Field)
+   }
+   fstdfield free TEBCOUNT TEBVALUE
+}
+
 #----------------------------------------------------------------------------
 # Name     : <UrbanX::TEB2FSTD>
 # Creation : Circa 2006 - Alexandre Leroux - CMC/CMOE
@@ -1793,6 +2127,8 @@ proc UrbanX::Initialize_Threads {} {
 # Return:
 #
 # Remarks :
+#    - With threads, (sheet,parameter) tasks are pulled by idle threads across
+#      sheets into per thread partial fields reduced once at the end (UrbanX::TEBReduce)
 #
 #----------------------------------------------------------------------------
 proc UrbanX::TEB2FSTD { Grid } {
@@ -1884,17 +2220,51 @@ proc UrbanX::TEB2FSTD { Grid } {
    if { $Param(NbThreads) > 0 } {
       UrbanX::Initialize_Threads
    }
+   set reduced False ;# True when the accumulations were concluded by UrbanX::TEBReduce
 
 # Load all NTS sheets only once or twice by moving it to outside loop
 if { $NeedProcessSheets } {
+
+# fields accumulated by the tasks, each thread gets its own partial copy to accumulate into
+   set part_fields $tebparams_list
+   if { [lsearch $tebparams_list "BLDH"]>=0 } {
+      lappend part_fields B3DH
+   }
+   if { $Param(OptionalTEBParams) } {
+      lappend part_fields HMIN HMAX
+   }
+
+   set idle_threads {}
+   if { $Param(NbThreads) > 0 } {
+      foreach i [lsort -integer [array names Threads]] {
+         set tid $Threads($i)
+         set part_grid($tid)  TEBPART$i
+         set thread_busy($tid)  0
+         set thread_tasks($tid) 0
+         foreach field $part_fields {
+            fstdfield copy TEBPART$i.$field $Grid.$field
+         }
+         lappend idle_threads $tid
+      }
+   }
+   set start_time [clock milliseconds]
+   set nsheet 0
+   set errors {} ;# errors of the thread tasks, no more tasks are dispatched after the first one
+
    foreach sheet $all_sheets {
       set Param(NTSSheet) $sheet
 
+# objects of a sheet stay alive until all of its tasks are done, so they need unique names
+      incr nsheet
+      set fculuc   FCULUC$nsheet
+      set rculuc   RCULUC$nsheet
+      set ijculuc  IJCULUC$nsheet
+
       set  culucfilename [UrbanX::GetULUCFilename $sheet]
       puts "$culucfilename"
       if { [file exists $culucfilename] } {
       Log::Print INFO "Loading $culucfilename"
-      set bands [gdalfile open FCULUC read $culucfilename]
+      set bands [gdalfile open $fculuc read $culucfilename]
 
 # moved to later after confirming it is inside grid
 #      if { [catch { gdalband read RCULUC $bands }] } {
@@ -1906,9 +2276,9 @@ if { $NeedProcessSheets } {
 
 # SAFE some time by copying the RCULUC=35 line as 22 in CSVTEBPARAMS
 #         vexpr RCULUC ifelse(RCULUC==22, 35, RCULUC)
-         set Param(Width)  [gdalfile width  FCULUC]
-         set Param(Height) [gdalfile height FCULUC]
-         set georef [gdalfile georef FCULUC]
+         set Param(Width)  [gdalfile width  $fculuc]
+         set Param(Height) [gdalfile height $fculuc]
+         set georef [gdalfile georef $fculuc]
 #         georef copy UTMREF$Param(NTSSheet) $georef
          set  Param(SheetGeoRef) $georef
       } else {
@@ -1918,36 +2288,35 @@ if { $NeedProcessSheets } {
       Log::Print INFO "Making IJCULUC"
       set culuc_IJ   "$tmpdir/$sheet-IJ.tif"
       if { [file exists $culuc_IJ] } {
-         if { [catch { gdalband read IJCULUC [gdalfile open FCULUCIJ read $culuc_IJ] }] } {
+         if { [catch { gdalband read $ijculuc [gdalfile open FCULUCIJ read $culuc_IJ] }] } {
             Log::Print ERROR "ERROR: Can't read: $culuc_IJ"
             Log::End 1;
          }
          gdalfile close FCULUCIJ
       } else {
          Log::Print INFO "Generating Grid Scanline cache over $Param(NTSSheet)"
-         set georef [gdalfile georef FCULUC]
+         set georef [gdalfile georef $fculuc]
 
          Log::Print INFO "Creating IJCULUC"
-         UrbanX::CreateGridIJTile IJCULUC $bands $georef $Grid
-         set cnt [gdalband stats IJCULUC -grid2grid $Grid]
+         UrbanX::CreateGridIJTile $ijculuc $bands $georef $Grid
+         set cnt [gdalband stats $ijculuc -grid2grid $Grid]
          if { $cnt <= 0 } {
             Log::Print INFO "Tile $Param(NTSSheet) not inside grid"
-            gdalfile close FCULUC
+            gdalband free $ijculuc
+            gdalfile close $fculuc
             continue
          }
       }
 
-      if { [catch { gdalband read RCULUC $bands }] } {
-         gdalfile close FCULUC
+      if { [catch { gdalband read $rculuc $bands }] } {
+         gdalfile close $fculuc
          Log::Print ERROR "ERROR: Can't read: $culucfilename"
          Log::End 1;
       }
       Log::Print INFO "Loaded $culucfilename"
 
-      if { $Param(NbThreads) > 0 } {
-         set Threads_searchid [array startsearch Threads]
-      }
-
+# the sheet holds a reference on itself while its tasks are dispatched
+      set sheet_tasks($nsheet) 1
       set main_tid [thread::id]
       foreach tebparam $tebparams_list {
 
@@ -1958,42 +2327,82 @@ if { $NeedProcessSheets } {
          if { $tebparam == "VF21" } {
             continue
          }
+         if { [llength $errors] } {
+            break
+         }
 
-         set update_params  {NTSSheet Width Height SheetGeoRef} 
-         set update_values  "\"$Param(NTSSheet)\" $Param(Width) $Param(Height) \"$Param(SheetGeoRef)\""
-         set param_args  "$Grid \"$tebparam\" \"$nomvar\""
+         set update_params  {NTSSheet Width Height SheetGeoRef RCULUC IJCULUC}
+         set update_values  "\"$Param(NTSSheet)\" $Param(Width) $Param(Height) \"$Param(SheetGeoRef)\" $rculuc $ijculuc"
 	 # available_thread  must be in global scope
          if { $Param(NbThreads) > 0 } {
-            if { [array anymore Threads $Threads_searchid] } {
-               set tname  [array next Threads $Threads_searchid]
-	       set thread_id    $Threads($tname)
-	       set working_threads($thread_id)  1
-               Log::Print DEBUG "Send task to thread : $thread_id"
-               thread::send -async $thread_id  "UrbanX::Process_TEBParam $thread_id $param_args {$update_params} {$update_values}" available_thread
-            } else {
-               vwait available_thread
-               Log::Print DEBUG "vwait returned available_thread : $available_thread"
-               thread::send -async $available_thread  "UrbanX::Process_TEBParam $available_thread $param_args {$update_params} {$update_values}" available_thread
-	    }
+# tasks of any sheet go to the first idle thread, no waiting at sheet boundaries
+            if { ![llength $idle_threads] } {
+               lappend idle_threads [UrbanX::TEBTaskDone]
+               if { [llength $errors] } {
+                  break
+               }
+            }
+            set thread_id    [lindex $idle_threads 0]
+            set idle_threads [lrange $idle_threads 1 end]
+            set working_threads($thread_id) $nsheet
+            incr sheet_tasks($nsheet)
+            Log::Print DEBUG "Send task $tebparam of sheet $sheet to thread : $thread_id"
+            thread::send -async $thread_id  "UrbanX::Process_TEBParam $thread_id $part_grid($thread_id) \"$tebparam\" \"$nomvar\" {$update_params} {$update_values}" available_thread
 	 } else {
-            eval "UrbanX::Process_TEBParam $main_tid $param_args {$update_params} {$update_values}"
+            set res [eval "UrbanX::Process_TEBParam $main_tid $Grid \"$tebparam\" \"$nomvar\" {$update_params} {$update_values}"]
+            if { [lindex $res 2]!="" } {
+               error "TEB processing failed: [lindex $res 2]"
+            }
          }
       }
 
-# wait for all threads to finish before next sheet
-      if { $Param(NbThreads) > 0 } {
-         set nb_threads [llength [array names working_threads]]
-         Log::Print DEBUG "Current working threads list ($nb_threads): [array names working_threads]"
-         for {set i 0} {$i < $nb_threads} {incr i} {
-            vwait available_thread
-            Log::Print DEBUG "Thread ($available_thread) has finish"
-            array unset working_threads $available_thread
+# sheet objects are freed by the last task completion when using threads
+      if { ![incr sheet_tasks($nsheet) -1] } {
+         gdalband free $rculuc $ijculuc
+         gdalfile close $fculuc
+      }
+      if { [llength $errors] } {
+         break
+      }
+   }
+
+# wait for the remaining tasks, then reduce the partial accumulations once
+   if { $Param(NbThreads) > 0 } {
+      while { [array size working_threads] } {
+         UrbanX::TEBTaskDone
+      }
+
+# errors of the threads are raised in the main interpreter once they are all idle
+      if { [llength $errors] } {
+         foreach tid [array names part_grid] {
+            foreach field $part_fields {
+               fstdfield free $part_grid($tid).$field
+            }
          }
-         Log::Print DEBUG "Still working threads list: [array names working_threads]"
+         error "TEB processing failed: [join $errors {; }]"
       }
 
-      gdalband free RCULUC IJCULUC
-      gdalfile close FCULUC
+      set wall [expr ([clock milliseconds]-$start_time)/1000.0]
+      foreach tid [lsort [array names thread_busy]] {
+         set busy [expr $thread_busy($tid)/1000.0]
+         Log::Print INFO "Thread $tid : $thread_tasks($tid) tasks, busy [format %.1f $busy]s of [format %.1f $wall]s ([format %.1f [expr $wall>0?100.0*$busy/$wall:0.0]]%)"
+      }
+
+      foreach field $part_fields {
+         set parts {}
+         foreach tid [array names part_grid] {
+            lappend parts $part_grid($tid).$field
+         }
+         switch $field {
+            HMIN    { UrbanX::TEBReduce $Grid.$field $parts MINIMUM }
+            HMAX    { UrbanX::TEBReduce $Grid.$field $parts MAXIMUM }
+            default { UrbanX::TEBReduce $Grid.$field $parts AVERAGE }
+         }
+      }
+      foreach tebparam $tebparams_list {
+         set LoadedField($tebparam) True
+      }
+      set reduced True
    }
 
    # Computing the teb fields with all NTS sheets
@@ -2012,9 +2421,11 @@ if { $NeedProcessSheets } {
          vexpr $Grid.$tebparam "ifelse($Grid.$tebparam==0,1,$Grid.$tebparam)"
       }
       if { [string compare $nomvar "BLDH"] == 0 } {
-         fstdfield gridinterp $Grid.B3DH - NOP True ;# to conclude the AVERAGE computations on all NTS sheets
+         if { !$reduced } {
+            fstdfield gridinterp $Grid.B3DH - NOP True ;# to conclude the AVERAGE computations on all NTS sheets
+         }
          fstdfield define $Grid.B3DH -NOMVAR B3DH -IP1 $ip1
-         fstdfield write $Grid.B3DH GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress) ;
+         GenX::FieldWrite $Grid.B3DH GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress) ;
          vexpr $Grid.$tebparam "ifelse($Grid.B3DH > 4.0 && $Grid.BLDF>0.0,$Grid.B3DH,$Grid.$tebparam)"
 #         vexpr $Grid.$tebparam "ifelse($Grid.$tebparam < 8.0 && $Grid.$tebparam>0.0,8.0,$Grid.$tebparam)"
          fstdfield free $Grid.B3DH
@@ -2027,9 +2438,9 @@ if { 0 } {
       # Writing result to gridfile
       fstdfield define $Grid.$tebparam -NOMVAR $nomvar -IP1 $ip1 -ETIKET $Param(RevisionETIKET)
       if { $nomvar == "VF"} {
-         fstdfield write $Grid.$tebparam GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress) ;# Writing VF fields to the OutFile
+         GenX::FieldWrite $Grid.$tebparam GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress) ;# Writing VF fields to the OutFile
       } else {
-         fstdfield write $Grid.$tebparam GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress) ;# Writing TEB-only fields to the AuxFile
+         GenX::FieldWrite $Grid.$tebparam GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress) ;# Writing TEB-only fields to the AuxFile
       }
    }
 }
@@ -2045,10 +2456,12 @@ if { 0 } {
          set   ip1     0
          set   nomvar  $tebparam
 
-         fstdfield gridinterp $Grid.$tebparam - NOP True ;# to conclude the AVERAGE computations on all NTS sheets
+         if { !$reduced } {
+            fstdfield gridinterp $Grid.$tebparam - NOP True ;# to conclude the AVERAGE computations on all NTS sheets
+         }
       # Writing result to gridfile
          fstdfield define $Grid.$tebparam -NOMVAR $nomvar -IP1 $ip1 -ETIKET $Param(RevisionETIKET)
-         fstdfield write $Grid.$tebparam GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress) ;# Writing TEB-only fields to the AuxFile
+         GenX::FieldWrite $Grid.$tebparam GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress) ;# Writing TEB-only fields to the AuxFile
          fstdfield free $Grid.$tebparam
       }
    }
@@ -2066,7 +2479,7 @@ if { 0 } {
          fstdfield copy $Grid.HVAR $Grid
          GenX::GridClear $Grid.HVAR 0.0
 
-         fstdfield read BLDHFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDH"
+         GenX::FieldRead BLDHFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDH"
 
          set tebparam "BLDH"
          foreach sheet $all_sheets {
@@ -2096,7 +2509,7 @@ if { 0 } {
 
          fstdfield gridinterp $Grid.HVAR - NOP True ;# to conclude the AVERAGE_VARIANCE computations on all NTS sheets
          fstdfield define $Grid.HVAR -NOMVAR HVAR -IP1 0 -ETIKET $Param(RevisionETIKET)
-         fstdfield write $Grid.HVAR GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress) ;# Writing TEB-only fields to the AuxFile
+         GenX::FieldWrite $Grid.HVAR GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress) ;# Writing TEB-only fields to the AuxFile
          fstdfield free $Grid.HVAR
          fstdfield free BLDHFIELD
       }
@@ -2105,11 +2518,11 @@ if { 0 } {
    vector free CSVTEBPARAMS
 
 # temporary 3 lines followed is for Fixing NATF problem
-   set fields [fstdfield find GPXAUXFILE -1 "" -1 -1 -1 "" "NATF"]
+   set fields [GenX::FieldFind GPXAUXFILE -1 "" -1 -1 -1 "" "NATF"]
    if { [llength $fields] > 0 } {
-      fstdfield read NATFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "NATF"
+      GenX::FieldRead NATFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "NATF"
       vexpr NATFFIELD  "ifelse(NATFFIELD==0,1,NATFFIELD)"
-      fstdfield write NATFFIELD GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite NATFFIELD GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    }
 
    # Balancing BLDF versus PAVF values and redistribute the other parameters accordingly
@@ -2119,13 +2532,13 @@ if { 0 } {
 #   UrbanX::NormalizeVFvsPAVFBLDF
 #   return
 
-   fstdfield read Z0RDFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "Z0RD"
-   fstdfield read Z0RFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "Z0RF"
-   fstdfield read BLDHFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDH"
-   fstdfield read BLDWFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDW"
-   fstdfield read BLDFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDF"
-   fstdfield read PAVFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "PAVF"
-   fstdfield read NATFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "NATF"
+   GenX::FieldRead Z0RDFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "Z0RD"
+   GenX::FieldRead Z0RFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "Z0RF"
+   GenX::FieldRead BLDHFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDH"
+   GenX::FieldRead BLDWFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDW"
+   GenX::FieldRead BLDFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDF"
+   GenX::FieldRead PAVFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "PAVF"
+   GenX::FieldRead NATFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "NATF"
 
    # WALL-O-HOR formulae provided by Sylvie Leroyer
    # bldw ---> mean width of building (BLDWFIELD)  --> add column 
@@ -2138,7 +2551,7 @@ if { 0 } {
    vexpr WHORFIELD "ifelse(NATFFIELD==1||BLDWFIELD==0,0,BLDHFIELD*2.0*BLDFFIELD/(BLDWFIELD *(1.0-NATFFIELD)))" ;#ifelse required to avoid division by 0
 
    fstdfield define WHORFIELD -NOMVAR WHOR -IP1 0 -ETIKET $Param(RevisionETIKET)
-   fstdfield write WHORFIELD GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite WHORFIELD GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    # Z0_TOWN calculation
    Log::Print INFO "Computing geometric TEB parameter Z0_TOWN Z0TW (IP1=0) values with the MacDonald 1998 Model over target grid"
@@ -2156,7 +2569,7 @@ if { 0 } {
    vexpr $Grid ifelse(BLDFFIELD>0.9,max(Z0RFFIELD,$Grid),$Grid)  ;# we are on a roof surface --> use roof Z0
    vexpr $Grid ifelse(PAVFFIELD>0.9,max(Z0RDFIELD,$Grid),$Grid)  ;# we are on a paved surface --> use paved Z0
    fstdfield define $Grid -NOMVAR Z0TW -IP1 0
-   fstdfield write $Grid GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite $Grid GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    if { $Param(OptionalTEBParams) } {
       # SUMF calculation
@@ -2164,19 +2577,19 @@ if { 0 } {
       GenX::GridClear $Grid 0.0
       vexpr $Grid NATFFIELD+BLDFFIELD+PAVFFIELD
       fstdfield define $Grid -NOMVAR SUMF -IP1 0
-      fstdfield write $Grid GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite $Grid GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    
       # DPBH calculation
       Log::Print INFO "Computing TEB parameter DISPBLDH DPBH (IP1=0) values over target grid"
       vexpr DISPBLDH ifelse(BLDHFIELD==0,0, DISPH/BLDHFIELD)
       fstdfield define DISPBLDH -NOMVAR DPBH -IP1 0
-      fstdfield write DISPBLDH GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite DISPBLDH GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
       # Z0ZH calculation
       Log::Print INFO "Computing TEB parameter Z0ZH Z0H (IP1=0) values over target grid"
       vexpr Z0ZH ifelse(BLDHFIELD==0,0, $Grid/BLDHFIELD)
       fstdfield define Z0ZH  -NOMVAR Z0H -IP1 0
-      fstdfield write Z0ZH GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite Z0ZH GPXAUXFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    }
    fstdfield free BLDHFIELD BLDWFIELD BLDFFIELD NATFFIELD WHORFIELD REZ SURFTILE Z0RDFIELD Z0RFFIELD PAVFFIELD WHOR2FIELD WHOR3FIELD Z0ZH DISPBLDH DISPH
 
@@ -2186,6 +2599,7 @@ if { 0 } {
       foreach i [array names Threads] {
          thread::release $Threads($i)
       }
+      array unset Threads
    }
 
    Log::Print INFO "The file $GenX::Param(OutFile)_aux.fst has been updated with TEB parameters"
@@ -2198,13 +2612,15 @@ if { 0 } {
 # Goal     : Converting buildings shapefiles to raster
 #
 # Parameters :
+#   <shpfiles> : Buildings shapefiles (Param(BuildingsShapefile) if empty)
+#   <Suffix>   : Suffix of objects names (RHAUTEURBLD$Suffix), for thread safety
 #
 # Return:
 #
 # Remarks :
 #
 #----------------------------------------------------------------------------
-proc UrbanX::BuildingHeights2Raster { {shpfiles ""} } {
+proc UrbanX::BuildingHeights2Raster { {shpfiles ""} { Suffix "" } } {
    variable Param
 
    GenX::Procs
@@ -2223,22 +2639,22 @@ proc UrbanX::BuildingHeights2Raster { {shpfiles ""} } {
       return
    }
 
-   gdalband create RHAUTEURBLD $Param(Width) $Param(Height) 1 Float32
-   gdalband define RHAUTEURBLD -georef $Param(SheetGeoRef)
-   gdalband clear RHAUTEURBLD 0.0
+   gdalband create RHAUTEURBLD$Suffix $Param(Width) $Param(Height) 1 Float32
+   gdalband define RHAUTEURBLD$Suffix -georef $Param(SheetGeoRef)
+   gdalband clear RHAUTEURBLD$Suffix 0.0
 
    foreach shpfile $shpfiles {
-      set shp_layer [lindex [ogrfile open SHAPE read $shpfile] 0]
-      eval ogrlayer read LAYER $shp_layer
+      set shp_layer [lindex [ogrfile open SHAPE$Suffix read $shpfile] 0]
+      eval ogrlayer read LAYER$Suffix $shp_layer
 
 
-      gdalband gridinterp RHAUTEURBLD LAYER $Param(Mode) $Param(BuildingsHgtField)
+      gdalband gridinterp RHAUTEURBLD$Suffix LAYER$Suffix $Param(Mode) $Param(BuildingsHgtField)
 
       Log::Print INFO "All buildings shorter than 4.5m set to an height of 4.5m"
-      vexpr RHAUTEURBLD ifelse(RHAUTEURBLD<4.5 && RHAUTEURBLD>0,4.5,RHAUTEURBLD)
+      vexpr RHAUTEURBLD$Suffix ifelse(RHAUTEURBLD$Suffix<4.5 && RHAUTEURBLD$Suffix>0,4.5,RHAUTEURBLD$Suffix)
 
-      ogrlayer free LAYER
-      ogrfile close SHAPE
+      ogrlayer free LAYER$Suffix
+      ogrfile close SHAPE$Suffix
    }
 
    if { $Param(SAVE_BLDH_RASTER) } {
@@ -2248,11 +2664,11 @@ proc UrbanX::BuildingHeights2Raster { {shpfiles ""} } {
          set bld_height_file "$GenX::Param(TMPDIR)/$Param(NTSSheet)_Building-heights.tif"
       }
       file delete -force $bld_height_file
-      gdalfile open FILEOUT write $bld_height_file GeoTiff
-      gdalband write RHAUTEURBLD FILEOUT
-      gdalfile close FILEOUT
+      gdalfile open FILEOUT$Suffix write $bld_height_file GeoTiff
+      gdalband write RHAUTEURBLD$Suffix FILEOUT$Suffix
+      gdalfile close FILEOUT$Suffix
       Log::Print INFO "The file $bld_height_file has been generated"
-      gdalband free RHAUTEURBLD
+      gdalband free RHAUTEURBLD$Suffix
    } else {
       Log::Print INFO "Will Not Save $Param(NTSSheet)_Building-heights.tif"
    }
@@ -2323,12 +2739,12 @@ proc UrbanX::3DBld2TEBGeoParams { Grid } {
    fstdfield gridinterp $Grid RHAUTEURBLD AVERAGE
    fstdfield copy BLDHEXTENT $Grid ;# BLDHEXTENT is needed below
 
-   fstdfield read BLDHFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDH" ;# BLDH before the addition of 2.5D buildings BLDH
+   GenX::FieldRead BLDHFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDH" ;# BLDH before the addition of 2.5D buildings BLDH
    vexpr $Grid ifelse($Grid==0, BLDHFIELD, $Grid) ;# to overwrite only where there is 2.5D data
    fstdfield free BLDHFIELD ;# invalid field because it has been overwritten
 
    fstdfield define $Grid -NOMVAR BLDH -IP1 0
-   fstdfield write $Grid GPXAUXFILE -32 True $GenX::Param(Compress)
+   GenX::FieldWrite $Grid GPXAUXFILE -32 True $GenX::Param(Compress)
 
    # Update HMIN and HMAX only if the optional TEB parameters are computed
    if { $Param(OptionalTEBParams) } {
@@ -2337,24 +2753,24 @@ proc UrbanX::3DBld2TEBGeoParams { Grid } {
       GenX::GridClear $Grid 0.0
       fstdfield gridinterp $Grid RHAUTEURBLD MINIMUM
 
-      fstdfield read HMINFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "HMIN" ;# HMIN before the addition of 2.5D buildings HMIN
+      GenX::FieldRead HMINFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "HMIN" ;# HMIN before the addition of 2.5D buildings HMIN
       vexpr $Grid ifelse($Grid==0, HMINFIELD, $Grid) ;# to overwrite only where there is 2.5D data
       fstdfield free HMINFIELD ;# invalid field because it has been overwritten
 
       fstdfield define $Grid -NOMVAR HMIN -IP1 0
-      fstdfield write $Grid GPXAUXFILE -32 True $GenX::Param(Compress)
+      GenX::FieldWrite $Grid GPXAUXFILE -32 True $GenX::Param(Compress)
 
       #----- Building height max computation
       Log::Print INFO "Overwriting Building Height Maximum HMAX (IP1=0) where there are 2.5D buildings"
       GenX::GridClear $Grid 0.0
       fstdfield gridinterp $Grid RHAUTEURBLD MAXIMUM
 
-      fstdfield read HMAXFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "HMAX" ;# HMAX before the addition of 2.5D buildings HMAX
+      GenX::FieldRead HMAXFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "HMAX" ;# HMAX before the addition of 2.5D buildings HMAX
       vexpr $Grid ifelse($Grid==0, HMAXFIELD, $Grid) ;# to overwrite only where there is 2.5D data
       fstdfield free HMAXFIELD ;# invalid field because it has been overwritten
 
       fstdfield define $Grid -NOMVAR HMAX -IP1 0
-      fstdfield write $Grid GPXAUXFILE -32 True $GenX::Param(Compress)
+      GenX::FieldWrite $Grid GPXAUXFILE -32 True $GenX::Param(Compress)
    }
 
    #----- Building fraction
@@ -2384,19 +2800,19 @@ proc UrbanX::3DBld2TEBGeoParams { Grid } {
    #         ogrlayer free LAYER
    #         ogrfile close SHAPE
 
-   fstdfield read BLDFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDF"
+   GenX::FieldRead BLDFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDF"
    vexpr $Grid ifelse($Grid==0, BLDFFIELD, $Grid) ;# to overwrite only where there is 2.5D data
    fstdfield free BLDFFIELD ;# invalid field because it has been overwritten
 
    fstdfield define $Grid -NOMVAR BLDF -IP1 0
-   fstdfield write $Grid GPXAUXFILE -32 True $GenX::Param(Compress)
+   GenX::FieldWrite $Grid GPXAUXFILE -32 True $GenX::Param(Compress)
 
    #----- Updating NATF and PAVF
    Log::Print INFO "Updating NATF and PAVF according to new BLDF where there are 2.5D buildings"
 
-   fstdfield read BLDFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDF"
-   fstdfield read NATFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "NATF"
-   fstdfield read PAVFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "PAVF"
+   GenX::FieldRead BLDFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDF"
+   GenX::FieldRead NATFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "NATF"
+   GenX::FieldRead PAVFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "PAVF"
 
    GenX::GridClear $Grid 0.0
    vexpr NEWNATFFIELD NATFFIELD/(NATFFIELD+PAVFFIELD)*(1-BLDFFIELD) ;# BLDFFIELD is the new one
@@ -2404,7 +2820,7 @@ proc UrbanX::3DBld2TEBGeoParams { Grid } {
    fstdfield free NEWNATFFIELD
 
    fstdfield define $Grid -NOMVAR NATF -IP1 0
-   fstdfield write $Grid GPXAUXFILE -32 True $GenX::Param(Compress)
+   GenX::FieldWrite $Grid GPXAUXFILE -32 True $GenX::Param(Compress)
 
    GenX::GridClear $Grid 0.0
    vexpr NEWPAVFFIELD PAVFFIELD/(NATFFIELD+PAVFFIELD)*(1-BLDFFIELD) ;# BLDFFIELD is the new one
@@ -2412,7 +2828,7 @@ proc UrbanX::3DBld2TEBGeoParams { Grid } {
    fstdfield free NEWPAVFFIELD BLDHEXTENT
 
    fstdfield define $Grid -NOMVAR PAVF -IP1 0
-   fstdfield write $Grid GPXAUXFILE -32 True $GenX::Param(Compress)
+   GenX::FieldWrite $Grid GPXAUXFILE -32 True $GenX::Param(Compress)
    fstdfield free NATFFIELD PAVFFIELD BLDFFIELD ;# Freeing because they don't reflect what's in the grid anymore
 
    # Balancing BLDF versus PAVF values and redistribute the other parameters accordingly
@@ -2424,24 +2840,24 @@ proc UrbanX::3DBld2TEBGeoParams { Grid } {
    If { $Param(OptionalTEBParams) } {
       #----- Updating SUMF
       Log::Print INFO "Updating SUMF using the new BLDF, NATF and PAVF values"
-      fstdfield read NATFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "NATF" ;# Reading the updated values
-      fstdfield read PAVFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "PAVF" ;# Reading the updated values
-      fstdfield read BLDFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDF"
+      GenX::FieldRead NATFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "NATF" ;# Reading the updated values
+      GenX::FieldRead PAVFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "PAVF" ;# Reading the updated values
+      GenX::FieldRead BLDFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDF"
 
       GenX::GridClear $Grid 0.0
       vexpr $Grid BLDFFIELD+NATFFIELD+PAVFFIELD
       fstdfield define $Grid -NOMVAR SUMF -IP1 0
-      fstdfield write $Grid GPXAUXFILE -32 True $GenX::Param(Compress)
+      GenX::FieldWrite $Grid GPXAUXFILE -32 True $GenX::Param(Compress)
       fstdfield free PAVFFIELD NATFFIELD
    }
 
    #----- WALL_O_HOR
    Log::Print INFO "Overwriting WALL_O_HOR (WHOR) where there are 2.5D buildings"
 
-   fstdfield read BLDHFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDH"
-   fstdfield read NATFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "NATF" ;# Reading the updated values
-   fstdfield read PAVFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "PAVF" ;# Reading the updated values
-   fstdfield read BLDFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDF"
+   GenX::FieldRead BLDHFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDH"
+   GenX::FieldRead NATFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "NATF" ;# Reading the updated values
+   GenX::FieldRead PAVFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "PAVF" ;# Reading the updated values
+   GenX::FieldRead BLDFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDF"
    GenX::GridClear $Grid 0.0
 
    #----- WALL-O-HOR formulae provided by Sylvie Leroyer
@@ -2454,16 +2870,16 @@ proc UrbanX::3DBld2TEBGeoParams { Grid } {
    vexpr SURFTILE (ddx($Grid)*ddy($Grid))  ;# tile surface of the target grid in meters^2
    vexpr $Grid ifelse(NATFFIELD==1,0,BLDHFIELD*(2.0/(SURFTILE*(1.0-NATFFIELD)))*(sqrt(BLDFFIELD*SURFTILE))) ;#ifelse required to avoid division by 0
 
-   fstdfield read WHORFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "WHOR"
+   GenX::FieldRead WHORFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "WHOR"
    vexpr $Grid ifelse($Grid==0, WHORFIELD, $Grid) ;# to overwrite only where there is 2.5D data
    fstdfield free WHORFIELD ;# invalid field because it has been overwritten
 
    fstdfield define $Grid -NOMVAR WHOR -IP1 0
-   fstdfield write $Grid GPXAUXFILE -32 True $GenX::Param(Compress)
+   GenX::FieldWrite $Grid GPXAUXFILE -32 True $GenX::Param(Compress)
 
    #----- Z0_TOWN
    Log::Print INFO "Overwriting Z0_TOWN (Z0TW) where there are 2.5D buildings with the MacDonald 1998 Model"
-   fstdfield read WHORFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "WHOR"
+   GenX::FieldRead WHORFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "WHOR"
 
    #----- Note: the ^ operator can be used in vexpr, but not in expr
    vexpr RDISPH BLDHFIELD*(1+(4.43^(BLDFFIELD*(-1.0))*(BLDFFIELD - 1.0)))
@@ -2473,9 +2889,9 @@ proc UrbanX::3DBld2TEBGeoParams { Grid } {
    #vexpr RDISPLACEMENTHEIGHT RBLDHAVG*(1+(exp(-1.0*(7.5*2.0*RWALLOHOR/2.0)^0.5-1.0)/(7.5*2.0*RWALLOHOR/2.0)^0.5))
    #vexpr RZ0TOWN RBLDHAVG*((1.0-RDISPLACEMENTHEIGHT/RBLDHAVG)*exp((-1.0)*0.4/min((0.003+0.3*RWALLOHOR/2.0)^0.5,0.3)+0.193))
 
-   fstdfield read Z0TWFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "Z0TW"
-   fstdfield read Z0RDFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "Z0RD"
-   fstdfield read Z0RFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "Z0RF"
+   GenX::FieldRead Z0TWFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "Z0TW"
+   GenX::FieldRead Z0RDFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "Z0RD"
+   GenX::FieldRead Z0RFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "Z0RF"
 
    vexpr $Grid ifelse($Grid==0, Z0TWFIELD, $Grid) ;# to overwrite only where there is 2.5D data
    vexpr $Grid ifelse(BLDFFIELD>0.9,max(Z0RFFIELD,$Grid),$Grid)
@@ -2483,7 +2899,7 @@ proc UrbanX::3DBld2TEBGeoParams { Grid } {
    fstdfield free Z0TWFIELD ;# invalid field because it has been overwritten
 
    fstdfield define $Grid -NOMVAR Z0TW -IP1 0
-   fstdfield write $Grid GPXAUXFILE -32 True $GenX::Param(Compress)
+   GenX::FieldWrite $Grid GPXAUXFILE -32 True $GenX::Param(Compress)
 
    fstdfield free BLDHFIELD BLDFFIELD NATFFIELD PAVFFIELD WHORFIELD RDISPH SURFTILE
 }
@@ -2623,8 +3039,8 @@ proc UrbanX::Balance_BLDFvsPAVF { } {
    set GridBLDF WKBLDFFIELD
    set GridPAVF WKPAVFFIELD
 
-   fstdfield read BLDFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDF"
-   fstdfield read PAVFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "PAVF"
+   GenX::FieldRead BLDFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDF"
+   GenX::FieldRead PAVFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "PAVF"
 
    fstdfield copy $GridBLDF BLDFFIELD
    fstdfield copy $GridPAVF PAVFFIELD
@@ -2716,14 +3132,14 @@ proc UrbanX::Balance_BLDFvsPAVF { } {
    set  auxfile  GPXAUXFILE
 
    fstdfield define $GridPAVF -NOMVAR PAVF -IP1 0
-   fstdfield write $GridPAVF $auxfile -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite $GridPAVF $auxfile -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    fstdfield define $GridBLDF -NOMVAR BLDF -IP1 0
-   fstdfield write $GridBLDF $auxfile -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite $GridBLDF $auxfile -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    vexpr NATFFIELD  "1 - ($GridPAVF+$GridBLDF)"
    fstdfield define NATFFIELD -NOMVAR NATF -IP1 0
-   fstdfield write NATFFIELD $auxfile -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite NATFFIELD $auxfile -$GenX::Param(NBits) True $GenX::Param(Compress)
    Log::Print INFO "Rewrote NATF as 1-(BLDF+PAVF)"
 
    UrbanX::Save_LoadedPavBldParams $auxfile
@@ -2760,9 +3176,9 @@ proc UrbanX::Preload_PavBldParams { } {
          set ip1 [expr 1200-$ip1]
       }
       if { $nomvar == "VF" } {
-         fstdfield read $PLVAR GPXOUTFILE -1 "" $ip1 -1 -1 "" "$nomvar"
+         GenX::FieldRead $PLVAR GPXOUTFILE -1 "" $ip1 -1 -1 "" "$nomvar"
       } else {
-         fstdfield read $PLVAR GPXAUXFILE -1 "" $ip1 -1 -1 "" "$nomvar"
+         GenX::FieldRead $PLVAR GPXAUXFILE -1 "" $ip1 -1 -1 "" "$nomvar"
       }
    }
 }
@@ -2789,7 +3205,7 @@ proc UrbanX::Save_LoadedPavBldParams { auxfile } {
       set nomvar [lindex $p 0]
       set ip1 [lindex $p 1]
       set PLVAR  "PB_$nomvar$ip1"
-      fstdfield write $PLVAR $auxfile -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite $PLVAR $auxfile -$GenX::Param(NBits) True $GenX::Param(Compress)
    }
 }
 
@@ -3020,9 +3436,9 @@ proc UrbanX::NormalizeVFvsPAVFBLDF { } {
 
    set  VegeTypes {1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 22 23 24 25 26}
 
-   fstdfield read NATFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "NATF"
-   fstdfield read BLDFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDF"
-   fstdfield read PAVFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "PAVF"
+   GenX::FieldRead NATFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "NATF"
+   GenX::FieldRead BLDFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDF"
+   GenX::FieldRead PAVFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "PAVF"
 
    fstdfield copy SumVF NATFFIELD
    GenX::GridClear SumVF 0.0
@@ -3030,7 +3446,7 @@ proc UrbanX::NormalizeVFvsPAVFBLDF { } {
 # VF21 must be 0.0 already here
 #
    foreach type $GeoPhysX::Param(VegeTypes) {
-      fstdfield read GPXVF GPXOUTFILE -1 "" [expr 1200-$type] -1 -1 "" "VF"
+      GenX::FieldRead GPXVF GPXOUTFILE -1 "" [expr 1200-$type] -1 -1 "" "VF"
       vexpr SumVF  "SumVF + GPXVF"
    }
 
@@ -3039,11 +3455,11 @@ proc UrbanX::NormalizeVFvsPAVFBLDF { } {
    GenX::GridClear SumVF 0.0
 
    foreach type $VegeTypes {
-      fstdfield read GPXVF GPXOUTFILE -1 "" [expr 1200-$type] -1 -1 "" "VF"
+      GenX::FieldRead GPXVF GPXOUTFILE -1 "" [expr 1200-$type] -1 -1 "" "VF"
       vexpr GPXVF  "GPXVF * SFIELD"
       vexpr SumVF  "SumVF + GPXVF"
       fstdfield define GPXVF -NOMVAR VF -IP1 [expr 1200-$type]
-      fstdfield write GPXVF GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+      GenX::FieldWrite GPXVF GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    }
 
    vexpr GPXVF  "SumVF - NATFFIELD"
@@ -3056,7 +3472,7 @@ proc UrbanX::NormalizeVFvsPAVFBLDF { } {
    set max  [lindex [fstdfield stats SumVF -max] 0]
    Log::Print INFO "Checking Sum(VF1..26) + BLDF + PAVF: min=$min max=$max"
    fstdfield define SumVF -NOMVAR SUMV -IP1 0
-   fstdfield write SumVF GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite SumVF GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    fstdfield free PAVFFIELD BLDFFIELD NATFFIELD GPXVF SumVF
 }
@@ -3078,12 +3494,12 @@ proc UrbanX::NormalizeVFvsPAVFBLDF { } {
 proc UrbanX::DominantVege { Grid } {
 
    # generate VF21 temporary for computation of VG
-   fstdfield read BLDFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDF"
-   fstdfield read PAVFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "PAVF"
+   GenX::FieldRead BLDFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "BLDF"
+   GenX::FieldRead PAVFFIELD GPXAUXFILE -1 "" 0 -1 -1 "" "PAVF"
 
    vexpr VF21 "BLDFFIELD + PAVFFIELD"
    fstdfield define VF21 -NOMVAR VF -IP1 [expr 1200-21]
-   fstdfield write VF21 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite VF21 GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
    fstdfield free VF21
 
    GeoPhysX::DominantVege $Grid ;# Adding DominantVG "VG IP1=0"
@@ -3092,7 +3508,7 @@ proc UrbanX::DominantVege { Grid } {
    fstdfield copy VF21FIELD $Grid
    GenX::GridClear VF21FIELD 0.0
    fstdfield define VF21FIELD -NOMVAR VF -IP1 [expr 1200-21]
-   fstdfield write VF21FIELD GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
+   GenX::FieldWrite VF21FIELD GPXOUTFILE -$GenX::Param(NBits) True $GenX::Param(Compress)
 
    fstdfield free VF21FIELD BLDFFIELD PAVFFIELD
 }
@@ -18,3 +18,9 @@ export CI_DATA_OUT=${CI_DATA}/GenPhysX/out/${CI_BUILD_REF}
 mkdir -p $CI_DATA_OUT
 ${CI_PROJECT_DIR}/bin/GenPhysX -target GDPS_5.1 -gridfile ${CI_DATA_IN}/GDPS_5.1.fst -result ${CI_DATA_OUT}/GDPS_5.1 > ${CI_PROJECT_DIR}/CI.log
 echo "Status: $?" >> ${CI_PROJECT_DIR}/CI.log
+
+#----- Launch the core library and stage cache tests (standalone build, no libSPI needed)
+cmake -S ${CI_PROJECT_DIR}/test -B ${CI_DATA_OUT}/test >> ${CI_PROJECT_DIR}/CI.log 2>&1 && \
+cmake --build ${CI_DATA_OUT}/test >> ${CI_PROJECT_DIR}/CI.log 2>&1 && \
+ctest --test-dir ${CI_DATA_OUT}/test --output-on-failure >> ${CI_PROJECT_DIR}/CI.log 2>&1
+echo "Core status: $?" >> ${CI_PROJECT_DIR}/CI.log
@@ -0,0 +1,486 @@
+/*=========================================================
+ * Environnement Canada
+ * Centre Meteorologique Canadien
+ * 2100 Trans-Canadienne
+ * Dorval, Quebec
+ *
+ * Projet       : Lecture et traitements de divers fichiers de donnees
+ * Fichier      : GeoPhyCoreTest.c
+ * Creation     : Octobre 2026 - CMC/CMDS
+ *
+ * Description  : Verifications des noyaux de GeoPhyCore sur des champs synthetiques.
+ *
+ * Remarques    :
+ *   - Retourne le nombre de verifications en echec
+ *
+ * License      :
+ *    This library is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation,
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with this library; if not, write to the
+ *    Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ *    Boston, MA 02111-1307, USA.
+ *
+ *=========================================================
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "GeoPhyCore.h"
+
+#define TEST_NI     12
+#define TEST_NJ     10
+#define TEST_SUB    8
+#define TEST_NODATA -99999.0
+
+#define TEST_NIJ    (TEST_NI*TEST_NJ)
+#define TEST_NSUB   (TEST_NIJ*TEST_SUB*TEST_SUB)
+
+static int TestFail=0;
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Test_Check>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Afficher le resultat d'une verification
+ *
+ * Parametres :
+ *  <Name>    : Nom de la verification.
+ *  <Ok>      : Resultat.
+ *  <Diff>    : Ecart maximal obtenu.
+ *  <Bound>   : Ecart maximal accepte.
+ *
+ * Retour:
+ *
+ * Remarques :
+ *----------------------------------------------------------------------------
+*/
+static void Test_Check(const char *Name,int Ok,double Diff,double Bound) {
+
+   printf("%-4s %-48s max diff %.6g (bound %.6g)\n",Ok?"OK":"FAIL",Name,Diff,Bound);
+   if (!Ok) TestFail++;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Test_Diff>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Calculer l'ecart maximal entre deux champs
+ *
+ * Parametres :
+ *  <A>       : Premier champ.
+ *  <B>       : Second champ.
+ *  <N>       : Nombre de valeurs.
+ *  <Rel>     : Ecart relatif a la valeur de B
+ *
+ * Retour:
+ *  <Diff>    : Ecart maximal
+ *
+ * Remarques :
+ *----------------------------------------------------------------------------
+*/
+static double Test_Diff(const float *A,const float *B,int N,int Rel) {
+
+   double d,diff=0.0;
+   int    n;
+
+   for(n=0;n<N;n++) {
+      d=fabs((double)A[n]-B[n]);
+      if (Rel) d/=fmax(fabs(B[n]),1e-6);
+      diff=fmax(diff,d);
+   }
+   return(diff);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Test_SubGridInit>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Generer une topographie synthetique et ses echantillons sous-maille
+ *
+ * Parametres :
+ *  <Topo>    : Topographie (TEST_NIJ).
+ *  <Sub>     : Echantillons sous-maille (TEST_NSUB).
+ *  <Vege>    : Types de vegetation (TEST_NIJ).
+ *  <Seed>    : Germe des deviations.
+ *
+ * Retour:
+ *
+ * Remarques :
+ *   - Un bloc de points garde une topographie constante sans deviation pour
+ *     passer par les points plats
+ *   - Quelques echantillons sont manquants
+ *----------------------------------------------------------------------------
+*/
+static void Test_SubGridInit(float *Topo,float *Sub,float *Vege,unsigned int Seed) {
+
+   int i,j,n,s,flat;
+
+   s=TEST_SUB*TEST_SUB;
+
+   for(j=0;j<TEST_NJ;j++) {
+      for(i=0;i<TEST_NI;i++) {
+         flat=(i>=2 && i<=5 && j>=2 && j<=5);
+         Topo[j*TEST_NI+i]=flat?250.0f:500.0f+300.0f*sinf(i*0.7f)*cosf(j*0.5f);
+         Vege[j*TEST_NI+i]=1+(i+j)%SUB_NVEGE;
+
+         for(n=0;n<s;n++) {
+            Seed=Seed*1103515245+12345;
+            if (flat) {
+               Sub[(j*TEST_NI+i)*s+n]=250.0f;
+            } else if (!(Seed%37)) {
+               Sub[(j*TEST_NI+i)*s+n]=TEST_NODATA;
+            } else {
+               Sub[(j*TEST_NI+i)*s+n]=Topo[j*TEST_NI+i]+((Seed>>8)%10000)*0.01f-50.0f;
+            }
+         }
+      }
+   }
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Test_SubGridSet>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Initialiser un ensemble de champs sous-maille
+ *
+ * Parametres :
+ *  <Grid>    : Ensemble a initialiser.
+ *  <Topo>    : Topographie.
+ *  <Sub>     : Echantillons sous-maille (NULL pour utiliser Packed).
+ *  <Packed>  : Echantillons sous-maille compacts.
+ *  <Vege>    : Types de vegetation.
+ *  <Out>     : Champs resultants (6*TEST_NIJ).
+ *
+ * Retour:
+ *
+ * Remarques :
+ *----------------------------------------------------------------------------
+*/
+static void Test_SubGridSet(TGeoPhySubGrid *Grid,float *Topo,float *Sub,TGeoPhySub *Packed,float *Vege,float *Out) {
+
+   Grid->Topo=Topo;
+   Grid->Sub=Sub;
+   Grid->Packed=Packed;
+   Grid->SubSample=TEST_SUB;
+   Grid->NoData=TEST_NODATA;
+   Grid->Vege=Vege;
+   Grid->ZZ=&Out[0*TEST_NIJ];
+   Grid->LH=&Out[1*TEST_NIJ];
+   Grid->DH=&Out[2*TEST_NIJ];
+   Grid->HX2=&Out[3*TEST_NIJ];
+   Grid->HY2=&Out[4*TEST_NIJ];
+   Grid->HXY=&Out[5*TEST_NIJ];
+   Grid->Value=NULL;
+   Grid->Data=NULL;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Test_SubCompact>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Comparer les resultats de subgrid_legacy avec les echantillons
+ *            compacts et float
+ *
+ * Parametres :
+ *  <Set>     : Settings.
+ *  <DX>      : Resolution en X.
+ *  <DY>      : Resolution en Y.
+ *
+ * Retour:
+ *
+ * Remarques :
+ *   - L'erreur de quantification borne DH (erreur) et LH (2 fois l'erreur),
+ *     Z0 et les pentes ne sont que rapportes avec une borne empirique
+ *----------------------------------------------------------------------------
+*/
+static void Test_SubCompact(const TGeoPhySet *Set,const float *DX,const float *DY) {
+
+   TGeoPhySubGrid grid;
+   TGeoPhySub    *packed;
+   float         *topo,*sub,*vege,*flt,*cpt,err;
+   double         diff;
+
+   topo=(float*)malloc(TEST_NIJ*sizeof(float));
+   vege=(float*)malloc(TEST_NIJ*sizeof(float));
+   sub=(float*)malloc(TEST_NSUB*sizeof(float));
+   flt=(float*)malloc(6*TEST_NIJ*sizeof(float));
+   cpt=(float*)malloc(6*TEST_NIJ*sizeof(float));
+
+   Test_SubGridInit(topo,sub,vege,1);
+
+   // The tolerance is checked by the packer itself
+   packed=GeoPhyCore_SubPack(sub,TEST_NI,TEST_NJ,TEST_SUB,TEST_NODATA,1e-6,&err);
+   Test_Check("SubPack rejects a tolerance below its error",packed==NULL,err,1e-6);
+   GeoPhyCore_SubFree(packed);
+
+   if (!(packed=GeoPhyCore_SubPack(sub,TEST_NI,TEST_NJ,TEST_SUB,TEST_NODATA,1.0,&err))) {
+      Test_Check("SubPack within tolerance",0,err,1.0);
+   } else {
+      Test_SubGridSet(&grid,topo,sub,NULL,vege,flt);
+      GeoPhyCore_SubGrid(Set,&grid,1,TEST_NI,TEST_NJ,DX,DY);
+      Test_SubGridSet(&grid,topo,NULL,packed,vege,cpt);
+      GeoPhyCore_SubGrid(Set,&grid,1,TEST_NI,TEST_NJ,DX,DY);
+
+      // Single precision accumulation adds a little on top of the quantization error
+      diff=Test_Diff(&cpt[2*TEST_NIJ],&flt[2*TEST_NIJ],TEST_NIJ,0);
+      Test_Check("Compact vs float DH",diff<=err+1e-3,diff,err+1e-3);
+      diff=Test_Diff(&cpt[1*TEST_NIJ],&flt[1*TEST_NIJ],TEST_NIJ,0);
+      Test_Check("Compact vs float LH",diff<=2.0*err+1e-3,diff,2.0*err+1e-3);
+      diff=Test_Diff(&cpt[0*TEST_NIJ],&flt[0*TEST_NIJ],TEST_NIJ,1);
+      Test_Check("Compact vs float Z0 (relative)",diff<=1e-3,diff,1e-3);
+      diff=Test_Diff(&cpt[3*TEST_NIJ],&flt[3*TEST_NIJ],3*TEST_NIJ,1);
+      Test_Check("Compact vs float slopes (relative)",diff<=1e-2,diff,1e-2);
+   }
+
+   GeoPhyCore_SubFree(packed);
+   free(topo);
+   free(vege);
+   free(sub);
+   free(flt);
+   free(cpt);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Test_SubBatch>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Comparer les resultats de subgrid_legacy en lot et par ensemble,
+ *            et ceux des points plats avec le calcul complet
+ *
+ * Parametres :
+ *  <Set>     : Settings.
+ *  <DX>      : Resolution en X.
+ *  <DY>      : Resolution en Y.
+ *
+ * Retour:
+ *
+ * Remarques :
+ *   - Le lot melange un ensemble float et un ensemble compact, les resultats
+ *     doivent etre identiques a ceux des appels separes
+ *   - Sur une topographie plate, les points de bordure passent toujours par le
+ *     calcul complet et servent de reference aux points plats de leur rangee
+ *----------------------------------------------------------------------------
+*/
+static void Test_SubBatch(const TGeoPhySet *Set,const float *DX,const float *DY) {
+
+   TGeoPhySubGrid grid[2];
+   TGeoPhySub    *packed;
+   float         *topo[2],*sub[2],*vege,*one,*all,err;
+   double         diff;
+   int            g,f,i,j,n,s;
+
+   vege=(float*)malloc(TEST_NIJ*sizeof(float));
+   one=(float*)malloc(12*TEST_NIJ*sizeof(float));
+   all=(float*)malloc(12*TEST_NIJ*sizeof(float));
+   for(g=0;g<2;g++) {
+      topo[g]=(float*)malloc(TEST_NIJ*sizeof(float));
+      sub[g]=(float*)malloc(TEST_NSUB*sizeof(float));
+      Test_SubGridInit(topo[g],sub[g],vege,g+1);
+   }
+   packed=GeoPhyCore_SubPack(sub[1],TEST_NI,TEST_NJ,TEST_SUB,TEST_NODATA,1.0,&err);
+
+   // Each set alone, then both in one call
+   Test_SubGridSet(&grid[0],topo[0],sub[0],NULL,vege,&one[0]);
+   GeoPhyCore_SubGrid(Set,&grid[0],1,TEST_NI,TEST_NJ,DX,DY);
+   Test_SubGridSet(&grid[1],topo[1],NULL,packed,vege,&one[6*TEST_NIJ]);
+   GeoPhyCore_SubGrid(Set,&grid[1],1,TEST_NI,TEST_NJ,DX,DY);
+
+   Test_SubGridSet(&grid[0],topo[0],sub[0],NULL,vege,&all[0]);
+   Test_SubGridSet(&grid[1],topo[1],NULL,packed,vege,&all[6*TEST_NIJ]);
+   n=GeoPhyCore_SubGrid(Set,grid,2,TEST_NI,TEST_NJ,DX,DY);
+
+   diff=Test_Diff(all,one,12*TEST_NIJ,0);
+   Test_Check("SubGrid batch vs per set",n && diff==0.0,diff,0.0);
+
+   // Flat topography, the vegetation type only changes along J
+   s=TEST_SUB*TEST_SUB;
+   for(j=0;j<TEST_NJ;j++) {
+      for(i=0;i<TEST_NI;i++) {
+         topo[0][j*TEST_NI+i]=250.0f;
+         vege[j*TEST_NI+i]=1+j%SUB_NVEGE;
+      }
+   }
+   for(n=0;n<TEST_NSUB;n++) {
+      sub[0][n]=(n%s==7)?TEST_NODATA:250.0f;
+   }
+   GeoPhyCore_SubFree(packed);
+   packed=GeoPhyCore_SubPack(sub[0],TEST_NI,TEST_NJ,TEST_SUB,TEST_NODATA,1.0,&err);
+
+   for(g=0;g<2;g++) {
+      Test_SubGridSet(&grid[0],topo[0],g?NULL:sub[0],packed,vege,one);
+      GeoPhyCore_SubGrid(Set,&grid[0],1,TEST_NI,TEST_NJ,DX,DY);
+      for(diff=0.0,f=0;f<6;f++) {
+         for(j=0;j<TEST_NJ;j++) {
+            for(i=1;i<TEST_NI;i++) {
+               diff=fmax(diff,fabs(one[f*TEST_NIJ+j*TEST_NI+i]-one[f*TEST_NIJ+j*TEST_NI]));
+            }
+         }
+      }
+      Test_Check(g?"SubGrid flat vs full cells (compact)":"SubGrid flat vs full cells (float)",diff<=1e-6,diff,1e-6);
+   }
+
+   GeoPhyCore_SubFree(packed);
+   for(g=0;g<2;g++) {
+      free(topo[g]);
+      free(sub[g]);
+   }
+   free(vege);
+   free(one);
+   free(all);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Test_SubRoundTrip>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Verifier le decodage des echantillons compacts
+ *
+ * Parametres :
+ *
+ * Retour:
+ *
+ * Remarques :
+ *   - Les echantillons valides sont a l'erreur rapportee pres, les manquants
+ *     restent manquants
+ *----------------------------------------------------------------------------
+*/
+static void Test_SubRoundTrip(void) {
+
+   TGeoPhySub *packed;
+   float      *topo,*sub,*vege,tile[TEST_SUB*TEST_SUB],err;
+   double      diff=0.0;
+   int         idx,n,s,miss=0;
+
+   topo=(float*)malloc(TEST_NIJ*sizeof(float));
+   vege=(float*)malloc(TEST_NIJ*sizeof(float));
+   sub=(float*)malloc(TEST_NSUB*sizeof(float));
+   Test_SubGridInit(topo,sub,vege,3);
+
+   s=TEST_SUB*TEST_SUB;
+   if (!(packed=GeoPhyCore_SubPack(sub,TEST_NI,TEST_NJ,TEST_SUB,TEST_NODATA,1.0,&err))) {
+      Test_Check("SubPack within tolerance",0,err,1.0);
+   } else {
+      for(idx=0;idx<TEST_NIJ;idx++) {
+         GeoPhyCore_SubUnpack(packed,idx,tile,TEST_NODATA);
+         for(n=0;n<s;n++) {
+            if ((sub[idx*s+n]==TEST_NODATA)!=(tile[n]==TEST_NODATA)) {
+               miss++;
+            } else if (tile[n]!=TEST_NODATA) {
+               diff=fmax(diff,fabs((double)tile[n]-sub[idx*s+n]));
+            }
+         }
+      }
+      Test_Check("SubPack/SubUnpack nodata samples",!miss,miss,0);
+      Test_Check("SubPack/SubUnpack valid samples",diff<=err+1e-4,diff,err+1e-4);
+   }
+
+   GeoPhyCore_SubFree(packed);
+   free(topo);
+   free(vege);
+   free(sub);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Test_Filter>
+ * Creation : Octobre 2026 - CMC/CMDS
+ *
+ * But      : Comparer les filtres appliques en lot et par champ
+ *
+ * Parametres :
+ *  <Set>     : Settings.
+ *
+ * Retour:
+ *
+ * Remarques :
+ *----------------------------------------------------------------------------
+*/
+static void Test_Filter(const TGeoPhySet *Set) {
+
+   TGeoPhySet set=*Set;
+   float     *one,*all,*mask,*fld[2],*vege,*sub,ax[TEST_NI],ay[TEST_NJ];
+   double     diff;
+   int        f,i,j,n,m;
+
+   one=(float*)malloc(2*TEST_NIJ*sizeof(float));
+   all=(float*)malloc(2*TEST_NIJ*sizeof(float));
+   mask=(float*)malloc(TEST_NIJ*sizeof(float));
+   vege=(float*)malloc(TEST_NIJ*sizeof(float));
+   sub=(float*)malloc(TEST_NSUB*sizeof(float));
+
+   for(i=0;i<TEST_NI;i++) ax[i]=i*360.0f/(TEST_NI-1);
+   for(j=0;j<TEST_NJ;j++) ay[j]=-90.0f+(j+0.5f)*180.0f/TEST_NJ;
+
+   // Without and with a mask for the low pass filter, then the GEM digital filter
+   for(m=0;m<3;m++) {
+      for(f=0;f<2;f++) {
+         Test_SubGridInit(&one[f*TEST_NIJ],sub,vege,f+1);
+         for(j=0;j<TEST_NJ;j++) {
+            for(i=0;i<TEST_NI;i++) {
+               one[f*TEST_NIJ+j*TEST_NI+i]+=(f+1)*100.0f*((i*7+j*3)%5);
+            }
+         }
+      }
+      for(n=0;n<TEST_NIJ;n++) {
+         all[n]=one[n];
+         all[TEST_NIJ+n]=one[TEST_NIJ+n];
+         mask[n]=(n%3)?1.0f:0.0f;
+      }
+
+      for(f=0;f<2;f++) {
+         fld[0]=&one[f*TEST_NIJ];
+         if (m<2) {
+            GeoPhyCore_LPassFilter(&set,fld,1,m?mask:NULL,TEST_NI,TEST_NJ);
+         } else {
+            set.DgfmX=1;
+            GeoPhyCore_ZFilter(&set,fld,1,TEST_NI,TEST_NJ,ax,ay);
+         }
+      }
+      fld[0]=&all[0];
+      fld[1]=&all[TEST_NIJ];
+      if (m<2) {
+         GeoPhyCore_LPassFilter(&set,fld,2,m?mask:NULL,TEST_NI,TEST_NJ);
+      } else {
+         GeoPhyCore_ZFilter(&set,fld,2,TEST_NI,TEST_NJ,ax,ay);
+      }
+
+      diff=Test_Diff(all,one,2*TEST_NIJ,0);
+      Test_Check(m==0?"LPassFilter batch vs per field":m==1?"LPassFilter masked batch vs per field":"ZFilter batch vs per field",diff==0.0,diff,0.0);
+   }
+
+   free(one);
+   free(all);
+   free(mask);
+   free(vege);
+   free(sub);
+}
+
+int main(int argc,char **argv) {
+
+   TGeoPhySet set;
+   float      dx[TEST_NIJ],dy[TEST_NIJ];
+   int        n;
+
+   GeoPhyCore_SetDefault(&set);
+   for(n=0;n<TEST_NIJ;n++) {
+      dx[n]=10000.0f;
+      dy[n]=8000.0f;
+   }
+
+   Test_SubCompact(&set,dx,dy);
+   Test_SubBatch(&set,dx,dy);
+   Test_SubRoundTrip();
+   Test_Filter(&set);
+
+   printf("%d check(s) failed\n",TestFail);
+   return(TestFail);
+}
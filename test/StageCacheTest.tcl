@@ -0,0 +1,128 @@
+#!/bin/sh
+# the next line restarts using tclsh \
+exec tclsh "$0" "$@"
+#============================================================================
+# Environnement Canada
+# Centre Meteorologique Canadien
+# 2121 Trans-Canadienne
+# Dorval, Quebec
+#
+# Project    : Generateur de champs geophysiques.
+# File       : StageCacheTest.tcl
+# Creation   : Octobre 2026 - CMC/CMDS
+# Description: Check the reruns of the processing stage cache (GenX::Stage)
+#
+# Parameters   :
+#   <GenX.tcl> : Path of GenX.tcl (Default ../tcl/GenX.tcl)
+#
+# Remarks  :
+#   - Topo, CheckLegacy and LegacySub are run with the stage declarations of
+#     GenX.tcl, their scripts only manage a stand-in for the in-memory GPXME
+#   - A TOPO_* setting change must rerun LegacySub with GPXME rebuilt by the
+#     Topo and CheckLegacy stages, themselves reused from the cache
+#   - The SPI packages are stubbed when they are not available, the stages
+#     write no fields
+#   - Exits with the number of failed checks
+#============================================================================
+
+#----- Stand-ins for the SPI packages when running outside of the SPI environment
+foreach pkg { TclData TclGeoPhy TclSystem MetData Logger Thread } {
+   if { [catch { package require $pkg }] } {
+      package provide $pkg 0.0
+   }
+}
+if { [info commands Log::Print]=="" } {
+   namespace eval Log { variable Param }
+   proc Log::Print { Type Msg } { puts "$Type $Msg" }
+}
+foreach cmd { gdalfile fstdfile fstdfield } {
+   if { [info commands $cmd]=="" } {
+      proc $cmd { args } { }
+   }
+}
+
+set genx [lindex $argv 0]
+if { $genx=="" } {
+   set genx [file join [file dirname [info script]] .. tcl GenX.tcl]
+}
+source $genx
+
+#----- The tcllib SHA-256 is only needed for the cache file names
+if { [catch { package require sha256 }] } {
+   proc GenX::Hash { String } {
+      return [format %08x [zlib crc32 [encoding convertto utf-8 $String]]]
+   }
+}
+
+set Fail 0
+
+proc Check { Name Ok } {
+   global Fail
+
+   puts "[expr $Ok?{OK  }:{FAIL}] $Name"
+   if { !$Ok } {
+      incr Fail
+   }
+}
+
+#----- Stage scripts, GPXME stands for the topography left in memory by Topo
+proc TestTopo { } {
+   incr ::Runs(Topo)
+   set ::GPXME { topo }
+}
+
+proc TestCheckLegacy { } {
+   incr ::Runs(CheckLegacy)
+   lappend ::GPXME checked
+}
+
+proc TestLegacySub { } {
+   incr ::Runs(LegacySub)
+   if { ![info exists ::GPXME] || [lsearch -exact $::GPXME checked]==-1 } {
+      error "GPXME not available"
+   }
+}
+
+#----- One processing run, as a new GenPhysX process would do it
+proc TestProcess { } {
+
+   unset -nocomplain ::GPXME
+   array set ::Runs { Topo 0 CheckLegacy 0 LegacySub 0 }
+   array unset GenX::Stages *,Hash
+   array unset GenX::Stages *,Run
+   set GenX::Stages(Order) {}
+
+   GenX::Stage Topo        { TestTopo }
+   GenX::Stage CheckLegacy { TestCheckLegacy }
+   GenX::Stage LegacySub   { TestLegacySub }
+}
+
+#----- The databases are stamped in the hash, keep them away from the cache
+set GenX::Param(StageCache) [file join [pwd] StageCacheTest.cache]
+set GenX::Param(DBase)      [file join [pwd] StageCacheTest.db]
+set GenX::Stages(Grid)      test
+set GenX::Settings(TOPO_VEGE_RUGV) { 0.001 0.001 0.001 1.5 3.5 1.0 2.0 3.0 0.8 0.05 0.15 0.15 0.02 0.08 0.08 0.08 0.35 0.25 0.1 0.08 1.35 0.01 0.05 0.05 1.5 0.05 }
+file delete -force $GenX::Param(StageCache) $GenX::Param(DBase)
+file mkdir $GenX::Param(DBase)
+
+TestProcess
+Check "First run runs every stage" [expr $Runs(Topo)==1 && $Runs(CheckLegacy)==1 && $Runs(LegacySub)==1]
+
+TestProcess
+Check "Identical rerun reuses every stage" [expr $Runs(Topo)==0 && $Runs(CheckLegacy)==0 && $Runs(LegacySub)==0]
+
+lset GenX::Settings(TOPO_VEGE_RUGV) 4 3.0
+if { [catch { TestProcess } msg] } {
+   Check "TOPO_VEGE_RUGV change reruns LegacySub ($msg)" False
+} else {
+   Check "TOPO_VEGE_RUGV change reruns LegacySub" [expr $Runs(LegacySub)==1]
+   Check "TOPO_VEGE_RUGV change rebuilds GPXME from Topo and CheckLegacy" [expr $Runs(Topo)==1 && $Runs(CheckLegacy)==1]
+}
+
+TestProcess
+Check "Rerun after the change reuses every stage" [expr $Runs(Topo)==0 && $Runs(CheckLegacy)==0 && $Runs(LegacySub)==0]
+
+file delete -force $GenX::Param(StageCache) $GenX::Param(DBase)
+
+puts "$Fail check(s) failed"
+exit $Fail